@@ -8,6 +8,11 @@ import "../config"
  * 
  * Renders the wallpaper as a background layer surface, no external tools needed.
  * Supports fade transitions between wallpapers.
+ *
+ * With Molten.Native installed, wallpapers load through its WallpaperCache:
+ * decoded once at this screen's pixel size and mapped from disk afterwards, so
+ * switching back to a wallpaper does not decode it again. blurredSource is the
+ * same wallpaper pre-blurred, for static glass backdrops.
  */
 PanelWindow {
     id: wallpaper
@@ -34,18 +39,33 @@ PanelWindow {
     // Animation duration
     property int transitionDuration: 500
 
+    // Molten.Native WallpaperCache; plain file loads without it
+    property var nativeCache: null
+
+    // Output size in physical pixels, what the cache scales to
+    readonly property int pixelWidth: Math.round(screen.width * screen.devicePixelRatio)
+    readonly property int pixelHeight: Math.round(screen.height * screen.devicePixelRatio)
+
+    readonly property string blurredSource: nativeCache && wallpaperPath ? nativeCache.blurredSource(wallpaperPath, pixelWidth, pixelHeight) : ""
+
+    function imageSource(path) {
+        if (nativeCache)
+            return nativeCache.source(path, pixelWidth, pixelHeight)
+        return "file://" + path
+    }
+
     onWallpaperPathChanged: {
         if (wallpaperPath && wallpaperPath !== previousWallpaper) {
             // Start crossfade transition
             if (previousWallpaper) {
-                backImage.source = "file://" + previousWallpaper
+                backImage.source = imageSource(previousWallpaper)
                 backImage.opacity = 1
                 frontImage.opacity = 0
-                frontImage.source = "file://" + wallpaperPath
+                frontImage.source = imageSource(wallpaperPath)
                 fadeIn.start()
             } else {
                 // First load - no transition
-                frontImage.source = "file://" + wallpaperPath
+                frontImage.source = imageSource(wallpaperPath)
                 frontImage.opacity = 1
             }
             previousWallpaper = wallpaperPath
@@ -101,8 +121,14 @@ PanelWindow {
 
     // Initial load
     Component.onCompleted: {
+        try {
+            nativeCache = Qt.createQmlObject("import Molten.Native; WallpaperCache {}", wallpaper, "Wallpaper.nativeCache")
+        } catch (e) {
+            console.log("Wallpaper: Molten.Native not installed, loading files directly")
+        }
+
         if (wallpaperPath) {
-            frontImage.source = "file://" + wallpaperPath
+            frontImage.source = imageSource(wallpaperPath)
             frontImage.opacity = 1
             previousWallpaper = wallpaperPath
         }
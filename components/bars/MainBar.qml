@@ -710,19 +710,19 @@ Item {
                     /** Notification count badge */
                     Text {
                         anchors.centerIn: parent
-                        text: Notifications.list.length > 0 ? Notifications.list.length.toString() : "0"
+                        text: Notifications.count > 0 ? Notifications.count.toString() : "0"
                         color: adaptiveColors.textColor
                         font.pixelSize: 11
                         font.weight: Font.DemiBold
                         z: 1
-                        visible: Notifications.list.length > 0
+                        visible: Notifications.count > 0
                     }
                     
                     /** Bell icon (shown when no notifications) */
                     Text {
                         anchors.centerIn: parent
                         text: "🔔"; font.pixelSize: 16
-                        visible: Notifications.list.length === 0
+                        visible: Notifications.count === 0
                     }
                     MouseArea {
                         anchors.fill: parent
@@ -771,8 +771,8 @@ Item {
                     Text {
                         anchors.centerIn: parent
                         anchors.verticalCenterOffset: -1
-                        text: Notifications.list.length > 0 
-                              ? Notifications.list.length.toString() 
+                        text: Notifications.count > 0 
+                              ? Notifications.count.toString() 
                               : ""
                         color: adaptiveColors.textColor
                         font.pixelSize: 9
@@ -785,7 +785,7 @@ Item {
                         anchors.centerIn: parent
                         text: "🔔"
                         font.pixelSize: 13
-                        opacity: Notifications.list.length > 0 ? 0.7 : 1.0
+                        opacity: Notifications.count > 0 ? 0.7 : 1.0
                     }
                 }
             }
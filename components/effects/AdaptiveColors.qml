@@ -26,11 +26,20 @@ Item {
     property color iconColor: backgroundIsDark ? "#ffffff" : "#000000"
     property color subtleTextColor: backgroundIsDark ? Qt.rgba(1, 1, 1, 0.7) : Qt.rgba(0, 0, 0, 0.7)
     
+    // Output: palette of the content behind the glass (from the plugin's luminance samples)
+    property color averageColor: backgroundIsDark ? "#000000" : "#ffffff"
+    property color dominantColor: averageColor
+    property color accentColor: backgroundIsDark ? "#ffffff" : "#000000"
+    property bool hasDominantHue: false
+    
     // Smooth transition when colors change
     Behavior on textColor { ColorAnimation { duration: 200 } }
     Behavior on textColorSecondary { ColorAnimation { duration: 200 } }
     Behavior on iconColor { ColorAnimation { duration: 200 } }
     Behavior on subtleTextColor { ColorAnimation { duration: 200 } }
+    Behavior on averageColor { ColorAnimation { duration: 300 } }
+    Behavior on dominantColor { ColorAnimation { duration: 300 } }
+    Behavior on accentColor { ColorAnimation { duration: 300 } }
     
     // File watcher for adaptive color data (written by liquid glass plugin)
     FileView {
@@ -47,6 +56,14 @@ Item {
                 if (data[root.region]) {
                     var isDark = data[root.region].isDark
                     
+                    // Palette is only republished on meaningful change, so apply it directly
+                    if (data[root.region].averageColor !== undefined) {
+                        root.averageColor = data[root.region].averageColor
+                        root.dominantColor = data[root.region].dominantColor
+                        root.accentColor = data[root.region].accentColor
+                        root.hasDominantHue = data[root.region].dominantHue >= 0
+                    }
+                    
                     // Debounce: only change if state is stable for multiple readings
                     if (isDark === root.pendingDarkState) {
                         root.stableStateCount++
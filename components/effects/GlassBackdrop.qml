@@ -159,9 +159,14 @@ FloatingWindow {
             anchors.bottom: parent.bottom
             width: root.notchStyle ? root.targetWidth : parent.width
             
-            color: adaptiveColors.backgroundIsDark ? 
-                   Qt.rgba(0, 0, 0, 0.15) : 
-                   Qt.rgba(1, 1, 1, 0.15)
+            // Black/white tint, pulled towards the dominant color behind the glass
+            readonly property color baseTint: adaptiveColors.backgroundIsDark ? "#000000" : "#ffffff"
+            readonly property real hueMix: adaptiveColors.hasDominantHue ? 0.35 : 0.0
+            
+            color: Qt.rgba(baseTint.r + (adaptiveColors.dominantColor.r - baseTint.r) * hueMix,
+                           baseTint.g + (adaptiveColors.dominantColor.g - baseTint.g) * hueMix,
+                           baseTint.b + (adaptiveColors.dominantColor.b - baseTint.b) * hueMix,
+                           0.15)
             radius: root.targetRadius
             
             Rectangle {
@@ -0,0 +1,120 @@
+#pragma once
+
+/*
+ * Hyprland Mock
+ * Just enough of Hyprland's window, workspace, monitor, decoration and
+ * render pass types for LiquidGlassWindows.hpp to compile and run against,
+ * with the same member names. Pointers are std::shared_ptr/std::weak_ptr
+ * standing in for hyprutils' SP/WP; the renderer only counts damage.
+ */
+
+#include <hyprutils/math/Box.hpp>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Hyprutils::Math;
+
+// PHLANIMVAR<Vector2D>
+struct SAnimatedVector {
+    Vector2D m_value;
+    bool     m_animating = false;
+
+    bool     isBeingAnimated() const {
+        return m_animating;
+    }
+
+    const Vector2D& value() const {
+        return m_value;
+    }
+};
+
+struct CWorkspace {
+    int                              m_id = 0;
+    std::unique_ptr<SAnimatedVector> m_renderOffset = std::make_unique<SAnimatedVector>();
+};
+
+class IHyprWindowDecoration {
+  public:
+    virtual ~IHyprWindowDecoration() = default;
+
+    virtual std::string getDisplayName() = 0;
+    virtual void        damageEntire()   = 0;
+};
+
+class CWindow {
+  public:
+    std::vector<std::shared_ptr<IHyprWindowDecoration>> m_windowDecorations;
+    std::shared_ptr<CWorkspace>                         m_workspace;
+    bool                                                m_pinned = false;
+    Vector2D                                            m_floatingOffset;
+    CBox                                                m_surfaceBox;
+
+    CBox                                                getWindowMainSurfaceBox() const {
+        return m_surfaceBox;
+    }
+};
+
+using PHLWINDOW    = std::shared_ptr<CWindow>;
+using PHLWINDOWREF = std::weak_ptr<CWindow>;
+
+// What every window carries before the plugin adds its own
+class CHyprBorderDecoration : public IHyprWindowDecoration {
+  public:
+    std::string getDisplayName() override {
+        return "Border";
+    }
+
+    void damageEntire() override {}
+};
+
+class CHyprDropShadowDecoration : public IHyprWindowDecoration {
+  public:
+    std::string getDisplayName() override {
+        return "Drop Shadow";
+    }
+
+    void damageEntire() override {}
+};
+
+struct CMonitor {
+    Vector2D m_position;
+    Vector2D m_size = {2560, 1440};
+};
+
+class IPassElement {
+  public:
+    virtual ~IPassElement() = default;
+
+    virtual std::optional<CBox> boundingBox() = 0;
+};
+
+class CRenderPass {
+  public:
+    std::vector<std::unique_ptr<IPassElement>> m_elements;
+
+    void                                       add(std::unique_ptr<IPassElement>&& element) {
+        m_elements.emplace_back(std::move(element));
+    }
+
+    void clear() {
+        m_elements.clear();
+    }
+};
+
+// g_pHyprRenderer: damage is only summed, so it can't be optimized away
+class CHyprRenderer {
+  public:
+    CRenderPass m_renderPass;
+    double      m_damagedArea = 0;
+    uint64_t    m_damageCalls = 0;
+
+    void        damageBox(const CBox& box) {
+        m_damagedArea += box.width * box.height;
+        m_damageCalls++;
+    }
+};
+
+inline CHyprRenderer g_hyprRenderer;
+inline auto*         g_pHyprRenderer = &g_hyprRenderer;
@@ -0,0 +1,266 @@
+/*
+ * Liquid Glass Bookkeeping Benchmark
+ * Times the plugin's per-window CPU work (LiquidGlassWindows.hpp, the same
+ * code the openWindow, closeWindow and workspace callbacks and the pass
+ * element run) at 10 to 1000 windows, against HyprlandMock.hpp instead of a
+ * compositor. Windows are spread over ten workspaces; a frame queues one
+ * pass element per window on the active one and asks each for its box.
+ *
+ * make bench, or: ./liquid-glass-bench [-j] [window counts...]
+ *
+ * Costs are nanoseconds per operation, the median over repeated rounds.
+ * Close, workspace switch and frame walk every tracked decoration, so their
+ * cost per window should stay flat as windows are added; open should stay
+ * flat per operation. Anything climbing is an algorithmic regression.
+ */
+
+#include "HyprlandMock.hpp"
+#include "LiquidGlassWindows.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+constexpr int    WORKSPACES      = 10;
+constexpr size_t OPS_PER_MEASURE = 200000; // Operations timed per window count, spread over rounds
+constexpr int    MIN_ROUNDS      = 5;
+
+// ============================================================================
+// PLUGIN STAND-INS
+// ============================================================================
+
+// CLiquidGlassDecoration's bookkeeping surface: owner, name, damage
+class CGlassDecoration : public IHyprWindowDecoration {
+  public:
+    CGlassDecoration(PHLWINDOW window) : m_pWindow(window) {}
+
+    std::string getDisplayName() override {
+        return "LiquidGlass";
+    }
+
+    void damageEntire() override {
+        const auto PWINDOW = m_pWindow.lock();
+        if (!PWINDOW)
+            return;
+
+        g_pHyprRenderer->damageBox(CLiquidGlassWindows::glassBox(PWINDOW));
+    }
+
+    PHLWINDOW getOwner() {
+        return m_pWindow.lock();
+    }
+
+  private:
+    PHLWINDOWREF m_pWindow;
+};
+
+// CLiquidGlassPassElement::boundingBox
+class CGlassPassElement : public IPassElement {
+  public:
+    CGlassPassElement(CGlassDecoration* deco) : m_deco(deco) {}
+
+    std::optional<CBox> boundingBox() override {
+        const auto PWINDOW = m_deco->getOwner();
+        if (!PWINDOW)
+            return std::nullopt;
+
+        return CLiquidGlassWindows::glassBox(PWINDOW);
+    }
+
+  private:
+    CGlassDecoration* m_deco;
+};
+
+static std::vector<std::weak_ptr<CGlassDecoration>> g_decorations;
+
+// onNewWindow, without the animator
+static void openWindow(const PHLWINDOW& window) {
+    if (CLiquidGlassWindows::hasDecoration(window))
+        return;
+
+    auto deco = std::make_shared<CGlassDecoration>(window);
+    g_decorations.emplace_back(deco);
+    window->m_windowDecorations.emplace_back(std::move(deco));
+}
+
+// onCloseWindow
+static void closeWindow(const PHLWINDOW& window) {
+    CLiquidGlassWindows::forget(g_decorations, window);
+}
+
+// onWorkspaceChange, without the animator
+static void switchWorkspace() {
+    CLiquidGlassWindows::damageAll(g_decorations);
+}
+
+// ============================================================================
+// SCENE
+// ============================================================================
+
+struct SScene {
+    std::vector<std::shared_ptr<CWorkspace>> workspaces;
+    std::vector<PHLWINDOW>                   windows;
+    int                                      active = 0;
+};
+
+static SScene makeScene(size_t count, std::mt19937& rng) {
+    SScene scene;
+    for (int i = 0; i < WORKSPACES; ++i) {
+        scene.workspaces.emplace_back(std::make_shared<CWorkspace>());
+        scene.workspaces.back()->m_id = i + 1;
+    }
+
+    std::uniform_real_distribution<double> pos(0, 2000), size(100, 1200);
+    for (size_t i = 0; i < count; ++i) {
+        auto window = std::make_shared<CWindow>();
+        window->m_workspace  = scene.workspaces[i % WORKSPACES];
+        window->m_pinned     = i % 50 == 0;
+        window->m_surfaceBox = {pos(rng), pos(rng), size(rng), size(rng)};
+        window->m_windowDecorations.emplace_back(std::make_shared<CHyprBorderDecoration>());
+        window->m_windowDecorations.emplace_back(std::make_shared<CHyprDropShadowDecoration>());
+        scene.windows.emplace_back(std::move(window));
+    }
+
+    return scene;
+}
+
+template <typename TFn>
+static double timeNs(TFn&& fn) {
+    const auto START = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - START).count();
+}
+
+static double median(std::vector<double>& samples) {
+    std::ranges::sort(samples);
+    return samples[samples.size() / 2];
+}
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+struct SResult {
+    size_t windows     = 0;
+    double openNs      = 0; // Per window opened
+    double closeNs     = 0; // Per window closed
+    double workspaceNs = 0; // Per switch
+    double frameNs     = 0; // Per frame
+    double visible     = 0; // Pass elements per frame
+};
+
+static SResult measure(size_t count) {
+    std::mt19937        rng(count);
+    const int           ROUNDS = std::max<int>(MIN_ROUNDS, OPS_PER_MEASURE / count);
+    std::vector<double> open, close, workspace, frame;
+
+    SResult             result;
+    result.windows = count;
+
+    for (int round = 0; round < ROUNDS; ++round) {
+        auto scene = makeScene(count, rng);
+        g_decorations.clear();
+        g_decorations.reserve(count);
+
+        open.push_back(timeNs([&] {
+            for (const auto& window : scene.windows)
+                openWindow(window);
+        }) / count);
+
+        // A slide from one workspace to the next: both animate while everything is damaged
+        const int SWITCHES = 10;
+        workspace.push_back(timeNs([&] {
+            for (int i = 0; i < SWITCHES; ++i) {
+                scene.workspaces[scene.active]->m_renderOffset->m_animating = false;
+                scene.active                                                = (scene.active + 1) % WORKSPACES;
+                scene.workspaces[scene.active]->m_renderOffset->m_animating = true;
+                scene.workspaces[scene.active]->m_renderOffset->m_value     = {static_cast<double>(i), 0};
+                switchWorkspace();
+            }
+        }) / SWITCHES);
+
+        // The render pass asks every queued element for its box each frame
+        auto& pass = g_pHyprRenderer->m_renderPass;
+        for (const auto& window : scene.windows) {
+            if (window->m_workspace == scene.workspaces[scene.active] || window->m_pinned)
+                pass.add(std::make_unique<CGlassPassElement>(static_cast<CGlassDecoration*>(window->m_windowDecorations.back().get())));
+        }
+        result.visible = pass.m_elements.size();
+
+        const int FRAMES = 10;
+        double    area   = 0;
+        frame.push_back(timeNs([&] {
+            for (int i = 0; i < FRAMES; ++i) {
+                for (const auto& element : pass.m_elements) {
+                    if (const auto BOX = element->boundingBox())
+                        area += BOX->width * BOX->height;
+                }
+            }
+        }) / FRAMES);
+        pass.clear();
+        g_pHyprRenderer->m_damagedArea += area;
+
+        // Windows close in no particular order
+        auto closing = scene.windows;
+        std::ranges::shuffle(closing, rng);
+        close.push_back(timeNs([&] {
+            for (const auto& window : closing)
+                closeWindow(window);
+        }) / count);
+    }
+
+    result.openNs      = median(open);
+    result.closeNs     = median(close);
+    result.workspaceNs = median(workspace);
+    result.frameNs     = median(frame);
+    return result;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+int main(int argc, char** argv) {
+    bool                json = false;
+    std::vector<size_t> counts;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-j"))
+            json = true;
+        else if (const long COUNT = std::strtol(argv[i], nullptr, 10); COUNT > 0)
+            counts.push_back(COUNT);
+        else {
+            std::fprintf(stderr, "usage: %s [-j] [window counts...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (counts.empty())
+        counts = {10, 25, 50, 100, 250, 500, 1000};
+
+    if (!json)
+        std::printf("%8s %8s %12s %12s %14s %14s %14s %14s\n", "windows", "visible", "open ns", "close ns", "close ns/win", "workspace ns", "workspace/win",
+                    "frame ns/win");
+    else
+        std::printf("[");
+
+    for (size_t i = 0; i < counts.size(); ++i) {
+        const SResult R = measure(counts[i]);
+
+        if (json)
+            std::printf(R"(%s{"windows":%zu,"visible":%.0f,"openNs":%.1f,"closeNs":%.1f,"workspaceNs":%.1f,"frameNs":%.1f})", i ? "," : "", R.windows, R.visible,
+                        R.openNs, R.closeNs, R.workspaceNs, R.frameNs);
+        else
+            std::printf("%8zu %8.0f %12.1f %12.1f %14.2f %14.1f %14.2f %14.2f\n", R.windows, R.visible, R.openNs, R.closeNs, R.closeNs / R.windows, R.workspaceNs,
+                        R.workspaceNs / R.windows, R.visible > 0 ? R.frameNs / R.visible : 0.0);
+    }
+
+    if (json)
+        std::printf("]\n");
+
+    // Keeps the damage and boxes live through the optimizer
+    return g_pHyprRenderer->m_damagedArea < 0 ? 2 : 0;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+// The slice of hyprutils' Vector2D and CBox the bookkeeping uses
+
+namespace Hyprutils::Math {
+    struct Vector2D {
+        double x = 0;
+        double y = 0;
+    };
+
+    struct CBox {
+        double x = 0, y = 0, width = 0, height = 0;
+
+        CBox&  translate(const Vector2D& vec) {
+            x += vec.x;
+            y += vec.y;
+            return *this;
+        }
+    };
+}
@@ -12,22 +12,21 @@ precision highp float;
  * 5. Subtle interior blur for glass thickness
  */
 
+#include "liquidglass_common.glsl"
+
 // Uniforms
 uniform sampler2D tex;
 uniform vec2 topLeft;
 uniform vec2 fullSize;
 uniform vec2 fullSizeUntransformed;
 uniform float radius;
-uniform float time;
 
-// Configurable parameters
-uniform float blurStrength;        // Interior blur amount (0.0 - 2.0)
-uniform float refractionStrength;  // Edge refraction intensity (0.0 - 0.15)
-uniform float chromaticAberration; // RGB separation amount (0.0 - 0.02)
-uniform float fresnelStrength;     // Edge glow intensity (0.0 - 1.0)
-uniform float specularStrength;    // Highlight brightness (0.0 - 1.0)
-uniform float glassOpacity;        // Overall glass opacity (0.0 - 1.0)
-uniform float edgeThickness;       // How thick the refractive edge is (0.0 - 0.3)
+// Pre-blurred background from the compute blur path (preBlurred == 1)
+uniform sampler2D blurTex;
+uniform int preBlurred;
+
+uniform float windowAlpha;         // Window opacity, applied on top of glassOpacity
+uniform float lod;                 // Motion level of detail: 0 = full quality, 1 = reduced (no chromatic, 3-tap blur)
 
 in vec2 v_texcoord;
 layout(location = 0) out vec4 fragColor;
@@ -276,6 +275,27 @@ vec3 fastBlur(vec2 uv, vec2 texelSize, float strength) {
     return result;
 }
 
+// 3-tap blur used while the surface is in motion
+vec3 cheapBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off = vec2(2.0) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.4;
+    result += texture(tex, clamp(uv + off, 0.0, 1.0)).rgb * 0.3;
+    result += texture(tex, clamp(uv - off, 0.0, 1.0)).rgb * 0.3;
+
+    return result;
+}
+
+// Crossfade between the full and reduced blur (lod is uniform, so the branches are coherent)
+vec3 lodBlur(vec2 uv, vec2 texelSize, float strength) {
+    if (lod <= 0.0)
+        return fastBlur(uv, texelSize, strength);
+    if (lod >= 1.0)
+        return cheapBlur(uv, texelSize, strength);
+
+    return mix(fastBlur(uv, texelSize, strength), cheapBlur(uv, texelSize, strength), lod);
+}
+
 // ============================================================================
 // COLOR SMOOTHING - Create water-like fluid appearance
 // ============================================================================
@@ -439,19 +459,26 @@ void main() {
     // ========================================
     // 2. CHROMATIC DISPERSION - Color separation
     // ========================================
-    vec2 edgeNormal = getEdgeNormal(uv);
-    float chromaStrength = length(borderRefract) * chromaticAberration * 2.0;
-    
-    float r = texture(tex, clamp(refractedUV - edgeNormal * chromaStrength * 0.8, 0.0, 1.0)).r;
-    float g = texture(tex, clamp(refractedUV, 0.0, 1.0)).g;
-    float b = texture(tex, clamp(refractedUV + edgeNormal * chromaStrength * 1.2, 0.0, 1.0)).b;
-    
-    vec3 refractedColor = vec3(r, g, b);
+    // Faded out with the motion LOD; skipped entirely while in motion
+    vec3 refractedColor;
+    if (lod >= 1.0) {
+        refractedColor = texture(tex, refractedUV).rgb;
+    } else {
+        vec2 edgeNormal = getEdgeNormal(uv);
+        float chromaStrength = length(borderRefract) * chromaticAberration * 2.0 * (1.0 - lod);
+
+        float r = texture(tex, clamp(refractedUV - edgeNormal * chromaStrength * 0.8, 0.0, 1.0)).r;
+        float g = texture(tex, clamp(refractedUV, 0.0, 1.0)).g;
+        float b = texture(tex, clamp(refractedUV + edgeNormal * chromaStrength * 1.2, 0.0, 1.0)).b;
+
+        refractedColor = vec3(r, g, b);
+    }
     
     // ========================================
     // 3. BLUR - Frosted glass effect
     // ========================================
-    vec3 blurredColor = fastBlur(refractedUV, texelSize, blurStrength);
+    vec3 blurredColor = preBlurred == 1 ? texture(blurTex, refractedUV).rgb
+                                        : lodBlur(refractedUV, texelSize, blurStrength);
     
     // Mix refracted and blurred
     vec3 glassColor = mix(blurredColor, refractedColor, 0.4);
@@ -466,6 +493,10 @@ void main() {
     float depthBrightness = mix(0.98, 1.02, depthFactor);
     glassColor *= depthBrightness;
     
+    // Animated shimmer (skipped entirely when off)
+    if (shimmerStrength > 0.0)
+        glassColor *= 1.0 + shimmerStrength * shimmer(uv * fullSize) * 0.04;
+
     // ========================================
     // 7. FINAL ADJUSTMENTS
     // ========================================
@@ -476,5 +507,5 @@ void main() {
     // Clamp to valid range
     finalColor = clamp(finalColor, 0.0, 1.0);
      
-    fragColor = vec4(finalColor, glassOpacity * cornerAlpha);
+    fragColor = vec4(finalColor, glassOpacity * windowAlpha * cornerAlpha);
 }
@@ -0,0 +1,37 @@
+/*
+ * Liquid Glass Shader Prelude
+ *
+ * Declarations every glass shader shares. Not a shader of its own: each
+ * '#include "liquidglass_common.glsl"' line in a fragment shader is replaced
+ * with this file when the shader is compiled (see LiquidGlassShaderDev.cpp),
+ * so it comes after the #version and precision lines.
+ */
+
+// Configurable parameters (per-profile uniform buffer, see LiquidGlassProfiles.hpp)
+layout(std140) uniform GlassParams {
+    float blurStrength;        // Interior blur amount (0.0 - 2.0)
+    float refractionStrength;  // Edge refraction intensity (0.0 - 0.15)
+    float chromaticAberration; // RGB separation amount (0.0 - 0.02)
+    float fresnelStrength;     // Edge glow intensity (0.0 - 1.0)
+    float specularStrength;    // Highlight brightness (0.0 - 1.0)
+    float glassOpacity;        // Overall glass opacity (0.0 - 1.0)
+    float edgeThickness;       // How thick the refractive edge is (0.0 - 0.3)
+};
+
+uniform float time;                // Animation clock
+uniform float shimmerStrength;     // Animated glass mode: 0 = off, 1 = on
+
+// Slow caustic shimmer for the animated glass mode, in pixel space so every glass shader agrees
+float shimmer(vec2 px) {
+    vec2 p = px / 90.0;
+    float a = sin(p.x * 1.7 + time * 0.9) * sin(p.y * 1.3 - time * 0.7);
+    float b = sin((p.x + p.y) * 0.9 + time * 1.3);
+    return a * 0.6 + b * 0.4;
+}
+
+// 4x4 ordered dither in [-0.5, 0.5)
+float bayerDither(vec2 fragCoord) {
+    const float BAYER[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 p = ivec2(fragCoord) & 3;
+    return (BAYER[p.y * 4 + p.x] + 0.5) / 16.0 - 0.5;
+}
@@ -0,0 +1,80 @@
+#version 300 es
+precision highp float;
+
+/*
+ * Liquid Glass Interior Fragment Shader
+ *
+ * Cheap blur-and-tint path for the part of the glass that lies deeper than
+ * the refractive border band. There, liquidglass.frag has no refraction,
+ * chromatic dispersion, corner masking or edge brightening, so this shader
+ * reproduces its output exactly with only the blur and tint steps.
+ */
+
+#include "liquidglass_common.glsl"
+
+// Uniforms
+uniform sampler2D tex;
+uniform vec2 fullSize;
+
+// Pre-blurred background from the compute blur path (preBlurred == 1)
+uniform sampler2D blurTex;
+uniform int preBlurred;
+
+uniform float windowAlpha;         // Window opacity, applied on top of glassOpacity
+uniform float lod;                 // Motion level of detail, as in liquidglass.frag
+
+in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+// Same 5-tap blur as liquidglass.frag
+vec3 fastBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off1 = vec2(1.3846153846) * texelSize * strength;
+    vec2 off2 = vec2(3.2307692308) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.2270270270;
+    result += texture(tex, clamp(uv + off1, 0.0, 1.0)).rgb * 0.3162162162;
+    result += texture(tex, clamp(uv - off1, 0.0, 1.0)).rgb * 0.3162162162;
+    result += texture(tex, clamp(uv + off2, 0.0, 1.0)).rgb * 0.0702702703;
+    result += texture(tex, clamp(uv - off2, 0.0, 1.0)).rgb * 0.0702702703;
+
+    return result;
+}
+
+// Same 3-tap motion blur and crossfade as liquidglass.frag
+vec3 cheapBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off = vec2(2.0) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.4;
+    result += texture(tex, clamp(uv + off, 0.0, 1.0)).rgb * 0.3;
+    result += texture(tex, clamp(uv - off, 0.0, 1.0)).rgb * 0.3;
+
+    return result;
+}
+
+vec3 lodBlur(vec2 uv, vec2 texelSize, float strength) {
+    if (lod <= 0.0)
+        return fastBlur(uv, texelSize, strength);
+    if (lod >= 1.0)
+        return cheapBlur(uv, texelSize, strength);
+
+    return mix(fastBlur(uv, texelSize, strength), cheapBlur(uv, texelSize, strength), lod);
+}
+
+void main() {
+    vec2 uv = clamp(v_texcoord, 0.001, 0.999);
+    vec2 texelSize = 1.0 / fullSize;
+
+    // Blur mixed with the unrefracted sample, as in the full shader
+    vec3 blurredColor = preBlurred == 1 ? texture(blurTex, uv).rgb : lodBlur(uv, texelSize, blurStrength);
+    vec3 glassColor = mix(blurredColor, texture(tex, uv).rgb, 0.4);
+
+    // Interior depth brightness and cool glass tint
+    glassColor *= 0.98;
+    if (shimmerStrength > 0.0)
+        glassColor *= 1.0 + shimmerStrength * shimmer(v_texcoord * fullSize) * 0.04;
+
+    vec3 finalColor = glassColor * vec3(0.99, 0.995, 1.0);
+    finalColor = clamp(finalColor, 0.0, 1.0);
+
+    fragColor = vec4(finalColor, glassOpacity * windowAlpha);
+}
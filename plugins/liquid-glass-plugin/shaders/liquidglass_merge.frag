@@ -0,0 +1,205 @@
+#version 300 es
+precision highp float;
+
+/*
+ * Liquid Glass Merge Fragment Shader
+ *
+ * Renders a group of nearby glass surfaces as one shape: the smooth union
+ * of their rounded-rect SDFs, so neighbouring surfaces bridge into each
+ * other like liquid. Each member draws it scissored to its own box, from a
+ * sample of the group's box taken just before, then the part of the bridges
+ * closest to it.
+ *
+ * Same refraction, dispersion, blur and tint as liquidglass.frag, with the
+ * edge measured in pixels against the union shape.
+ */
+
+#define MAX_MEMBERS 4
+
+#include "liquidglass_common.glsl"
+
+// Uniforms
+uniform sampler2D tex;
+uniform vec2 fullSize;             // Group bounding box in pixels
+
+uniform int memberCount;
+uniform vec4 memberRects[MAX_MEMBERS];   // x, y, w, h in pixels, relative to the bounding box
+uniform float memberRadii[MAX_MEMBERS];  // Corner radius in pixels
+uniform float smoothness;          // Smooth-union radius in pixels
+uniform float refHeight;           // Pixel height that edgeThickness is relative to
+uniform int bridgeOwner;           // >= 0: only bridges closest to this member, outside every member's rect
+
+// Pre-blurred background from the compute blur path (preBlurred == 1)
+uniform sampler2D blurTex;
+uniform int preBlurred;
+
+uniform float windowAlpha;         // Window opacity, applied on top of glassOpacity
+uniform float lod;                 // Motion level of detail, as in liquidglass.frag
+
+in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+// ============================================================================
+// SHAPE
+// ============================================================================
+
+float roundedBoxSDF(vec2 p, vec2 halfSize, float r) {
+    vec2 q = abs(p) - halfSize + r;
+    return min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - r;
+}
+
+// Polynomial smooth minimum
+float smoothMin(float a, float b, float k) {
+    if (k <= 0.0)
+        return min(a, b);
+
+    float h = max(k - abs(a - b), 0.0) / k;
+    return min(a, b) - h * h * k * 0.25;
+}
+
+float sceneSDF(vec2 p) {
+    float d = 1e5;
+    for (int i = 0; i < MAX_MEMBERS; ++i) {
+        if (i >= memberCount)
+            break;
+
+        vec4 rect = memberRects[i];
+        vec2 halfSize = rect.zw * 0.5;
+        float r = min(memberRadii[i], min(halfSize.x, halfSize.y));
+        d = smoothMin(d, roundedBoxSDF(p - rect.xy - halfSize, halfSize, r), smoothness);
+    }
+
+    return d;
+}
+
+vec2 sceneNormal(vec2 p, float d) {
+    float dx = sceneSDF(p + vec2(1.0, 0.0)) - d;
+    float dy = sceneSDF(p + vec2(0.0, 1.0)) - d;
+    return normalize(vec2(dx, dy) + 0.0001);
+}
+
+// ============================================================================
+// BLUR (same kernels as liquidglass.frag)
+// ============================================================================
+
+vec3 fastBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off1 = vec2(1.3846153846) * texelSize * strength;
+    vec2 off2 = vec2(3.2307692308) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.2270270270;
+    result += texture(tex, clamp(uv + off1, 0.0, 1.0)).rgb * 0.3162162162;
+    result += texture(tex, clamp(uv - off1, 0.0, 1.0)).rgb * 0.3162162162;
+    result += texture(tex, clamp(uv + off2, 0.0, 1.0)).rgb * 0.0702702703;
+    result += texture(tex, clamp(uv - off2, 0.0, 1.0)).rgb * 0.0702702703;
+
+    return result;
+}
+
+vec3 cheapBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off = vec2(2.0) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.4;
+    result += texture(tex, clamp(uv + off, 0.0, 1.0)).rgb * 0.3;
+    result += texture(tex, clamp(uv - off, 0.0, 1.0)).rgb * 0.3;
+
+    return result;
+}
+
+vec3 lodBlur(vec2 uv, vec2 texelSize, float strength) {
+    if (lod <= 0.0)
+        return fastBlur(uv, texelSize, strength);
+    if (lod >= 1.0)
+        return cheapBlur(uv, texelSize, strength);
+
+    return mix(fastBlur(uv, texelSize, strength), cheapBlur(uv, texelSize, strength), lod);
+}
+
+// ============================================================================
+// MAIN SHADER
+// ============================================================================
+
+void main() {
+    vec2 px = v_texcoord * fullSize;
+    vec2 texelSize = 1.0 / fullSize;
+
+    if (bridgeOwner >= 0) {
+        // Each bridge pixel belongs to the nearest member, so every member that renders draws its share once
+        int nearest = 0;
+        float nearestDist = 1e5;
+        for (int i = 0; i < MAX_MEMBERS; ++i) {
+            if (i >= memberCount)
+                break;
+
+            vec4 rect = memberRects[i];
+            if (all(greaterThanEqual(px, rect.xy)) && all(lessThan(px, rect.xy + rect.zw)))
+                discard;
+
+            vec2 halfSize = rect.zw * 0.5;
+            float d = roundedBoxSDF(px - rect.xy - halfSize, halfSize, min(memberRadii[i], min(halfSize.x, halfSize.y)));
+            if (d < nearestDist) {
+                nearestDist = d;
+                nearest = i;
+            }
+        }
+
+        if (nearest != bridgeOwner)
+            discard;
+    }
+
+    // Outside the merged shape (most of the gap between surfaces) costs one SDF
+    float dist = sceneSDF(px);
+    if (dist > 1.0)
+        discard;
+
+    float shapeAlpha = 1.0 - smoothstep(-1.0, 1.0, dist);
+
+    // Edge distance and border width in units of refHeight, as liquidglass.frag measures them
+    float edgeDist = dist / refHeight;
+    float borderWidth = edgeThickness * 1.5;
+    vec2 edgeNormal = sceneNormal(px, dist);
+
+    // ========================================
+    // 1. BORDER REFRACTION
+    // ========================================
+    float innerFalloff = smoothstep(-borderWidth * 1.5, -borderWidth * 0.7, edgeDist);
+    float outerFalloff = 1.0 - smoothstep(-borderWidth * 0.1, 0.0, edgeDist);
+    float borderPos = clamp((edgeDist + borderWidth) / borderWidth, 0.0, 1.0);
+
+    float refractionProfile = borderPos * (1.0 - borderPos) * 4.0 * mix(0.7, 1.6, borderPos);
+    float refractionDir = smoothstep(0.0, 1.0, borderPos) * 2.0 - 1.0;
+    float strength = refractionProfile * refractionDir * refractionStrength * 4.0 * innerFalloff * outerFalloff;
+
+    vec2 borderRefract = edgeNormal * strength * refHeight * texelSize;
+    vec2 refractedUV = clamp(v_texcoord + borderRefract, 0.001, 0.999);
+
+    // ========================================
+    // 2. CHROMATIC DISPERSION
+    // ========================================
+    vec3 refractedColor;
+    if (lod >= 1.0) {
+        refractedColor = texture(tex, refractedUV).rgb;
+    } else {
+        vec2 chroma = edgeNormal * length(borderRefract) * chromaticAberration * 2.0 * (1.0 - lod);
+
+        float r = texture(tex, clamp(refractedUV - chroma * 0.8, 0.0, 1.0)).r;
+        float g = texture(tex, refractedUV).g;
+        float b = texture(tex, clamp(refractedUV + chroma * 1.2, 0.0, 1.0)).b;
+
+        refractedColor = vec3(r, g, b);
+    }
+
+    // ========================================
+    // 3. BLUR, DEPTH AND TINT
+    // ========================================
+    vec3 blurredColor = preBlurred == 1 ? texture(blurTex, refractedUV).rgb
+                                        : lodBlur(refractedUV, texelSize, blurStrength);
+    vec3 glassColor = mix(blurredColor, refractedColor, 0.4);
+    glassColor *= mix(0.98, 1.02, smoothstep(-borderWidth, 0.0, edgeDist));
+    if (shimmerStrength > 0.0)
+        glassColor *= 1.0 + shimmerStrength * shimmer(px) * 0.04;
+
+    vec3 finalColor = glassColor * vec3(0.99, 0.995, 1.0);
+    finalColor = clamp(finalColor, 0.0, 1.0);
+
+    fragColor = vec4(finalColor, glassOpacity * windowAlpha * shapeAlpha);
+}
@@ -0,0 +1,28 @@
+#version 300 es
+precision highp float;
+
+/*
+ * Liquid Glass Sample Fragment Shader
+ *
+ * Copies part of a 10-bit or half-float framebuffer into an 8-bit
+ * background sample. The copy is where precision is lost, so that is where
+ * it dithers, by one step of the sample: the glass blur then averages the
+ * pattern back into the gradients an 8-bit copy would band.
+ */
+
+#include "liquidglass_common.glsl"
+
+// Uniforms
+uniform sampler2D tex;
+uniform vec4 srcRect;              // Region of tex to copy, in texture coordinates: x, y, width, height
+uniform float ditherStep;          // One step of the sample format
+
+in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    vec3 color = texture(tex, srcRect.xy + v_texcoord * srcRect.zw).rgb;
+
+    // Opaque, so the copy replaces the sample whatever blending is enabled
+    fragColor = vec4(clamp(color + bayerDither(gl_FragCoord.xy) * ditherStep, 0.0, 1.0), 1.0);
+}
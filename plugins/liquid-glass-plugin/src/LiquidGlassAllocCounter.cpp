@@ -0,0 +1,147 @@
+#include "LiquidGlassAllocCounter.hpp"
+#include "LiquidGlassPassElement.hpp"
+#include "globals.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <new>
+
+// Clean frames in a row before an allocation counts as a failure (the first frames fill pools and buffers)
+constexpr uint64_t      STEADY_FRAMES = 120;
+
+// Render-thread only: nested scopes (draw inside renderPass) count once
+static thread_local int g_scopeDepth = 0;
+
+static uint64_t         g_frameAllocations  = 0; // Current frame, pass elements' control blocks included
+static uint64_t         g_frameElements     = 0; // Pass elements queued this frame
+static uint64_t         g_lastAllocations   = 0; // Previous frame, beyond its pass elements
+static uint64_t         g_lastElements      = 0;
+static uint64_t         g_totalAllocations  = 0;
+static uint64_t         g_frames            = 0;
+static uint64_t         g_cleanFrames       = 0; // Consecutive frames without an allocation beyond their pass elements
+static uint64_t         g_peakAllocations   = 0; // Worst single frame
+static uint64_t         g_failures          = 0; // Frames that allocated after STEADY_FRAMES clean ones
+
+// ============================================================================
+// COUNTING
+// ============================================================================
+
+CLiquidGlassAllocCounter::CScope::CScope() {
+    ++g_scopeDepth;
+}
+
+CLiquidGlassAllocCounter::CScope::~CScope() {
+    --g_scopeDepth;
+}
+
+bool CLiquidGlassAllocCounter::isCounting() {
+#ifdef LIQUID_GLASS_ALLOC_COUNTER
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CLiquidGlassAllocCounter::onAllocation() {
+    if (g_scopeDepth > 0)
+        ++g_frameAllocations;
+}
+
+void CLiquidGlassAllocCounter::onPassElement() {
+    ++g_frameElements;
+}
+
+void CLiquidGlassAllocCounter::onFrame() {
+    // Every allocation but the elements' control blocks is the plugin's own
+    const uint64_t OWN = g_frameAllocations - std::min(g_frameAllocations, g_frameElements);
+
+    if (isCounting() && OWN && g_cleanFrames >= STEADY_FRAMES) {
+        ++g_failures;
+        g_pGlobalState->io.log(std::format("allocation check failed: {} render path allocations in a steady-state frame", OWN));
+    }
+
+    ++g_frames;
+    g_totalAllocations += OWN;
+    g_peakAllocations = std::max(g_peakAllocations, OWN);
+    g_cleanFrames     = OWN ? 0 : g_cleanFrames + 1;
+    g_lastAllocations = OWN;
+    g_lastElements    = g_frameElements;
+
+    g_frameAllocations = 0;
+    g_frameElements    = 0;
+}
+
+void CLiquidGlassAllocCounter::reset() {
+    g_frameAllocations = g_frameElements = g_lastAllocations = g_lastElements = g_totalAllocations = 0;
+    g_frames = g_cleanFrames = g_peakAllocations = g_failures = 0;
+}
+
+std::string CLiquidGlassAllocCounter::getStats(eHyprCtlOutputFormat format) {
+    const auto POOL = CLiquidGlassPassElement::poolStats();
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        return std::format(
+            R"({{"counting":{},"frames":{},"lastFrame":{},"lastFrameElements":{},"peakFrame":{},"total":{},"cleanFrames":{},"failures":{},"poolBlocks":{},"poolFree":{}}})",
+            isCounting(), g_frames, g_lastAllocations, g_lastElements, g_peakAllocations, g_totalAllocations, g_cleanFrames, g_failures, POOL.blocks, POOL.free);
+    }
+
+    std::string result;
+    if (isCounting())
+        result = std::format("{}frames: {}\nlast frame: {} (plus {} pass element control blocks)\npeak frame: {}\ntotal: {}\nframes without allocations: {}\n"
+                             "steady-state frames that allocated: {}\n",
+                             g_failures ? "FAIL: the render path allocated in steady state (see the debug log)\n" : "", g_frames, g_lastAllocations,
+                             g_lastElements, g_peakAllocations, g_totalAllocations, g_cleanFrames, g_failures);
+    else
+        result = "render path allocations: not counted (build with ALLOC_COUNTER=1)\n";
+
+    return result + std::format("pass element pool: {} blocks, {} free\n", POOL.blocks, POOL.free);
+}
+
+// ============================================================================
+// COUNTING OPERATOR NEW
+// ============================================================================
+
+// Linked with -Bsymbolic, so only the plugin's own allocations come through
+// here; Hyprland and everything else keep their own operator new. Memory is
+// plain malloc either way, so either side may free it.
+#ifdef LIQUID_GLASS_ALLOC_COUNTER
+
+void* operator new(std::size_t size) {
+    CLiquidGlassAllocCounter::onAllocation();
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    CLiquidGlassAllocCounter::onAllocation();
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+/*
+ * Liquid Glass Allocation Counter
+ * Counts heap allocations the plugin makes inside its render path, from
+ * queueing the pass elements to drawing them. Each element handed to the
+ * render pass costs exactly one: the control block of the owning pointer
+ * Hyprland takes, which the plugin can't avoid; the steady state (no resizes,
+ * no config changes, no color changes to publish) should make no others. Once
+ * the path has run clean for STEADY_FRAMES frames, a frame that allocates
+ * anyway fails the check: it is logged and counted as a failure. Counting
+ * needs a build with ALLOC_COUNTER=1, which swaps in counting global operator
+ * new/delete for the plugin's own code; otherwise only the pass element pool
+ * is reported.
+ */
+
+#include <hyprland/src/plugins/PluginAPI.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class CLiquidGlassAllocCounter {
+  public:
+    // Allocations inside a live scope count against the current frame
+    class CScope {
+      public:
+        CScope();
+        ~CScope();
+
+        CScope(const CScope&)            = delete;
+        CScope& operator=(const CScope&) = delete;
+    };
+
+    // Whether this build counts allocations at all
+    static bool        isCounting();
+
+    // Called from the counting operator new
+    static void        onAllocation();
+
+    // A pass element went to the render pass (allowed its owning pointer's allocation)
+    static void        onPassElement();
+
+    // render: RENDER_POST, closes the frame's tally
+    static void        onFrame();
+
+    static void        reset();
+
+    // hyprctl liquidglass allocs
+    static std::string getStats(eHyprCtlOutputFormat format);
+};
@@ -0,0 +1,141 @@
+#include "LiquidGlassAnimator.hpp"
+#include "LiquidGlassDecoration.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/desktop/Window.hpp>
+#include <hyprland/src/desktop/Workspace.hpp>
+#include <hyprland/src/managers/SessionLockManager.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopTimer.hpp>
+#include <algorithm>
+
+// ============================================================================
+// INITIALIZATION
+// ============================================================================
+
+void CLiquidGlassAnimator::init() {
+    m_timer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { onTick(); }, nullptr);
+    g_pEventLoopManager->addTimer(m_timer);
+
+    m_lastInput = clock::now();
+    wake();
+}
+
+void CLiquidGlassAnimator::destroy() {
+    if (m_timer)
+        g_pEventLoopManager->removeTimer(m_timer);
+
+    m_timer.reset();
+    m_running = false;
+}
+
+// ============================================================================
+// SCHEDULING
+// ============================================================================
+
+std::chrono::microseconds CLiquidGlassAnimator::interval() const {
+    static auto* const PFPS = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:animate_fps")->getDataStaticPtr();
+
+    return std::chrono::microseconds(1000000 / std::clamp<Hyprlang::INT>(**PFPS, 1, 240));
+}
+
+bool CLiquidGlassAnimator::shouldRun(clock::time_point now) const {
+    static auto* const PENABLED = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:enabled")->getDataStaticPtr();
+    static auto* const PANIMATE = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:animate")->getDataStaticPtr();
+    static auto* const PIDLE    = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:animate_idle_timeout")->getDataStaticPtr();
+
+    if (!**PENABLED || !**PANIMATE || !g_pGlobalState->rim.shader.program)
+        return false;
+
+    if (g_pSessionLockManager && g_pSessionLockManager->isSessionLocked())
+        return false;
+
+    // 0 = never idle out
+    return **PIDLE <= 0 || now - m_lastInput < std::chrono::seconds(**PIDLE);
+}
+
+void CLiquidGlassAnimator::onInput() {
+    m_lastInput = clock::now();
+    wake();
+}
+
+void CLiquidGlassAnimator::wake() {
+    if (m_running || !m_timer || !shouldRun(clock::now()))
+        return;
+
+    m_running  = true;
+    m_lastTick = clock::now();
+    m_timer->updateTimeout(interval());
+}
+
+// Glass that can't be seen this frame
+static bool isOccluded(PHLWINDOW pWindow) {
+    if (!pWindow->m_isMapped || pWindow->isHidden())
+        return true;
+
+    const auto PWORKSPACE = pWindow->m_workspace;
+    if (!PWORKSPACE || !PWORKSPACE->isVisible())
+        return true;
+
+    // Covered by another window's fullscreen
+    if (PWORKSPACE->m_hasFullscreenWindow && !pWindow->isFullscreen() && !pWindow->m_pinned && !pWindow->m_createdOverFullscreen)
+        return true;
+
+    // Buried under opaque tiled or floating windows
+    return g_pGlobalState->occlusion.isCovered(pWindow);
+}
+
+void CLiquidGlassAnimator::onTick() {
+    const auto NOW = clock::now();
+    if (m_running)
+        m_clock += NOW - m_lastTick;
+    m_lastTick = NOW;
+
+    // Paused: the timer is left disarmed until wake()
+    if (!shouldRun(NOW)) {
+        m_running = false;
+        return;
+    }
+
+    bool visible = false;
+    for (auto& deco : g_pGlobalState->decorations) {
+        auto locked = deco.lock();
+        if (!locked)
+            continue;
+
+        const auto OWNER = locked->getOwner();
+        if (!OWNER || isOccluded(OWNER))
+            continue;
+
+        locked->damageEntire();
+        visible = true;
+    }
+
+    if (!visible) {
+        m_running = false;
+        return;
+    }
+
+    // Bridges between merged surfaces aren't part of any window's box
+    g_pGlobalState->merge.damageGroups();
+
+    m_timer->updateTimeout(interval());
+}
+
+// ============================================================================
+// SHADER INPUTS
+// ============================================================================
+
+float CLiquidGlassAnimator::time() const {
+    auto elapsed = m_clock;
+    if (m_running)
+        elapsed += clock::now() - m_lastTick;
+
+    return std::chrono::duration<float>(elapsed).count();
+}
+
+float CLiquidGlassAnimator::shimmer() const {
+    static auto* const PANIMATE = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:animate")->getDataStaticPtr();
+
+    return **PANIMATE ? 1.0f : 0.0f;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+/*
+ * Liquid Glass Animator
+ * Drives the animated glass mode: a timer capped at animate_fps that damages
+ * only the glass surfaces, so the rest of the monitor isn't forced to redraw.
+ * It stops re-arming while input is idle, the session is locked or every
+ * glass surface is occluded (hidden, on an invisible workspace, under a
+ * fullscreen window or under opaque windows above it), and input or
+ * workspace changes wake it again.
+ */
+
+#include <hyprland/src/helpers/memory/Memory.hpp>
+#include <chrono>
+
+class CEventLoopTimer;
+
+class CLiquidGlassAnimator {
+  public:
+    void  init();
+    void  destroy();
+
+    // Input activity: resets the idle timeout
+    void  onInput();
+
+    // Something may have become visible or the config changed
+    void  wake();
+
+    // Animation clock in seconds; only advances while the animator runs, so pausing never jumps the shimmer
+    float time() const;
+
+    // Shimmer intensity for the shaders (0 when the animated mode is off)
+    float shimmer() const;
+
+    bool  isRunning() const {
+        return m_running;
+    }
+
+  private:
+    using clock = std::chrono::steady_clock;
+
+    SP<CEventLoopTimer>       m_timer;
+    bool                      m_running = false;
+    clock::duration           m_clock{};
+    clock::time_point         m_lastTick;
+    clock::time_point         m_lastInput;
+
+    void                      onTick();
+    bool                      shouldRun(clock::time_point now) const;
+    std::chrono::microseconds interval() const;
+};
@@ -0,0 +1,189 @@
+#include "LiquidGlassBufferBudget.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/helpers/Format.hpp>
+#include <algorithm>
+#include <format>
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+size_t CLiquidGlassBufferBudget::bytesFor(int width, int height, uint32_t drmFormat) {
+    const auto* FMT = NFormatUtils::getPixelFormatFromDRM(drmFormat);
+    const size_t BPP = FMT && FMT->bytesPerBlock > 0 ? FMT->bytesPerBlock : 4;
+    return static_cast<size_t>(width) * static_cast<size_t>(height) * BPP;
+}
+
+size_t CLiquidGlassBufferBudget::budgetBytes() const {
+    static auto* const PBUDGET = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:vram_budget_mb")->getDataStaticPtr();
+
+    // 0 = unlimited
+    if (**PBUDGET <= 0)
+        return SIZE_MAX;
+
+    return static_cast<size_t>(**PBUDGET) * 1024 * 1024;
+}
+
+CLiquidGlassBufferBudget::SEntry* CLiquidGlassBufferBudget::find(const void* buffer) {
+    auto it = std::ranges::find_if(m_entries, [buffer](const auto& e) { return e.buffer == buffer; });
+    return it == m_entries.end() ? nullptr : &*it;
+}
+
+void CLiquidGlassBufferBudget::forget(const void* buffer) {
+    auto* entry = find(buffer);
+    if (!entry)
+        return;
+
+    m_usage -= entry->bytes;
+    std::erase_if(m_entries, [buffer](const auto& e) { return e.buffer == buffer; });
+}
+
+void CLiquidGlassBufferBudget::track(const void* buffer, size_t bytes, std::function<void()> evict) {
+    m_entries.emplace_back(SEntry{buffer, bytes, m_frame, std::move(evict)});
+    m_usage += bytes;
+    m_peak = std::max(m_peak, m_usage);
+}
+
+// ============================================================================
+// ALLOCATION
+// ============================================================================
+
+bool CLiquidGlassBufferBudget::ensure(CFramebuffer& fb, int width, int height, uint32_t drmFormat) {
+    if (width <= 0 || height <= 0)
+        return false;
+
+    if (fb.isAllocated() && fb.m_size.x == width && fb.m_size.y == height && fb.m_drmFormat == drmFormat) {
+        touch(&fb);
+        return true;
+    }
+
+    CLiquidGlassTraceScope TRACE(TRACE_ALLOC, "framebuffer", CBox{0, 0, (double)width, (double)height});
+
+    // Drop the old accounting before sizing up the new allocation
+    forget(&fb);
+
+    // Over the ceiling even after evicting everything not drawn this frame: no glass for this surface
+    const size_t BYTES = bytesFor(width, height, drmFormat);
+    if (!makeRoom(BYTES)) {
+        if (fb.isAllocated())
+            fb.release();
+        return false;
+    }
+
+    // Allocation binds behind the GL state cache's back, and may reuse a deleted name it still holds
+    fb.alloc(width, height, drmFormat);
+    g_pGlobalState->glState.invalidate();
+    if (!fb.isAllocated())
+        return false;
+
+    track(&fb, BYTES, [&fb] { fb.release(); });
+    return true;
+}
+
+bool CLiquidGlassBufferBudget::ensure(CLiquidGlassImage& image, int width, int height) {
+    if (width <= 0 || height <= 0)
+        return false;
+
+    if (image.isAllocated() && image.m_size.x == width && image.m_size.y == height) {
+        touch(&image);
+        return true;
+    }
+
+    CLiquidGlassTraceScope TRACE(TRACE_ALLOC, "image", CBox{0, 0, (double)width, (double)height});
+
+    forget(&image);
+
+    // Storage images are always RGBA8
+    const size_t BYTES = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+    if (!makeRoom(BYTES)) {
+        image.release();
+        return false;
+    }
+
+    const bool ALLOCATED = image.alloc(width, height);
+    g_pGlobalState->glState.invalidate();
+    if (!ALLOCATED)
+        return false;
+
+    track(&image, BYTES, [&image] { image.release(); });
+    return true;
+}
+
+void CLiquidGlassBufferBudget::touch(const void* buffer) {
+    if (auto* entry = find(buffer))
+        entry->lastUsed = m_frame;
+}
+
+void CLiquidGlassBufferBudget::release(CFramebuffer& fb) {
+    forget(&fb);
+
+    if (fb.isAllocated())
+        fb.release();
+}
+
+void CLiquidGlassBufferBudget::release(CLiquidGlassImage& image) {
+    forget(&image);
+    image.release();
+}
+
+// ============================================================================
+// EVICTION
+// ============================================================================
+
+bool CLiquidGlassBufferBudget::evictUntil(size_t target) {
+    while (m_usage > target) {
+        // Least-recently-drawn first, but never a buffer drawn this frame
+        auto victim = std::ranges::min_element(m_entries, {}, &SEntry::lastUsed);
+        if (victim == m_entries.end() || victim->lastUsed >= m_frame)
+            return false;
+
+        auto evict = std::move(victim->evict);
+        m_usage -= victim->bytes;
+        m_entries.erase(victim);
+        evict();
+        m_evictions++;
+    }
+
+    return true;
+}
+
+bool CLiquidGlassBufferBudget::makeRoom(size_t bytes) {
+    const size_t BUDGET = budgetBytes();
+    if (BUDGET == SIZE_MAX)
+        return true;
+
+    if (bytes <= BUDGET && evictUntil(BUDGET - bytes))
+        return true;
+
+    m_refused++;
+    return false;
+}
+
+void CLiquidGlassBufferBudget::onFrame() {
+    m_frame++;
+}
+
+void CLiquidGlassBufferBudget::reclaim() {
+    const size_t BUDGET = budgetBytes();
+    if (m_usage > BUDGET)
+        evictUntil(BUDGET);
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+std::string CLiquidGlassBufferBudget::getStats(eHyprCtlOutputFormat format) const {
+    const size_t BUDGET = budgetBytes();
+    const size_t SHOWN  = BUDGET == SIZE_MAX ? 0 : BUDGET;
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
+        return std::format(R"({{"buffers":{},"usageBytes":{},"peakBytes":{},"budgetBytes":{},"evictions":{},"refused":{}}})", m_entries.size(),
+                           m_usage, m_peak, SHOWN, m_evictions, m_refused);
+    }
+
+    return std::format("buffers: {}\nusage: {:.2f} MB\npeak: {:.2f} MB\nbudget: {}\nevictions: {}\nrefused over budget: {}\n", m_entries.size(),
+                       m_usage / (1024.0 * 1024.0), m_peak / (1024.0 * 1024.0), BUDGET == SIZE_MAX ? std::string{"unlimited"} : std::format("{:.2f} MB", SHOWN / (1024.0 * 1024.0)),
+                       m_evictions, m_refused);
+}
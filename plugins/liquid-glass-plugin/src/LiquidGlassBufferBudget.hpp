@@ -0,0 +1,83 @@
+#pragma once
+
+/*
+ * Liquid Glass Buffer Budget
+ * Accounts every glass framebuffer against a single VRAM budget and evicts
+ * the least-recently-drawn buffers when the budget is exceeded. Layer surface
+ * glass (LiquidGlassLayerSurface.cpp, with its s_sampleFramebuffers) isn't
+ * part of the build, so there is nothing of it to account.
+ */
+
+#include "LiquidGlassImage.hpp"
+
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <hyprland/src/SharedDefs.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class CLiquidGlassBufferBudget {
+  public:
+    // Make sure fb is allocated at the given size/format and mark it as drawn this frame.
+    // Allocation may evict other, least-recently-drawn buffers to stay within budget; when
+    // that isn't enough (everything else was drawn this frame) it is refused and fb released.
+    bool        ensure(CFramebuffer& fb, int width, int height, uint32_t drmFormat);
+    bool        ensure(CLiquidGlassImage& image, int width, int height);
+
+    // Mark a tracked buffer as drawn this frame
+    void        touch(const void* buffer);
+
+    // Release a buffer and stop tracking it (call before the owner is destroyed)
+    void        release(CFramebuffer& fb);
+    void        release(CLiquidGlassImage& image);
+
+    // Advance the LRU clock; once per frame, however many monitors draw in it
+    void        onFrame();
+
+    // Enforce the budget (e.g. after a config change); a scheduled task
+    void        reclaim();
+
+    // hyprctl output
+    std::string getStats(eHyprCtlOutputFormat format) const;
+
+    size_t      usage() const {
+        return m_usage;
+    }
+
+    size_t      peak() const {
+        return m_peak;
+    }
+
+    size_t      count() const {
+        return m_entries.size();
+    }
+
+    uint64_t    evictions() const {
+        return m_evictions;
+    }
+
+  private:
+    struct SEntry {
+        const void*           buffer   = nullptr;
+        size_t                bytes    = 0;
+        uint64_t              lastUsed = 0;
+        std::function<void()> evict;
+    };
+
+    std::vector<SEntry> m_entries;
+    size_t              m_usage     = 0;
+    size_t              m_peak      = 0;
+    uint64_t            m_evictions = 0;
+    uint64_t            m_refused   = 0; // Allocations that would have gone over the budget
+    uint64_t            m_frame     = 0;
+
+    size_t              budgetBytes() const;
+    SEntry*             find(const void* buffer);
+    void                forget(const void* buffer);
+    void                track(const void* buffer, size_t bytes, std::function<void()> evict);
+    bool                evictUntil(size_t target);
+    bool                makeRoom(size_t bytes);
+
+    static size_t       bytesFor(int width, int height, uint32_t drmFormat);
+};
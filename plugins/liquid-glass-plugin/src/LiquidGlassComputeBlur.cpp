@@ -0,0 +1,291 @@
+#include "LiquidGlassComputeBlur.hpp"
+#include "globals.hpp"
+
+#include <GLES2/gl2ext.h>
+#include <GLES3/gl32.h>
+#include <drm_fourcc.h>
+#include <hyprland/src/render/OpenGL.hpp>
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <string_view>
+
+// Must match TILE in liquidglass_blur.comp
+constexpr int BLUR_TILE = 128;
+
+// ============================================================================
+// INITIALIZATION
+// ============================================================================
+
+bool CLiquidGlassComputeBlur::probe() {
+    // Compute shaders need GLES 3.1
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    return major > 3 || (major == 3 && minor >= 1);
+}
+
+void CLiquidGlassComputeBlur::setProgram(GLuint prog) {
+    m_program     = prog;
+    m_locSrcTex   = glGetUniformLocation(prog, "srcTex");
+    m_locSize     = glGetUniformLocation(prog, "size");
+    m_locStrength = glGetUniformLocation(prog, "strength");
+}
+
+void CLiquidGlassComputeBlur::destroy() {
+    if (m_program)
+        glDeleteProgram(m_program);
+
+    // A benchmark still in flight is dropped with its queries
+    for (auto& result : m_bench) {
+        for (auto query : result.queries) {
+            if (query)
+                glDeleteQueries(1, &query);
+        }
+        result = {};
+    }
+
+    m_program      = 0;
+    m_benchPending = false;
+}
+
+bool CLiquidGlassComputeBlur::shouldUse(const CBox& box) const {
+    static auto* const PMINAREA = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:compute_blur_min_area")->getDataStaticPtr();
+
+    // 0 = never use the compute path
+    if (!isAvailable() || **PMINAREA <= 0)
+        return false;
+
+    return box.width * box.height >= static_cast<double>(**PMINAREA);
+}
+
+// ============================================================================
+// BLUR
+// ============================================================================
+
+bool CLiquidGlassComputeBlur::blur(CFramebuffer& source, CLiquidGlassImage& out, float strength) {
+    if (!isAvailable() || !source.isAllocated() || !out.isAllocated())
+        return false;
+
+    auto tex = source.getTexture();
+    if (!tex)
+        return false;
+
+    const int W = static_cast<int>(source.m_size.x);
+    const int H = static_cast<int>(source.m_size.y);
+
+    g_pGlobalState->glState.useProgram(m_program);
+    g_pGlobalState->glState.bindTexture(0, tex->m_texID);
+    glUniform1i(m_locSrcTex, 0);
+    glUniform2i(m_locSize, W, H);
+    glUniform1f(m_locStrength, strength);
+
+    glBindImageTexture(0, out.getTexID(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+
+    // One workgroup per TILE-long strip of a diagonal; strips past a short diagonal's end return at once
+    glDispatchCompute((std::min(W, H) + BLUR_TILE - 1) / BLUR_TILE, W + H - 1, 1);
+
+    // Next consumer samples the result as a texture
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    glBindImageTexture(0, 0, 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+    return true;
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+struct SBenchSize {
+    const char* name;
+    int         width;
+    int         height;
+};
+
+constexpr SBenchSize BENCH_SURFACES[] = {
+    {"bar", 1920, 48},
+    {"panel", 800, 1000},
+    {"fullscreen", 3840, 2160},
+};
+static_assert(std::size(BENCH_SURFACES) == CLiquidGlassComputeBlur::BENCH_SIZES);
+
+// Draws per path and size: enough to average out, little enough to stay a short GPU bubble
+constexpr int BENCH_ITERATIONS = 10;
+
+// Draw the interior shader over the whole currently bound framebuffer
+static void drawInterior(int width, int height, GLuint blurredTex) {
+    // Maps the unit quad to the full viewport (column-major)
+    static const float FULLVIEWPORT[9] = {2.f, 0.f, 0.f, 0.f, 2.f, 0.f, -1.f, -1.f, 1.f};
+
+    auto& gl       = g_pGlobalState->glState;
+    auto& interior = g_pGlobalState->interiorShader;
+    gl.useProgram(interior.program);
+
+    interior.setUniformMatrix3fv(SHADER_PROJ, 1, GL_FALSE, FULLVIEWPORT);
+    interior.setUniformInt(SHADER_TEX, 0);
+    interior.setUniformFloat2(SHADER_FULL_SIZE, static_cast<float>(width), static_cast<float>(height));
+    g_pGlobalState->profiles.bind(g_pGlobalState->profiles.defaults());
+    glUniform1f(g_pGlobalState->locInteriorWindowAlpha, 1.0f);
+    glUniform1f(g_pGlobalState->locInteriorLOD, 0.0f);
+    glUniform1f(g_pGlobalState->locInteriorShimmer, 0.0f);
+    glUniform1i(g_pGlobalState->locInteriorBlurTex, 1);
+    glUniform1i(g_pGlobalState->locInteriorPreBlurred, blurredTex ? 1 : 0);
+
+    if (blurredTex)
+        gl.bindTexture(1, blurredTex);
+
+    gl.bindVertexArray(interior.uniformLocations[SHADER_SHADER_VAO]);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
+
+void CLiquidGlassComputeBlur::startBenchmark() {
+    const float STRENGTH = g_pGlobalState->profiles.defaults().params.blurStrength;
+    auto&       gl       = g_pGlobalState->glState;
+
+    // hyprctl runs between frames: put back what the next frame would not set itself
+    GLint viewport[4] = {};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    for (size_t i = 0; i < BENCH_SIZES; ++i) {
+        const auto& SIZE   = BENCH_SURFACES[i];
+        auto&       result = m_bench[i];
+        result.ms          = {-1.0, -1.0};
+
+        // Freed as soon as the draws are queued; the driver keeps them until the GPU is done
+        CFramebuffer      source, target;
+        CLiquidGlassImage out;
+        source.alloc(SIZE.width, SIZE.height, DRM_FORMAT_ABGR8888);
+        target.alloc(SIZE.width, SIZE.height, DRM_FORMAT_ABGR8888);
+        out.alloc(SIZE.width, SIZE.height);
+
+        // Allocation binds behind the cache's back
+        gl.invalidate();
+
+        auto tex = source.getTexture();
+        if (!tex || !target.isAllocated())
+            continue;
+
+        for (const bool COMPUTE : {false, true}) {
+            if (COMPUTE && !isAvailable())
+                continue;
+
+            auto& query = result.queries[COMPUTE];
+            if (!query)
+                glGenQueries(1, &query);
+
+            gl.bindFramebuffer(GL_FRAMEBUFFER, target.getFBID());
+            glViewport(0, 0, SIZE.width, SIZE.height);
+
+            glBeginQuery(GL_TIME_ELAPSED_EXT, query);
+            for (int n = 0; n < BENCH_ITERATIONS; ++n) {
+                if (COMPUTE)
+                    blur(source, out, STRENGTH);
+
+                gl.bindFramebuffer(GL_FRAMEBUFFER, target.getFBID());
+                gl.bindTexture(0, tex->m_texID);
+                drawInterior(SIZE.width, SIZE.height, COMPUTE ? out.getTexID() : 0);
+            }
+            glEndQuery(GL_TIME_ELAPSED_EXT);
+
+            result.pending[COMPUTE] = true;
+        }
+    }
+
+    gl.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    gl.activeTexture(0);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    // Reading the flag clears it: only a disjoint event from here on counts against this run
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    m_benchPending  = true;
+    m_benchDisjoint = false;
+}
+
+void CLiquidGlassComputeBlur::collectBenchmark() {
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    m_benchDisjoint |= disjoint != 0;
+
+    bool pending = false;
+    for (auto& result : m_bench) {
+        for (size_t path = 0; path < result.queries.size(); ++path) {
+            if (!result.pending[path])
+                continue;
+
+            GLuint available = GL_FALSE;
+            glGetQueryObjectuiv(result.queries[path], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available) {
+                pending = true;
+                continue;
+            }
+
+            // 32 bits of nanoseconds hold 4 s of draws
+            GLuint ns = 0;
+            glGetQueryObjectuiv(result.queries[path], GL_QUERY_RESULT, &ns);
+            result.ms[path]      = ns / 1e6 / BENCH_ITERATIONS;
+            result.pending[path] = false;
+        }
+    }
+
+    m_benchPending = pending;
+}
+
+std::string CLiquidGlassComputeBlur::benchmark(const std::string& action, eHyprCtlOutputFormat format) {
+    const bool JSON = format == eHyprCtlOutputFormat::FORMAT_JSON;
+
+    if (!action.empty() && action != "run")
+        return "usage: hyprctl liquidglass bench [run]\n";
+
+    g_pHyprOpenGL->makeEGLCurrent();
+
+    if (!m_timerProbed) {
+        m_timerProbed = true;
+
+        const auto* EXTENSIONS = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+        m_timerQueries         = EXTENSIONS && std::string_view(EXTENSIONS).contains("GL_EXT_disjoint_timer_query");
+    }
+
+    if (!m_timerQueries)
+        return JSON ? R"({"error":"GL_EXT_disjoint_timer_query is unavailable"})" : "blur benchmark unavailable (no GL_EXT_disjoint_timer_query)\n";
+
+    // Never waits on the GPU: results are picked up by a later call once they are in
+    if (m_benchPending)
+        collectBenchmark();
+
+    if (action == "run" && !m_benchPending) {
+        if (!g_pGlobalState->interiorShader.program)
+            return JSON ? R"({"error":"shaders are still compiling"})" : "shaders are still compiling\n";
+
+        startBenchmark();
+    }
+
+    const char* STATE = m_benchPending ? "running" : m_benchDisjoint ? "disjoint" : "done";
+    const auto  MS    = [](double ms) { return ms < 0 ? std::string{"n/a"} : std::format("{:.3f}", ms); };
+
+    if (JSON) {
+        std::string result = std::format(R"({{"state":"{}","sizes":[)", STATE);
+        for (size_t i = 0; i < BENCH_SIZES; ++i) {
+            const auto& SIZE = BENCH_SURFACES[i];
+            result += std::format(R"({}{{"size":"{}","width":{},"height":{},"fragmentMs":{:.3f},"computeMs":{:.3f}}})", i ? "," : "", SIZE.name, SIZE.width,
+                                  SIZE.height, m_bench[i].ms[0], m_bench[i].ms[1]);
+        }
+
+        return result + "]}";
+    }
+
+    if (m_benchPending)
+        return "blur benchmark running, ask again in a moment\n";
+
+    std::string result = std::format("{:<24}{:>14}{:>14}\n", "size (gpu per draw)", "fragment ms", "compute ms");
+    for (size_t i = 0; i < BENCH_SIZES; ++i) {
+        const auto& SIZE = BENCH_SURFACES[i];
+        result += std::format("{:<24}{:>14}{:>14}\n", std::format("{} {}x{}", SIZE.name, SIZE.width, SIZE.height), MS(m_bench[i].ms[0]), MS(m_bench[i].ms[1]));
+    }
+
+    if (m_benchDisjoint)
+        result += "the GPU reported a disjoint event during the run; run it again\n";
+
+    return result;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+/*
+ * Liquid Glass Compute Blur
+ * GLES 3.1 compute path that blurs a sample framebuffer in shared-memory
+ * tiles. Used for large glass surfaces, where the fragment blur re-fetches
+ * every texel many times; everything else keeps the fragment path. Both
+ * compute the same one-dimensional kernel along the diagonal, so a surface
+ * looks the same whichever path it takes.
+ */
+
+#include "LiquidGlassImage.hpp"
+
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <hyprland/src/SharedDefs.hpp>
+#include <hyprutils/math/Box.hpp>
+#include <array>
+#include <string>
+
+class CLiquidGlassComputeBlur {
+  public:
+    // Whether the context supports compute shaders (GLES 3.1)
+    static bool probe();
+
+    // Take ownership of the linked blur program
+    void        setProgram(GLuint prog);
+    void        destroy();
+
+    bool        isAvailable() const {
+        return m_program != 0;
+    }
+
+    // Whether a surface with this (transformed) box should take the compute path
+    bool        shouldUse(const CBox& box) const;
+
+    // Blur source into out, which must match its size. The same kernel as the fragment shaders' fastBlur().
+    bool        blur(CFramebuffer& source, CLiquidGlassImage& out, float strength);
+
+    // hyprctl liquidglass bench [run]: GPU timings of both blur paths at bar, panel and fullscreen sizes.
+    // run queues a new measurement; results are read by later calls, never waited for.
+    std::string benchmark(const std::string& action, eHyprCtlOutputFormat format);
+
+    static constexpr size_t BENCH_SIZES = 3;
+
+  private:
+    struct SBenchResult {
+        std::array<GLuint, 2> queries = {0, 0}; // Fragment, compute
+        std::array<bool, 2>   pending = {false, false};
+        std::array<double, 2> ms      = {-1.0, -1.0}; // GPU time per draw, -1 = not measured
+    };
+
+    GLuint                                 m_program     = 0;
+    GLint                                  m_locSrcTex   = -1;
+    GLint                                  m_locSize     = -1;
+    GLint                                  m_locStrength = -1;
+
+    std::array<SBenchResult, BENCH_SIZES>  m_bench;
+    bool                                   m_benchPending  = false;
+    bool                                   m_benchDisjoint = false;
+    bool                                   m_timerQueries  = false;
+    bool                                   m_timerProbed   = false;
+
+    void                                   startBenchmark();
+    void                                   collectBenchmark();
+};
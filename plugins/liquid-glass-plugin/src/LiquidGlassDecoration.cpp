@@ -1,18 +1,25 @@
 #include "LiquidGlassDecoration.hpp"
+#include "LiquidGlassAllocCounter.hpp"
+#include "LiquidGlassOcclusion.hpp"
 #include "LiquidGlassPassElement.hpp"
+#include "LiquidGlassWindows.hpp"
 #include "globals.hpp"
 
 #include <GLES3/gl32.h>
+#include <drm_fourcc.h>
 #include <hyprland/src/Compositor.hpp>
 #include <hyprland/src/desktop/Window.hpp>
 #include <hyprland/src/render/OpenGL.hpp>
 #include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/helpers/Format.hpp>
 #include <hyprutils/math/Misc.hpp>
 #include <hyprutils/math/Region.hpp>
 #include <hyprutils/math/Vector2D.hpp>
+#include <algorithm>
+#include <array>
 #include <chrono>
-#include <fstream>
-#include <cstdio>
+#include <cmath>
+#include <string_view>
 #include <unordered_map>
 
 // ============================================================================
@@ -23,6 +30,17 @@ CLiquidGlassDecoration::CLiquidGlassDecoration(PHLWINDOW pWindow)
     : IHyprWindowDecoration(pWindow), m_pWindow(pWindow) {
     // Disable Hyprland's built-in blur - we handle it ourselves
     pWindow->m_windowData.noBlur = true;
+
+    // Readback and palette at a staggered phase, so surfaces don't all sample on the same frame
+    m_luminanceTask = g_pGlobalState->scheduler.add("luminance", TASK_PRIORITY_NORMAL, std::chrono::milliseconds(160), std::chrono::milliseconds(500));
+}
+
+CLiquidGlassDecoration::~CLiquidGlassDecoration() {
+    g_pGlobalState->scheduler.remove(m_luminanceTask);
+
+    // Hand our buffers back to the budget before they go away
+    for (auto& [id, state] : m_monitorState)
+        releaseMonitorState(state);
 }
 
 // ============================================================================
@@ -62,6 +80,40 @@ PHLWINDOW CLiquidGlassDecoration::getOwner() {
     return m_pWindow.lock();
 }
 
+// ============================================================================
+// PER-MONITOR STATE
+// ============================================================================
+
+CLiquidGlassDecoration::SMonitorState& CLiquidGlassDecoration::monitorState(PHLMONITOR pMonitor) {
+    return m_monitorState[pMonitor->m_id];
+}
+
+void CLiquidGlassDecoration::releaseMonitorState(SMonitorState& state) {
+    if (!g_pGlobalState)
+        return;
+
+    g_pGlobalState->bufferBudget.release(state.sampleFB);
+    g_pGlobalState->bufferBudget.release(state.blurOut);
+}
+
+void CLiquidGlassDecoration::pruneMonitorState(PHLMONITOR current) {
+    const auto PWINDOW = m_pWindow.lock();
+
+    // Drop buffers for monitors that are gone or no longer show this window
+    std::erase_if(m_monitorState, [&](auto& entry) {
+        auto& [id, state] = entry;
+        if (current && id == current->m_id)
+            return false;
+
+        const auto PMONITOR = g_pCompositor->getMonitorFromID(id);
+        if (PWINDOW && PMONITOR && PWINDOW->visibleOnMonitor(PMONITOR))
+            return false;
+
+        releaseMonitorState(state);
+        return true;
+    });
+}
+
 // ============================================================================
 // DRAWING
 // ============================================================================
@@ -72,64 +124,228 @@ void CLiquidGlassDecoration::draw(PHLMONITOR pMonitor, float const& a) {
     if (!**PENABLED)
         return;
 
-    // Add our pass element to the render pass
+    // Disabled until the shader has finished compiling
+    if (!g_pGlobalState->rim.shader.program)
+        return;
+
+    CLiquidGlassAllocCounter::CScope ALLOCSCOPE;
+
+    const auto             PWINDOW = m_pWindow.lock();
+    CLiquidGlassTraceScope TRACE(TRACE_DRAW, PWINDOW ? PWINDOW->m_title.c_str() : nullptr, PWINDOW ? PWINDOW->getWindowMainSurfaceBox() : CBox{});
+
+    // A window straddling monitors keeps one buffer set per monitor; drop the stale ones
+    if (m_monitorState.size() > 1 || (!m_monitorState.empty() && !m_monitorState.contains(pMonitor->m_id)))
+        pruneMonitorState(pMonitor);
+
+    // Glass outside this frame's damage would only be dropped by the render pass: not queueing it
+    // keeps frames that don't redraw glass free of allocations altogether
+    const auto BOX = CLiquidGlassPassElement::glassBox(this, pMonitor);
+    if (!BOX)
+        return;
+
+    const CBox     PIXELS = BOX->copy().translate(-pMonitor->m_position).scale(pMonitor->m_scale).round();
+    pixman_box32_t rect   = {static_cast<int32_t>(PIXELS.x) - 1, static_cast<int32_t>(PIXELS.y) - 1, static_cast<int32_t>(PIXELS.x + PIXELS.width) + 1,
+                             static_cast<int32_t>(PIXELS.y + PIXELS.height) + 1};
+    if (pixman_region32_contains_rectangle(g_pHyprOpenGL->m_renderData.damage.pixman(), &rect) == PIXMAN_REGION_OUT)
+        return;
+
+    // Add our pass element to the render pass. The element comes from its pool; the control block
+    // of the owning pointer the render pass takes is the one allocation left, and is counted as such.
     CLiquidGlassPassElement::SLiquidGlassData data{this, a};
     g_pHyprRenderer->m_renderPass.add(makeUnique<CLiquidGlassPassElement>(data));
+    CLiquidGlassAllocCounter::onPassElement();
+}
+
+// ============================================================================
+// MOTION LEVEL OF DETAIL
+// ============================================================================
+
+float CLiquidGlassDecoration::updateMotionLOD(PHLWINDOW pWindow) {
+    static auto* const PMOTIONLOD = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:motion_lod")->getDataStaticPtr();
+    static auto* const PFADEMS    = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:motion_lod_fade_ms")->getDataStaticPtr();
+
+    const auto NOW   = std::chrono::steady_clock::now();
+    const auto DELTA = std::chrono::duration<float, std::milli>(NOW - m_lastLODUpdate).count();
+    m_lastLODUpdate  = NOW;
+
+    if (!**PMOTIONLOD) {
+        m_motionLOD = 0.0f;
+        return m_motionLOD;
+    }
+
+    const auto PWORKSPACE = pWindow->m_workspace;
+    const bool MOVING     = (PWORKSPACE && !pWindow->m_pinned && PWORKSPACE->m_renderOffset->isBeingAnimated()) ||
+        pWindow->m_realPosition->isBeingAnimated() || pWindow->m_realSize->isBeingAnimated();
+
+    // Time-based, so a window drawn on several monitors per frame fades at the same rate
+    if (MOVING)
+        m_motionLOD = 1.0f;
+    else if (m_motionLOD > 0.0f)
+        m_motionLOD = **PFADEMS > 0 ? std::max(0.0f, m_motionLOD - DELTA / static_cast<float>(**PFADEMS)) : 0.0f;
+
+    return m_motionLOD;
 }
 
 // ============================================================================
 // BACKGROUND SAMPLING
 // ============================================================================
 
-void CLiquidGlassDecoration::sampleBackground(CFramebuffer& sourceFB, CBox box) {
+// Where part of box lands in a sample of box that is sampleSize pixels
+static CBox sampleRegion(const CBox& box, const CBox& part, const Vector2D& sampleSize) {
+    if (part.empty())
+        return CBox{{}, sampleSize};
+
+    const double SX = sampleSize.x / box.width;
+    const double SY = sampleSize.y / box.height;
+    const double X0 = std::clamp(std::floor((part.x - box.x) * SX), 0.0, sampleSize.x);
+    const double Y0 = std::clamp(std::floor((part.y - box.y) * SY), 0.0, sampleSize.y);
+    const double X1 = std::clamp(std::ceil((part.x + part.width - box.x) * SX), 0.0, sampleSize.x);
+    const double Y1 = std::clamp(std::ceil((part.y + part.height - box.y) * SY), 0.0, sampleSize.y);
+
+    return CBox{X0, Y0, X1 - X0, Y1 - Y0};
+}
+
+bool CLiquidGlassDecoration::sampleBackground(CFramebuffer& sampleFB, CFramebuffer& sourceFB, CBox box, float scale, const CBox& part) {
     // Validate box dimensions
     if (box.width <= 0 || box.height <= 0)
-        return;
-        
-    // Allocate framebuffer if size changed
-    if (m_sampleFB.m_size.x != box.width || m_sampleFB.m_size.y != box.height) {
-        m_sampleFB.alloc(box.width, box.height, sourceFB.m_drmFormat);
-    }
-    
-    if (!m_sampleFB.isAllocated())
-        return;
+        return false;
+
+    const int W = std::max(1, static_cast<int>(std::ceil(box.width * scale)));
+    const int H = std::max(1, static_cast<int>(std::ceil(box.height * scale)));
+
+    // Allocate framebuffer if size or format changed (accounted against the VRAM budget)
+    if (!g_pGlobalState->bufferBudget.ensure(sampleFB, W, H, sampleFormat(sourceFB.m_drmFormat)))
+        return false;
 
     int x0 = static_cast<int>(box.x);
     int x1 = static_cast<int>(box.x + box.width);
     int y0 = static_cast<int>(box.y);
     int y1 = static_cast<int>(box.y + box.height);
 
+    // Only part of the box: copied to where a full copy would put it, the rest keeps older content
+    const CBox DST = sampleRegion(box, part, Vector2D(W, H));
+    if (!part.empty()) {
+        x0 = static_cast<int>(std::round(box.x + DST.x * box.width / W));
+        x1 = static_cast<int>(std::round(box.x + (DST.x + DST.width) * box.width / W));
+        y0 = static_cast<int>(std::round(box.y + DST.y * box.height / H));
+        y1 = static_cast<int>(std::round(box.y + (DST.y + DST.height) * box.height / H));
+    }
+
+    // A copy into fewer bits per channel is drawn, dithered (the pass element restores the bindings)
+    const float DITHER = sampleDitherStep(sourceFB.m_drmFormat, sampleFB.m_drmFormat);
+    if (DITHER > 0.0f && copyDithered(sampleFB, sourceFB, x0, y0, x1, y1, DST, DITHER))
+        return true;
+
     // Blit the background region to our sample framebuffer
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, sourceFB.getFBID());
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_sampleFB.getFBID());
-    glBlitFramebuffer(x0, y0, x1, y1, 0, 0, 
-                      static_cast<int>(box.width), static_cast<int>(box.height),
+    auto& gl = g_pGlobalState->glState;
+    gl.bindFramebuffer(GL_READ_FRAMEBUFFER, sourceFB.getFBID());
+    gl.bindFramebuffer(GL_DRAW_FRAMEBUFFER, sampleFB.getFBID());
+    glBlitFramebuffer(x0, y0, x1, y1, static_cast<int>(DST.x), static_cast<int>(DST.y), static_cast<int>(DST.x + DST.width), static_cast<int>(DST.y + DST.height),
                       GL_COLOR_BUFFER_BIT, GL_LINEAR);
-    
-    // Restore framebuffer state
-    glBindFramebuffer(GL_FRAMEBUFFER, sourceFB.getFBID());
+    return true;
+}
+
+bool CLiquidGlassDecoration::copyDithered(CFramebuffer& sampleFB, CFramebuffer& sourceFB, int x0, int y0, int x1, int y1, const CBox& dst, float ditherStep) {
+    // Maps the unit quad to the full viewport (column-major)
+    static const float FULLVIEWPORT[9] = {2.f, 0.f, 0.f, 0.f, 2.f, 0.f, -1.f, -1.f, 1.f};
+
+    auto&              shader = g_pGlobalState->sampleShader;
+    auto               tex    = sourceFB.getTexture();
+    if (!shader.program || !tex)
+        return false;
+
+    const float SW = static_cast<float>(sourceFB.m_size.x);
+    const float SH = static_cast<float>(sourceFB.m_size.y);
+
+    auto&       gl = g_pGlobalState->glState;
+    gl.bindFramebuffer(GL_FRAMEBUFFER, sampleFB.getFBID());
+    gl.bindTexture(0, tex->m_texID);
+    gl.useProgram(shader.program);
+
+    shader.setUniformMatrix3fv(SHADER_PROJ, 1, GL_FALSE, FULLVIEWPORT);
+    shader.setUniformInt(SHADER_TEX, 0);
+    glUniform4f(g_pGlobalState->locSampleSrcRect, x0 / SW, y0 / SH, (x1 - x0) / SW, (y1 - y0) / SH);
+    glUniform1f(g_pGlobalState->locSampleDitherStep, ditherStep);
+
+    // Same rows as the blit: texture and framebuffer both start at the bottom
+    glViewport(static_cast<int>(dst.x), static_cast<int>(dst.y), static_cast<int>(dst.width), static_cast<int>(dst.height));
+    gl.bindVertexArray(shader.uniformLocations[SHADER_SHADER_VAO]);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    // sourceFB is the monitor's framebuffer, which the viewport Hyprland renders with covers
+    glViewport(0, 0, static_cast<int>(SW), static_cast<int>(SH));
+    return true;
+}
+
+float CLiquidGlassDecoration::motionSampleScale(float lod) {
+    static auto* const PLODSCALE = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:motion_lod_scale")->getDataStaticPtr();
+
+    // Full resolution again as soon as the motion stops; the shader crossfades the rest
+    return lod >= 1.0f ? std::clamp(static_cast<float>(**PLODSCALE), 0.1f, 1.0f) : 1.0f;
+}
+
+// More than 8 bits per channel: 10-bit and half-float outputs
+static bool isWideFormat(uint32_t drmFormat) {
+    const auto* FMT = NFormatUtils::getPixelFormatFromDRM(drmFormat);
+    return FMT && (FMT->bytesPerBlock > 4 || FMT->glType == GL_UNSIGNED_INT_2_10_10_10_REV);
+}
+
+uint32_t CLiquidGlassDecoration::sampleFormat(uint32_t sourceFormat) {
+    static auto* const PFORMAT = (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:sample_format")->getDataStaticPtr();
+    const std::string_view FORMAT = *PFORMAT;
+
+    if (FORMAT == "source")
+        return sourceFormat;
+    if (FORMAT == "8888")
+        return DRM_FORMAT_XBGR8888;
+
+    // auto: 8-bit outputs are sampled in their own format. Wider ones drop to 8 bits per channel:
+    // the sample is blurred and tinted right away, and the copy is dithered. Nothing smaller is
+    // offered: Hyprland's framebuffers allocate 565 as a 4-byte texture, so it would save nothing.
+    return isWideFormat(sourceFormat) ? DRM_FORMAT_XBGR8888 : sourceFormat;
+}
+
+float CLiquidGlassDecoration::sampleDitherStep(uint32_t sourceFormat, uint32_t sampleFormat) {
+    // One step of the 8-bit sample, only where the copy loses precision
+    return isWideFormat(sourceFormat) && !isWideFormat(sampleFormat) ? 1.0f / 255.0f : 0.0f;
 }
 
 // ============================================================================
 // LUMINANCE CALCULATION
 // ============================================================================
 
-// Global luminance data storage
-static std::unordered_map<std::string, float> g_luminanceData;
-static std::unordered_map<std::string, bool> g_isDarkState;  // Track isDark state per region
-static int g_luminanceWriteCounter = 0;
+// Last published adaptive color data per region
+struct SAdaptiveColors {
+    float         luminance = 0.0f;
+    bool          isDark    = true;
+    SGlassPalette palette;
+};
 
-float CLiquidGlassDecoration::calculateLuminance(CBox& box) {
-    // Only calculate every N frames for performance
-    m_luminanceUpdateCounter++;
-    if (m_luminanceUpdateCounter < 10) {
-        return m_lastLuminance;
+// Looked up by string_view every frame without building a key
+struct SRegionHash {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view name) const {
+        return std::hash<std::string_view>{}(name);
     }
-    m_luminanceUpdateCounter = 0;
+};
+
+static std::unordered_map<std::string, SAdaptiveColors, SRegionHash, std::equal_to<>> g_adaptiveColors;
+
+float CLiquidGlassDecoration::calculateLuminance(CFramebuffer& sampleFB, const CBox& region) {
+    // Only when the scheduler has room for it this frame
+    const auto RUN = g_pGlobalState->scheduler.claim(m_luminanceTask);
+    if (!RUN)
+        return m_lastLuminance;
+
+    const auto             PWINDOW = m_pWindow.lock();
+    CLiquidGlassTraceScope TRACE(TRACE_LUMINANCE, PWINDOW ? PWINDOW->m_title.c_str() : nullptr, region);
     
-    // Read pixels from the sample framebuffer
-    int width = static_cast<int>(box.width);
-    int height = static_cast<int>(box.height);
+    // Read pixels from the region of the sample framebuffer behind this window
+    int originX = static_cast<int>(region.x);
+    int originY = static_cast<int>(region.y);
+    int width = static_cast<int>(region.width);
+    int height = static_cast<int>(region.height);
     
     if (width <= 0 || height <= 0) {
         return m_lastLuminance;
@@ -140,19 +356,15 @@ float CLiquidGlassDecoration::calculateLuminance(CBox& box) {
     int stepY = std::max(16, height / 8);
     int sampleCount = 0;
     float totalLuminance = 0.0f;
+    CLiquidGlassPaletteBuilder palette;
     
-    // Allocate buffer for sampled pixels
-    int samplesX = (width + stepX - 1) / stepX;
-    int samplesY = (height + stepY - 1) / stepY;
-    std::vector<unsigned char> pixels(samplesX * samplesY * 4);
-    
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_sampleFB.getFBID());
+    g_pGlobalState->glState.bindFramebuffer(GL_READ_FRAMEBUFFER, sampleFB.getFBID());
     
     // Read sparse samples
     for (int y = 0; y < height; y += stepY) {
         for (int x = 0; x < width; x += stepX) {
             unsigned char pixel[4];
-            glReadPixels(x, y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+            glReadPixels(originX + x, originY + y, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
             
             // Calculate relative luminance (sRGB)
             float r = pixel[0] / 255.0f;
@@ -162,11 +374,15 @@ float CLiquidGlassDecoration::calculateLuminance(CBox& box) {
             
             totalLuminance += luminance;
             sampleCount++;
+
+            // Same samples feed the palette: no extra readbacks
+            palette.add(r, g, b);
         }
     }
     
     if (sampleCount > 0) {
         m_lastLuminance = totalLuminance / sampleCount;
+        m_lastPalette = palette.build();
     }
     
     return m_lastLuminance;
@@ -174,92 +390,108 @@ float CLiquidGlassDecoration::calculateLuminance(CBox& box) {
 
 void CLiquidGlassDecoration::reportLuminance(const std::string& windowTitle, float luminance) {
     // Extract region name from window title (e.g., "molten-glass-notch" -> "notch")
-    std::string region;
-    if (windowTitle.find("molten-glass-") == 0) {
-        region = windowTitle.substr(13); // Skip "molten-glass-"
-    } else {
+    constexpr std::string_view PREFIX = "molten-glass-";
+    if (!windowTitle.starts_with(PREFIX))
         return; // Not a molten glass window
-    }
-    
-    // Store luminance
-    g_luminanceData[region] = luminance;
-    
-    // Write to file periodically (not every frame)
-    g_luminanceWriteCounter++;
-    if (g_luminanceWriteCounter < 15) {
-        return;
-    }
-    g_luminanceWriteCounter = 0;
-    
-    // Build JSON
-    std::string json = "{";
-    bool first = true;
-    for (const auto& [name, lum] : g_luminanceData) {
-        if (!first) json += ",";
-        first = false;
-        
-        // Hysteresis thresholds to prevent rapid toggling on gray backgrounds
-        const float DARK_THRESHOLD = 0.45f;   // Switch to dark mode below this
-        const float LIGHT_THRESHOLD = 0.55f;  // Switch to light mode above this
-        
-        // Get current state (default to true if not yet set)
-        bool currentIsDark = g_isDarkState.count(name) ? g_isDarkState[name] : true;
-        
-        // Apply hysteresis
-        bool isDark;
-        if (currentIsDark && lum > LIGHT_THRESHOLD) {
-            // Currently dark, switch to light only if above upper threshold
-            isDark = false;
-        } else if (!currentIsDark && lum < DARK_THRESHOLD) {
-            // Currently light, switch to dark only if below lower threshold
-            isDark = true;
-        } else {
-            // Stay in current state (hysteresis zone)
-            isDark = currentIsDark;
-        }
-        
-        // Update state
-        g_isDarkState[name] = isDark;
-        
-        json += "\"" + name + "\":{";
-        json += "\"luminance\":" + std::to_string(lum) + ",";
-        json += "\"isDark\":" + std::string(isDark ? "true" : "false") + ",";
-        json += "\"textColor\":\"" + std::string(isDark ? "#ffffff" : "#000000") + "\",";
-        json += "\"iconColor\":\"" + std::string(isDark ? "#ffffff" : "#000000") + "\"";
-        json += "}";
-    }
-    json += "}";
-    
-    // Write atomically
-    std::string tmpPath = "/tmp/molten-adaptive-colors.json.tmp";
-    std::string finalPath = "/tmp/molten-adaptive-colors.json";
+
+    const std::string_view REGION = std::string_view{windowTitle}.substr(PREFIX.size());
     
-    std::ofstream file(tmpPath);
-    if (file.is_open()) {
-        file << json;
-        file.close();
-        std::rename(tmpPath.c_str(), finalPath.c_str());
+    // Hysteresis thresholds to prevent rapid toggling on gray backgrounds
+    const float DARK_THRESHOLD = 0.45f;   // Switch to dark mode below this
+    const float LIGHT_THRESHOLD = 0.55f;  // Switch to light mode above this
+
+    // Get current state (default to dark if not yet published)
+    auto existing = g_adaptiveColors.find(REGION);
+    const bool PUBLISHED = existing != g_adaptiveColors.end();
+    bool currentIsDark = PUBLISHED ? existing->second.isDark : true;
+
+    // Apply hysteresis
+    bool isDark;
+    if (currentIsDark && luminance > LIGHT_THRESHOLD) {
+        // Currently dark, switch to light only if above upper threshold
+        isDark = false;
+    } else if (!currentIsDark && luminance < DARK_THRESHOLD) {
+        // Currently light, switch to dark only if below lower threshold
+        isDark = true;
+    } else {
+        // Stay in current state (hysteresis zone)
+        isDark = currentIsDark;
     }
+
+    // Only publish when the shell would see a difference
+    if (PUBLISHED && isDark == existing->second.isDark && std::abs(luminance - existing->second.luminance) < 0.05f &&
+        !m_lastPalette.differsFrom(existing->second.palette))
+        return;
+
+    if (PUBLISHED)
+        existing->second = {luminance, isDark, m_lastPalette};
+    else
+        g_adaptiveColors.emplace(std::string{REGION}, SAdaptiveColors{luminance, isDark, m_lastPalette});
+
+    CLiquidGlassTraceScope TRACE(TRACE_PUBLISH, windowTitle.c_str());
+
+    // The worker builds the JSON and writes the file, batching a frame's worth of regions
+    g_pGlobalState->io.publishColors(REGION, luminance, isDark, m_lastPalette);
 }
 
 // ============================================================================
 // LIQUID GLASS SHADER APPLICATION
 // ============================================================================
 
-void CLiquidGlassDecoration::applyLiquidGlassEffect(CFramebuffer& sourceFB, CFramebuffer& targetFB,
-                                                      CBox& rawBox, CBox& transformedBox, float windowAlpha) {
+// Background copied beyond what the visible glass covers when opaque content
+// hides the rest: the compute blur's two 16 px halos, more than the fragment blur's taps
+constexpr double SAMPLE_MARGIN = 32.0;
+
+// Part of rawBox the refractive rim never reaches. liquidglass.frag only
+// refracts, disperses and brightens within 1.5 * borderWidth (borderWidth =
+// edgeThickness * 1.5) of the edge, measured in units of the transformed
+// height. Deeper in, a cheap blur-and-tint shader gives identical output.
+static CBox getInteriorBox(const CBox& rawBox, const CBox& transformedBox, float radius, float edgeThickness) {
+    const double H = transformedBox.height;
+    if (H <= 0)
+        return {};
+
+    // Inset needed so the whole inner rect has SDF <= -band, rounded corners included
+    const double BAND   = std::max(edgeThickness * 1.5 * 1.5, 0.002);
+    const double RADIUS = radius / H;
+    const double INSET  = RADIUS > BAND ? std::max(BAND, RADIUS - (RADIUS - BAND) / std::sqrt(2.0)) : BAND;
+
+    // One pixel of slack for rounding
+    const double INSETPX = std::ceil(INSET * H) + 1.0;
+    if (INSETPX * 2.0 >= rawBox.width || INSETPX * 2.0 >= rawBox.height)
+        return {};
+
+    return CBox{rawBox.x + INSETPX, rawBox.y + INSETPX, rawBox.width - INSETPX * 2.0, rawBox.height - INSETPX * 2.0};
+}
+
+bool CLiquidGlassDecoration::computeBlur(SMonitorState& state, CBox& box, const SGlassParams& params) {
+    auto& compute = g_pGlobalState->computeBlur;
+    if (!compute.shouldUse(box) || !state.sampleFB.isAllocated()) {
+        // Small again: give the compute buffers back
+        if (state.blurOut.isAllocated())
+            g_pGlobalState->bufferBudget.release(state.blurOut);
+        return false;
+    }
+
+    const int W = static_cast<int>(state.sampleFB.m_size.x);
+    const int H = static_cast<int>(state.sampleFB.m_size.y);
+
+    const auto             PWINDOW = m_pWindow.lock();
+    CLiquidGlassTraceScope TRACE(TRACE_COMPUTE_BLUR, PWINDOW ? PWINDOW->m_title.c_str() : nullptr, box);
+
+    if (!g_pGlobalState->bufferBudget.ensure(state.blurOut, W, H))
+        return false;
+
+    // The fragment blur's offsets are in pixels of the box; a reduced-resolution sample has fewer
+    return compute.blur(state.sampleFB, state.blurOut, params.blurStrength * W / box.width);
+}
+
+double CLiquidGlassDecoration::applyLiquidGlassEffect(CFramebuffer& sourceFB, CFramebuffer& targetFB,
+                                                        CBox& rawBox, CBox& transformedBox, float windowAlpha, float lod,
+                                                        CLiquidGlassProfiles::SProfile& profile, CLiquidGlassImage* blurred, const CBox& hole) {
     // Validate framebuffers
     if (!sourceFB.isAllocated() || !targetFB.isAllocated())
-        return;
-        
-    // Get config values
-    static auto* const PBLUR       = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:blur_strength")->getDataStaticPtr();
-    static auto* const PREFRACT    = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:refraction_strength")->getDataStaticPtr();
-    static auto* const PCHROMATIC  = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:chromatic_aberration")->getDataStaticPtr();
-    static auto* const PFRESNEL    = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:fresnel_strength")->getDataStaticPtr();
-    static auto* const PSPECULAR   = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:specular_strength")->getDataStaticPtr();
-    static auto* const POPACITY    = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:glass_opacity")->getDataStaticPtr();
-    static auto* const PEDGE       = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:edge_thickness")->getDataStaticPtr();
+        return 0;
 
     // Calculate transformation matrix
     const auto TR = wlTransformToHyprutils(
@@ -270,90 +502,190 @@ void CLiquidGlassDecoration::applyLiquidGlassEffect(CFramebuffer& sourceFB, CFra
     auto tex = sourceFB.getTexture();
     
     if (!tex)
-        return;
+        return 0;
 
     glMatrix.transpose();
+
+    const auto             PWINDOW = m_pWindow.lock();
+    CLiquidGlassTraceScope TRACE(TRACE_SHADER, PWINDOW ? PWINDOW->m_title.c_str() : nullptr, rawBox);
     
     // Bind target framebuffer and source texture
-    glBindFramebuffer(GL_FRAMEBUFFER, targetFB.getFBID());
-    glActiveTexture(GL_TEXTURE0);
-    tex->bind();
+    auto& gl = g_pGlobalState->glState;
+    gl.bindFramebuffer(GL_FRAMEBUFFER, targetFB.getFBID());
+
+    // Pre-blurred background from the compute path goes on unit 1
+    if (blurred)
+        gl.bindTexture(1, blurred->getTexID());
+    gl.bindTexture(0, tex->m_texID);
     
     // Enable blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gl.enableBlend();
+    gl.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
-    // Use our liquid glass shader
-    g_pHyprOpenGL->useProgram(g_pGlobalState->shader.program);
+    // Use our liquid glass shader (in a shader dev A/B run, the candidate on every other frame)
+    auto& rim = g_pGlobalState->shaderDev.rimShader();
+    gl.useProgram(rim.shader.program);
+
+    // Glass parameters come from the window's profile buffer (uploaded only when it changes)
+    g_pGlobalState->profiles.bind(profile);
 
     // Set standard uniforms
-    g_pGlobalState->shader.setUniformMatrix3fv(SHADER_PROJ, 1, GL_FALSE, glMatrix.getMatrix());
-    g_pGlobalState->shader.setUniformInt(SHADER_TEX, 0);
+    rim.shader.setUniformMatrix3fv(SHADER_PROJ, 1, GL_FALSE, glMatrix.getMatrix());
+    rim.shader.setUniformInt(SHADER_TEX, 0);
+    glUniform1i(rim.locBlurTex, 1);
+    glUniform1i(rim.locPreBlurred, blurred ? 1 : 0);
 
     // Set position and size uniforms
     const auto TOPLEFT  = Vector2D(transformedBox.x, transformedBox.y);
     const auto FULLSIZE = Vector2D(transformedBox.width, transformedBox.height);
 
-    g_pGlobalState->shader.setUniformFloat2(SHADER_TOP_LEFT, 
+    rim.shader.setUniformFloat2(SHADER_TOP_LEFT, 
         static_cast<float>(TOPLEFT.x), static_cast<float>(TOPLEFT.y));
-    g_pGlobalState->shader.setUniformFloat2(SHADER_FULL_SIZE, 
+    rim.shader.setUniformFloat2(SHADER_FULL_SIZE, 
         static_cast<float>(FULLSIZE.x), static_cast<float>(FULLSIZE.y));
 
     // Set liquid glass specific uniforms
-    auto now = std::chrono::steady_clock::now();
-    float time = std::chrono::duration<float>(now.time_since_epoch()).count() - g_pGlobalState->startTime;
-    
-    glUniform1f(g_pGlobalState->locTime, time);
-    glUniform1f(g_pGlobalState->locBlurStrength, static_cast<float>(**PBLUR));
-    glUniform1f(g_pGlobalState->locRefractionStrength, static_cast<float>(**PREFRACT));
-    glUniform1f(g_pGlobalState->locChromaticAberration, static_cast<float>(**PCHROMATIC));
-    glUniform1f(g_pGlobalState->locFresnelStrength, static_cast<float>(**PFRESNEL));
-    glUniform1f(g_pGlobalState->locSpecularStrength, static_cast<float>(**PSPECULAR));
-    glUniform1f(g_pGlobalState->locGlassOpacity, static_cast<float>(**POPACITY) * windowAlpha);
-    glUniform1f(g_pGlobalState->locEdgeThickness, static_cast<float>(**PEDGE));
+    const float TIME    = g_pGlobalState->animator.time();
+    const float SHIMMER = g_pGlobalState->animator.shimmer();
+
+    glUniform1f(rim.locTime, TIME);
+    glUniform1f(rim.locShimmer, SHIMMER);
+    glUniform1f(rim.locWindowAlpha, windowAlpha);
+    glUniform1f(rim.locLOD, lod);
     
     // Untransformed size for proper calculations
-    glUniform2f(g_pGlobalState->locFullSizeUntransformed, 
+    glUniform2f(rim.locFullSizeUntransformed, 
         static_cast<float>(rawBox.width), static_cast<float>(rawBox.height));
 
     // Set window corner radius
-    const auto PWINDOW = m_pWindow.lock();
     float cornerRadius = PWINDOW ? PWINDOW->rounding() : 0.0f;
-    g_pGlobalState->shader.setUniformFloat(SHADER_RADIUS, cornerRadius);
+    rim.shader.setUniformFloat(SHADER_RADIUS, cornerRadius);
+
+    // Split the box into the refractive rim and the plain interior (rim shader only until the interior one is ready)
+    const CBox INTERIOR = g_pGlobalState->interiorShader.program ? getInteriorBox(rawBox, transformedBox, cornerRadius, profile.params.edgeThickness) : CBox{};
+
+    // Rim as four bands around the interior (or the whole box without one), built in place instead of through a region
+    std::array<CBox, 4> bands;
+    size_t              rimCount = 0;
+    if (INTERIOR.empty())
+        bands[rimCount++] = rawBox;
+    else {
+        const double RIGHT   = rawBox.x + rawBox.width;
+        const double BOTTOM  = rawBox.y + rawBox.height;
+        const double IRIGHT  = INTERIOR.x + INTERIOR.width;
+        const double IBOTTOM = INTERIOR.y + INTERIOR.height;
+
+        bands[rimCount++] = CBox{rawBox.x, rawBox.y, rawBox.width, INTERIOR.y - rawBox.y};
+        bands[rimCount++] = CBox{rawBox.x, IBOTTOM, rawBox.width, BOTTOM - IBOTTOM};
+        bands[rimCount++] = CBox{rawBox.x, INTERIOR.y, INTERIOR.x - rawBox.x, INTERIOR.height};
+        bands[rimCount++] = CBox{IRIGHT, INTERIOR.y, RIGHT - IRIGHT, INTERIOR.height};
+    }
+
+    // Draw the rim (edge bands plus corners) with the full shader, GPU-timed in shader dev mode,
+    // leaving out whatever opaque content will cover
+    auto&               dev       = g_pGlobalState->shaderDev;
+    double              rimPixels = 0;
+    std::array<CBox, 4> pieces;
+    dev.beginTiming();
+
+    gl.bindVertexArray(rim.shader.uniformLocations[SHADER_SHADER_VAO]);
+    for (size_t i = 0; i < rimCount; ++i) {
+        const size_t COUNT = CLiquidGlassOcclusion::subtract(bands[i], hole, pieces);
+        for (size_t j = 0; j < COUNT; ++j) {
+            g_pHyprOpenGL->scissor(pieces[j]);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            rimPixels += pieces[j].width * pieces[j].height;
+        }
+    }
+
+    dev.endTiming(rimPixels);
+
+    double interiorPixels = 0;
+
+    // Draw the interior with the cheap blur-and-tint shader
+    if (!INTERIOR.empty()) {
+        auto& interior = g_pGlobalState->interiorShader;
+        gl.useProgram(interior.program);
+
+        interior.setUniformMatrix3fv(SHADER_PROJ, 1, GL_FALSE, glMatrix.getMatrix());
+        interior.setUniformInt(SHADER_TEX, 0);
+        interior.setUniformFloat2(SHADER_FULL_SIZE, static_cast<float>(FULLSIZE.x), static_cast<float>(FULLSIZE.y));
+        glUniform1f(g_pGlobalState->locInteriorWindowAlpha, windowAlpha);
+        glUniform1f(g_pGlobalState->locInteriorLOD, lod);
+        glUniform1f(g_pGlobalState->locInteriorTime, TIME);
+        glUniform1f(g_pGlobalState->locInteriorShimmer, SHIMMER);
+        glUniform1i(g_pGlobalState->locInteriorBlurTex, 1);
+        glUniform1i(g_pGlobalState->locInteriorPreBlurred, blurred ? 1 : 0);
+
+        gl.bindVertexArray(interior.uniformLocations[SHADER_SHADER_VAO]);
+        const size_t COUNT = CLiquidGlassOcclusion::subtract(INTERIOR, hole, pieces);
+        for (size_t i = 0; i < COUNT; ++i) {
+            g_pHyprOpenGL->scissor(pieces[i]);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            interiorPixels += pieces[i].width * pieces[i].height;
+        }
+    }
 
-    // Draw
-    glBindVertexArray(g_pGlobalState->shader.uniformLocations[SHADER_SHADER_VAO]);
-    g_pHyprOpenGL->scissor(rawBox);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
     g_pHyprOpenGL->scissor(nullptr);
+    return rimPixels + interiorPixels;
 }
 
 // ============================================================================
 // RENDER PASS
 // ============================================================================
 
-void CLiquidGlassDecoration::renderPass(PHLMONITOR pMonitor, const float& a) {
+CBox CLiquidGlassDecoration::getRenderBox(PHLMONITOR pMonitor) {
     const auto PWINDOW = m_pWindow.lock();
     if (!PWINDOW)
-        return;
+        return {};
 
     const auto PWORKSPACE = PWINDOW->m_workspace;
     const auto WORKSPACEOFFSET = PWORKSPACE && !PWINDOW->m_pinned 
         ? PWORKSPACE->m_renderOffset->value() 
         : Vector2D();
-    
+
+    return PWINDOW->getWindowMainSurfaceBox()
+        .translate(WORKSPACEOFFSET)
+        .translate(-pMonitor->m_position + PWINDOW->m_floatingOffset)
+        .scale(pMonitor->m_scale)
+        .round();
+}
+
+void CLiquidGlassDecoration::renderPass(PHLMONITOR pMonitor, const float& a) {
+    const auto PWINDOW = m_pWindow.lock();
+    if (!PWINDOW)
+        return;
+
     // Get the current framebuffer (what we're rendering to)
     CFramebuffer* TARGET = g_pHyprOpenGL->m_renderData.currentFB;
     if (!TARGET || !TARGET->isAllocated())
         return;
 
-    // Calculate window box
-    auto thisbox = PWINDOW->getWindowMainSurfaceBox();
+    CLiquidGlassTraceScope TRACE(TRACE_RENDER_PASS, PWINDOW->m_title.c_str(), PWINDOW->getWindowMainSurfaceBox());
+
+    // Reduced quality while a workspace slide, move or resize is in flight
+    const float LOD = updateMotionLOD(PWINDOW);
+
+    // Nothing else redraws the window once the animation has settled; keep frames coming until the fade ends
+    if (LOD > 0.0f && LOD < 1.0f)
+        damageEntire();
+
+    // Close to other glass: draw this window's part of the group's merged shape, occluded as it would be alone
+    auto& merge = g_pGlobalState->merge;
+    if (auto* group = merge.groupFor(this, pMonitor)) {
+        auto&        occlusion = g_pGlobalState->occlusion;
+        const CBox   BOX       = getRenderBox(pMonitor);
+        const double SHADED    = merge.render(*group, this, pMonitor, *TARGET, a, LOD, occlusion.opaqueBox(PWINDOW, pMonitor, BOX, a));
+        occlusion.account(BOX.width * BOX.height, SHADED, 0, 0);
+
+        CBox region;
+        if (auto* sample = merge.sampleFor(*group, this, pMonitor, region))
+            reportLuminance(PWINDOW->m_title, calculateLuminance(*sample, region));
+        return;
+    }
 
-    CBox wlrbox = thisbox.translate(WORKSPACEOFFSET)
-                      .translate(-pMonitor->m_position + PWINDOW->m_floatingOffset)
-                      .scale(pMonitor->m_scale)
-                      .round();
+    // Calculate window box
+    CBox wlrbox = getRenderBox(pMonitor);
     CBox transformBox = wlrbox;
 
     // Apply monitor transform
@@ -363,17 +695,67 @@ void CLiquidGlassDecoration::renderPass(PHLMONITOR pMonitor, const float& a) {
         g_pHyprOpenGL->m_renderData.pMonitor->m_transformedSize.x,
         g_pHyprOpenGL->m_renderData.pMonitor->m_transformedSize.y);
 
-    // Sample background from current FB to our own buffer
-    sampleBackground(*TARGET, transformBox);
-    
-    // Calculate and report luminance for adaptive colors
-    float luminance = calculateLuminance(transformBox);
-    if (PWINDOW) {
-        reportLuminance(PWINDOW->m_title, luminance);
+    // Per-window parameter profile
+    auto& profile = g_pGlobalState->profiles.forWindow(PWINDOW);
+
+    // Glass under opaque client content is overwritten unseen: neither sample nor shade it
+    auto&        occlusion    = g_pGlobalState->occlusion;
+    const CBox   HOLE         = occlusion.opaqueBox(PWINDOW, pMonitor, wlrbox, a);
+    const float  SAMPLESCALE  = motionSampleScale(LOD);
+    const double BOXPIXELS    = wlrbox.width * wlrbox.height;
+    const double SAMPLEPIXELS = BOXPIXELS * SAMPLESCALE * SAMPLESCALE;
+
+    if (!HOLE.empty() && HOLE.width * HOLE.height >= BOXPIXELS) {
+        occlusion.account(BOXPIXELS, 0, SAMPLEPIXELS, 0);
+        return;
     }
-    
+
+    // Copy only the background the visible glass can reach: refraction pulls from up to
+    // ~6.5 * refraction_strength of the box inward, the blurs a few pixels further
+    CBox part;
+    if (!HOLE.empty()) {
+        std::array<CBox, 4> pieces;
+        const size_t        COUNT = CLiquidGlassOcclusion::subtract(wlrbox, HOLE, pieces);
+
+        double              x0 = pieces[0].x, y0 = pieces[0].y, x1 = pieces[0].x + pieces[0].width, y1 = pieces[0].y + pieces[0].height;
+        for (size_t i = 1; i < COUNT; ++i) {
+            x0 = std::min(x0, pieces[i].x);
+            y0 = std::min(y0, pieces[i].y);
+            x1 = std::max(x1, pieces[i].x + pieces[i].width);
+            y1 = std::max(y1, pieces[i].y + pieces[i].height);
+        }
+
+        const double REACH = std::min(1.0, profile.params.refractionStrength * 6.5);
+        const double MX    = wlrbox.width * REACH + SAMPLE_MARGIN;
+        const double MY    = wlrbox.height * REACH + SAMPLE_MARGIN;
+
+        part = CBox{x0 - MX, y0 - MY, x1 - x0 + MX * 2.0, y1 - y0 + MY * 2.0}.intersection(wlrbox);
+        if (part.width * part.height >= BOXPIXELS)
+            part = {};
+        else
+            part.transform(TR, g_pHyprOpenGL->m_renderData.pMonitor->m_transformedSize.x, g_pHyprOpenGL->m_renderData.pMonitor->m_transformedSize.y);
+    }
+
+    // Sample background from current FB into this monitor's buffer
+    auto& state = monitorState(pMonitor);
+    {
+        CLiquidGlassTraceScope SAMPLETRACE(TRACE_SAMPLE, PWINDOW->m_title.c_str(), part.empty() ? transformBox : part);
+        sampleBackground(state.sampleFB, *TARGET, transformBox, SAMPLESCALE, part);
+    }
+
+    // Calculate and report luminance for adaptive colors, over the part that was copied
+    const CBox SAMPLED   = sampleRegion(transformBox, part, state.sampleFB.m_size);
+    float      luminance = calculateLuminance(state.sampleFB, SAMPLED);
+    reportLuminance(PWINDOW->m_title, luminance);
+
+    // Large surfaces blur through the tiled compute path
+    const bool PREBLURRED = computeBlur(state, transformBox, profile.params);
+
     // Apply effect: read from our sample buffer, write to target
-    applyLiquidGlassEffect(m_sampleFB, *TARGET, wlrbox, transformBox, a);
+    const double SHADED =
+        applyLiquidGlassEffect(state.sampleFB, *TARGET, wlrbox, transformBox, a, LOD, profile, PREBLURRED ? &state.blurOut : nullptr, HOLE);
+
+    occlusion.account(BOXPIXELS, SHADED, SAMPLEPIXELS, part.empty() ? SAMPLEPIXELS : SAMPLED.width * SAMPLED.height);
 }
 
 // ============================================================================
@@ -381,6 +763,8 @@ void CLiquidGlassDecoration::renderPass(PHLMONITOR pMonitor, const float& a) {
 // ============================================================================
 
 void CLiquidGlassDecoration::updateWindow(PHLWINDOW pWindow) {
+    // The window moved or resized; it may have left a monitor
+    pruneMonitorState();
     damageEntire();
 }
 
@@ -389,12 +773,5 @@ void CLiquidGlassDecoration::damageEntire() {
     if (!PWINDOW)
         return;
 
-    const auto PWINDOWWORKSPACE = PWINDOW->m_workspace;
-    auto surfaceBox = PWINDOW->getWindowMainSurfaceBox();
-
-    if (PWINDOWWORKSPACE && PWINDOWWORKSPACE->m_renderOffset->isBeingAnimated() && !PWINDOW->m_pinned)
-        surfaceBox.translate(PWINDOWWORKSPACE->m_renderOffset->value());
-    surfaceBox.translate(PWINDOW->m_floatingOffset);
-
-    g_pHyprRenderer->damageBox(surfaceBox);
+    g_pHyprRenderer->damageBox(CLiquidGlassWindows::glassBox(PWINDOW));
 }
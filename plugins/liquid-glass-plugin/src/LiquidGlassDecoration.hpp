@@ -5,14 +5,23 @@
  * Applies the liquid glass effect to individual windows
  */
 
+#include "LiquidGlassImage.hpp"
+#include "LiquidGlassPalette.hpp"
+#include "LiquidGlassProfiles.hpp"
+#include "LiquidGlassScheduler.hpp"
+
 #include <hyprland/src/render/decorations/IHyprWindowDecoration.hpp>
 #include <hyprland/src/render/Framebuffer.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <chrono>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 
 class CLiquidGlassDecoration : public IHyprWindowDecoration {
   public:
     CLiquidGlassDecoration(PHLWINDOW pWindow);
-    virtual ~CLiquidGlassDecoration() = default;
+    virtual ~CLiquidGlassDecoration();
 
     // IHyprWindowDecoration interface
     virtual SDecorationPositioningInfo getPositioningInfo();
@@ -29,28 +38,69 @@ class CLiquidGlassDecoration : public IHyprWindowDecoration {
     PHLWINDOW                          getOwner();
     void                               renderPass(PHLMONITOR pMonitor, const float& a);
 
+    // Window box in pMonitor's local render coordinates (before the monitor transform)
+    CBox                               getRenderBox(PHLMONITOR pMonitor);
+
+    // Blit box of sourceFB into sampleFB, scaled by scale (accounted against the VRAM budget).
+    // With part set, only that part of box is copied, to where a full copy would put it.
+    static bool                        sampleBackground(CFramebuffer& sampleFB, CFramebuffer& sourceFB, CBox box, float scale, const CBox& part = {});
+
+    // Background sample scale for a motion LOD
+    static float                       motionSampleScale(float lod);
+
+    // Intermediate format for samples of a sourceFormat framebuffer (plugin:liquid-glass:sample_format)
+    static uint32_t                    sampleFormat(uint32_t sourceFormat);
+
+    // Ordered dither amplitude for copying a sourceFormat framebuffer into a sampleFormat sample (0 = none)
+    static float                       sampleDitherStep(uint32_t sourceFormat, uint32_t sampleFormat);
+
     // Weak pointer to self for tracking
     WP<CLiquidGlassDecoration>         m_self;
 
   private:
-    PHLWINDOWREF m_pWindow;
-    CFramebuffer m_sampleFB;
-    CFramebuffer m_workFB;
-    
-    // Luminance tracking
-    float        m_lastLuminance = 0.5f;
-    int          m_luminanceUpdateCounter = 0;
+    // GPU state for one monitor the window is shown on, sized to that monitor's scale/transform
+    struct SMonitorState {
+        CFramebuffer      sampleFB;
 
-    // Sample the background behind the window
-    void sampleBackground(CFramebuffer& sourceFB, CBox box);
+        // Compute blur path (large surfaces only)
+        CLiquidGlassImage blurOut;
+    };
+
+    PHLWINDOWREF                                 m_pWindow;
+    std::unordered_map<MONITORID, SMonitorState> m_monitorState;
     
-    // Calculate and report background luminance
-    float calculateLuminance(CBox& box);
+    // Luminance and palette tracking, refreshed when the scheduler admits the task
+    float                         m_lastLuminance = 0.5f;
+    SGlassPalette                 m_lastPalette;
+    CLiquidGlassScheduler::TaskID m_luminanceTask = CLiquidGlassScheduler::INVALID_TASK;
+
+    // Motion level of detail: 1 while animating, fades to 0 once settled
+    float                                 m_motionLOD = 0.0f;
+    std::chrono::steady_clock::time_point m_lastLODUpdate;
+
+    // Per-monitor state, released once the window leaves a monitor
+    SMonitorState& monitorState(PHLMONITOR pMonitor);
+    void           pruneMonitorState(PHLMONITOR current = nullptr);
+    void           releaseMonitorState(SMonitorState& state);
+
+    // Advance the motion LOD for this frame
+    float updateMotionLOD(PHLWINDOW pWindow);
+
+    // sampleBackground's copy through the dithering sample shader; false while it isn't ready
+    static bool copyDithered(CFramebuffer& sampleFB, CFramebuffer& sourceFB, int x0, int y0, int x1, int y1, const CBox& dst, float ditherStep);
+
+    // Calculate (along with the palette) and report background luminance (region in sampleFB pixels)
+    float calculateLuminance(CFramebuffer& sampleFB, const CBox& region);
     void  reportLuminance(const std::string& windowTitle, float luminance);
     
-    // Apply the liquid glass shader
-    void applyLiquidGlassEffect(CFramebuffer& sourceFB, CFramebuffer& targetFB,
-                                 CBox& rawBox, CBox& transformedBox, float windowAlpha);
+    // Blur the sample through the compute path if the surface is large enough
+    bool computeBlur(SMonitorState& state, CBox& box, const SGlassParams& params);
+
+    // Apply the liquid glass shader (blurred = compute-blurred sample, or nullptr for the fragment blur)
+    // everywhere in rawBox but hole, returning the pixels shaded
+    double applyLiquidGlassEffect(CFramebuffer& sourceFB, CFramebuffer& targetFB,
+                                   CBox& rawBox, CBox& transformedBox, float windowAlpha, float lod,
+                                   CLiquidGlassProfiles::SProfile& profile, CLiquidGlassImage* blurred, const CBox& hole = {});
 
     friend class CLiquidGlassPassElement;
 };
@@ -0,0 +1,19 @@
+#include "LiquidGlassFrameClock.hpp"
+
+#include <algorithm>
+
+bool CLiquidGlassFrameClock::onPreRender(const PHLMONITOR& monitor) {
+    if (!monitor)
+        return false;
+
+    // Another monitor catching up on this frame
+    if (!m_drawn.empty() && std::ranges::find(m_drawn, monitor->m_id) == m_drawn.end()) {
+        m_drawn.push_back(monitor->m_id);
+        return false;
+    }
+
+    m_drawn.clear();
+    m_drawn.push_back(monitor->m_id);
+    ++m_frame;
+    return true;
+}
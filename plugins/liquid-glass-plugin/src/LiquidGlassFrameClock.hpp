@@ -0,0 +1,32 @@
+#pragma once
+
+/*
+ * Liquid Glass Frame Clock
+ * Hyprland renders each monitor on its own, and preRender fires once per
+ * monitor. This counts frames instead: one starts when a monitor that has
+ * already drawn since the last one draws again, so every monitor's pass
+ * belongs to the same frame number however many there are.
+ */
+
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <cstdint>
+#include <vector>
+
+class CLiquidGlassFrameClock {
+  public:
+    // preRender; true when it started a new frame
+    bool     onPreRender(const PHLMONITOR& monitor);
+
+    uint64_t frame() const {
+        return m_frame;
+    }
+
+    // The monitor rendering now (the last to reach preRender)
+    MONITORID monitor() const {
+        return m_drawn.empty() ? 0 : m_drawn.back();
+    }
+
+  private:
+    uint64_t               m_frame = 0;
+    std::vector<MONITORID> m_drawn; // Monitors that drew in this frame
+};
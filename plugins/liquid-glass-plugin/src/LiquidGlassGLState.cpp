@@ -0,0 +1,142 @@
+#include "LiquidGlassGLState.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/render/OpenGL.hpp>
+#include <algorithm>
+#include <format>
+
+// ============================================================================
+// CACHE
+// ============================================================================
+
+bool CLiquidGlassGLState::change(GLuint& cached, GLuint value) {
+    if (cached == value) {
+        ++m_skipped;
+        return false;
+    }
+
+    cached = value;
+    ++m_changes;
+    return true;
+}
+
+void CLiquidGlassGLState::invalidate() {
+    m_readFB = m_drawFB = m_activeUnit = UNKNOWN;
+    m_textures.fill(UNKNOWN);
+    m_program = m_vao = m_blend = UNKNOWN;
+    m_blendSrc = m_blendDst = UNKNOWN;
+    m_uniformBuffer = m_paramsBuffer = m_paramsIndex = UNKNOWN;
+}
+
+void CLiquidGlassGLState::restore(CFramebuffer* current) {
+    if (current)
+        bindFramebuffer(GL_FRAMEBUFFER, current->getFBID());
+
+    activeTexture(0);
+
+    // Hyprland blends premultiplied everywhere and doesn't reset the function per draw
+    if (m_blendSrc != UNKNOWN)
+        blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+}
+
+// ============================================================================
+// BINDINGS
+// ============================================================================
+
+void CLiquidGlassGLState::bindFramebuffer(GLenum target, GLuint fb) {
+    if (target == GL_FRAMEBUFFER) {
+        if (m_readFB == fb && m_drawFB == fb) {
+            ++m_skipped;
+            return;
+        }
+
+        m_readFB = m_drawFB = fb;
+        ++m_changes;
+        glBindFramebuffer(GL_FRAMEBUFFER, fb);
+        return;
+    }
+
+    if (change(target == GL_READ_FRAMEBUFFER ? m_readFB : m_drawFB, fb))
+        glBindFramebuffer(target, fb);
+}
+
+void CLiquidGlassGLState::activeTexture(GLuint unit) {
+    if (change(m_activeUnit, unit))
+        glActiveTexture(GL_TEXTURE0 + unit);
+}
+
+void CLiquidGlassGLState::bindTexture(GLuint unit, GLuint tex) {
+    if (m_textures[unit] == tex) {
+        ++m_skipped;
+        return;
+    }
+
+    activeTexture(unit);
+    if (change(m_textures[unit], tex))
+        glBindTexture(GL_TEXTURE_2D, tex);
+}
+
+void CLiquidGlassGLState::useProgram(GLuint prog) {
+    if (change(m_program, prog))
+        g_pHyprOpenGL->useProgram(prog);
+}
+
+void CLiquidGlassGLState::bindVertexArray(GLuint vao) {
+    if (change(m_vao, vao))
+        glBindVertexArray(vao);
+}
+
+void CLiquidGlassGLState::enableBlend() {
+    if (change(m_blend, 1))
+        glEnable(GL_BLEND);
+}
+
+void CLiquidGlassGLState::blendFunc(GLenum src, GLenum dst) {
+    if (m_blendSrc == src && m_blendDst == dst) {
+        ++m_skipped;
+        return;
+    }
+
+    m_blendSrc = src;
+    m_blendDst = dst;
+    ++m_changes;
+    glBlendFunc(src, dst);
+}
+
+void CLiquidGlassGLState::bindUniformBuffer(GLuint buffer) {
+    if (change(m_uniformBuffer, buffer))
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+}
+
+void CLiquidGlassGLState::bindUniformBufferBase(GLuint index, GLuint buffer) {
+    // Binding a range also replaces the generic GL_UNIFORM_BUFFER binding
+    if (m_paramsIndex == index && m_paramsBuffer == buffer) {
+        ++m_skipped;
+        return;
+    }
+
+    m_paramsIndex   = index;
+    m_paramsBuffer  = buffer;
+    m_uniformBuffer = buffer;
+    ++m_changes;
+    glBindBufferBase(GL_UNIFORM_BUFFER, index, buffer);
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+void CLiquidGlassGLState::onFrame() {
+    m_lastChanges = m_changes;
+    m_lastSkipped = m_skipped;
+    m_peakChanges = std::max(m_peakChanges, m_changes);
+    m_changes = m_skipped = 0;
+}
+
+std::string CLiquidGlassGLState::getStats(eHyprCtlOutputFormat format) const {
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        return std::format(R"({{"glStateChanges":{},"glStateSkipped":{},"glStatePeakChanges":{}}})", m_lastChanges, m_lastSkipped, m_peakChanges);
+
+    return std::format("gl state changes (last frame): {}\ngl state changes skipped: {}\ngl state changes (peak frame): {}\n", m_lastChanges, m_lastSkipped,
+                       m_peakChanges);
+}
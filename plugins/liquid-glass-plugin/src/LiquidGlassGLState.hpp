@@ -0,0 +1,87 @@
+#pragma once
+
+/*
+ * Liquid Glass GL State Cache
+ * Tracks the GL bindings the plugin changes (framebuffers, texture units,
+ * program, VAO, blend function, uniform buffers) and skips redundant calls.
+ * Hyprland changes the same state between our draws, so each plugin GL
+ * section starts with invalidate() and ends with restore(); the driver is
+ * never queried for what is bound.
+ */
+
+#include <GLES3/gl32.h>
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <hyprland/src/SharedDefs.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+
+class CLiquidGlassGLState {
+  public:
+    // Forget everything: the next call of each kind always reaches GL
+    void        invalidate();
+
+    // Leave what Hyprland's renderer expects: current bound for reading and drawing, unit 0 active,
+    // premultiplied blending
+    void        restore(CFramebuffer* current);
+
+    // GL_FRAMEBUFFER binds both read and draw
+    void        bindFramebuffer(GLenum target, GLuint fb);
+
+    // 2D texture on a unit (index below MAX_UNITS, not GL_TEXTURE0 + unit); leaves that unit active
+    void        bindTexture(GLuint unit, GLuint tex);
+    void        activeTexture(GLuint unit);
+
+    // Through Hyprland, whose own program cache must stay in sync
+    void        useProgram(GLuint prog);
+    void        bindVertexArray(GLuint vao);
+    void        enableBlend();
+    void        blendFunc(GLenum src, GLenum dst);
+
+    // GL_UNIFORM_BUFFER only
+    void        bindUniformBuffer(GLuint buffer);
+    void        bindUniformBufferBase(GLuint index, GLuint buffer);
+
+    // render: RENDER_POST, closes the frame's counters
+    void        onFrame();
+
+    // hyprctl liquidglass stats
+    std::string getStats(eHyprCtlOutputFormat format) const;
+
+    // Last frame's state changes issued and skipped as redundant
+    uint64_t    lastChanges() const {
+        return m_lastChanges;
+    }
+
+    uint64_t    lastSkipped() const {
+        return m_lastSkipped;
+    }
+
+    static constexpr size_t MAX_UNITS = 4;
+
+  private:
+    static constexpr GLuint UNKNOWN = UINT32_MAX;
+
+    GLuint                        m_readFB        = UNKNOWN;
+    GLuint                        m_drawFB        = UNKNOWN;
+    GLuint                        m_activeUnit    = UNKNOWN;
+    std::array<GLuint, MAX_UNITS> m_textures      = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
+    GLuint                        m_program       = UNKNOWN;
+    GLuint                        m_vao           = UNKNOWN;
+    GLuint                        m_blend         = UNKNOWN; // 1 once enabled
+    GLenum                        m_blendSrc      = UNKNOWN;
+    GLenum                        m_blendDst      = UNKNOWN;
+    GLuint                        m_uniformBuffer = UNKNOWN;
+    GLuint                        m_paramsBuffer  = UNKNOWN; // Bound at the GlassParams binding point
+    GLuint                        m_paramsIndex   = UNKNOWN;
+
+    // State changes issued / skipped as redundant, this frame and last
+    uint64_t                      m_changes     = 0;
+    uint64_t                      m_skipped     = 0;
+    uint64_t                      m_lastChanges = 0;
+    uint64_t                      m_lastSkipped = 0;
+    uint64_t                      m_peakChanges = 0;
+
+    // Compare-and-set: true (and counted) when the call has to reach GL
+    bool                          change(GLuint& cached, GLuint value);
+};
@@ -0,0 +1,443 @@
+#include "LiquidGlassIOWorker.hpp"
+#include "LiquidGlassJSON.hpp"
+#include "LiquidGlassTrace.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <wayland-server-core.h>
+
+// Files the shell and tools read
+constexpr const char* COLORS_PATH = "/tmp/molten-adaptive-colors.json";
+constexpr const char* LOG_PATH    = "/tmp/liquid-glass.log";
+
+// After the first record of a burst, how long to let the rest arrive before writing
+constexpr auto COALESCE_WINDOW = std::chrono::milliseconds(8);
+
+// Written aside and renamed, so readers never see half a file
+static bool writeAtomically(const std::string& path, const std::string& contents) {
+    const std::string TMPPATH = path + ".tmp";
+
+    std::ofstream     file(TMPPATH, std::ios::binary);
+    if (!file.is_open())
+        return false;
+
+    file << contents;
+    file.close();
+    return std::rename(TMPPATH.c_str(), path.c_str()) == 0;
+}
+
+// ============================================================================
+// LIFETIME
+// ============================================================================
+
+CLiquidGlassIOWorker::~CLiquidGlassIOWorker() {
+    stop();
+}
+
+void CLiquidGlassIOWorker::start() {
+    // Read results wake the compositor's event loop; without the eventfd reads report failure at once
+    m_eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_eventFd >= 0)
+        m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_eventFd, WL_EVENT_READABLE, onReadResults, this);
+
+    // No more results than slots can be pending, so handing them over never allocates
+    m_results.reserve(FILE_SLOTS);
+    m_delivering.reserve(FILE_SLOTS);
+
+    m_thread = std::thread([this]() { run(); });
+}
+
+void CLiquidGlassIOWorker::stop() {
+    if (!m_thread.joinable())
+        return;
+
+    // The stop record must get through: wait for room instead of dropping it
+    SRecord* record = nullptr;
+    while (!(record = claim(IO_STOP, {})))
+        std::this_thread::yield();
+
+    commit();
+    m_thread.join();
+
+    // Reads still in flight never complete: whoever asked is going away too
+    if (m_eventSource)
+        wl_event_source_remove(m_eventSource);
+    if (m_eventFd >= 0)
+        close(m_eventFd);
+
+    m_eventSource = nullptr;
+    m_eventFd     = -1;
+    m_results.clear();
+
+    for (auto& file : m_files) {
+        file.data.clear();
+        file.done = nullptr;
+        file.busy.store(false, std::memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// PRODUCER
+// ============================================================================
+
+CLiquidGlassIOWorker::SRecord* CLiquidGlassIOWorker::claim(eRecord type, std::string_view text) {
+    const uint32_t TAIL = m_tail.load(std::memory_order_relaxed);
+
+    if (TAIL - m_head.load(std::memory_order_acquire) >= CAPACITY) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    auto& record  = m_ring[TAIL % CAPACITY];
+    record.type   = type;
+    record.length = static_cast<uint16_t>(std::min(text.size(), TEXT_MAX));
+    std::memcpy(record.text, text.data(), record.length);
+
+    m_claimed = TAIL;
+    return &record;
+}
+
+CLiquidGlassIOWorker::SFileSlot* CLiquidGlassIOWorker::claimFile(SRecord& record, std::string_view path) {
+    // Cutting a path would name another file
+    if (path.size() >= PATH_MAX)
+        return nullptr;
+
+    for (size_t i = 0; i < FILE_SLOTS; ++i) {
+        auto& file = m_files[i];
+        if (file.busy.load(std::memory_order_acquire))
+            continue;
+
+        // The worker sees it through the release in commit()
+        file.busy.store(true, std::memory_order_relaxed);
+        std::memcpy(file.path, path.data(), path.size());
+        file.path[path.size()] = '\0';
+
+        record.file = static_cast<uint8_t>(i);
+        return &file;
+    }
+
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void CLiquidGlassIOWorker::commit() {
+    m_tail.store(m_claimed + 1, std::memory_order_release);
+    m_tail.notify_one();
+}
+
+bool CLiquidGlassIOWorker::publishColors(std::string_view region, float luminance, bool isDark, const SGlassPalette& palette) {
+    auto* record = claim(IO_COLORS, region);
+    if (!record)
+        return false;
+
+    record->luminance = luminance;
+    record->isDark    = isDark;
+    record->palette   = palette;
+    commit();
+    return true;
+}
+
+bool CLiquidGlassIOWorker::log(std::string_view line) {
+    if (!claim(IO_LOG, line))
+        return false;
+
+    commit();
+    return true;
+}
+
+bool CLiquidGlassIOWorker::writeStats(const SIOStats& stats, std::string_view path) {
+    auto* record = claim(IO_STATS, path);
+    if (!record)
+        return false;
+
+    record->stats = stats;
+    commit();
+    return true;
+}
+
+bool CLiquidGlassIOWorker::dumpTrace(const CLiquidGlassTrace& trace, std::string_view path) {
+    auto* record = claim(IO_TRACE, path);
+    if (!record)
+        return false;
+
+    record->trace = &trace;
+    commit();
+    return true;
+}
+
+bool CLiquidGlassIOWorker::readFile(std::string_view path, FReadDone done) {
+    if (!m_eventSource)
+        return false;
+
+    // A record claimed without a file slot is never committed, so it just stays free
+    auto* record = claim(IO_READ, {});
+    auto* file   = record ? claimFile(*record, path) : nullptr;
+    if (!file)
+        return false;
+
+    file->done = std::move(done);
+    commit();
+    return true;
+}
+
+bool CLiquidGlassIOWorker::writeFile(std::string_view path, std::string contents) {
+    auto* record = claim(IO_WRITE, {});
+    auto* file   = record ? claimFile(*record, path) : nullptr;
+    if (!file)
+        return false;
+
+    file->data = std::move(contents);
+    commit();
+    return true;
+}
+
+bool CLiquidGlassIOWorker::removeFile(std::string_view path) {
+    auto* record = claim(IO_REMOVE, {});
+    if (!record || !claimFile(*record, path))
+        return false;
+
+    commit();
+    return true;
+}
+
+int CLiquidGlassIOWorker::onReadResults(int fd, uint32_t mask, void* data) {
+    uint64_t count = 0;
+    while (read(fd, &count, sizeof(count)) > 0)
+        ;
+
+    static_cast<CLiquidGlassIOWorker*>(data)->deliverResults();
+    return 0;
+}
+
+void CLiquidGlassIOWorker::deliverResults() {
+    {
+        std::lock_guard lock(m_resultsMutex);
+        m_delivering.swap(m_results);
+    }
+
+    for (const uint8_t INDEX : m_delivering) {
+        auto&                      file = m_files[INDEX];
+        std::optional<std::string> contents;
+        if (file.found)
+            contents.emplace(std::move(file.data));
+
+        // The slot is free again before the callback, which may queue further reads
+        auto done = std::move(file.done);
+        file.data.clear();
+        file.done = nullptr;
+        file.busy.store(false, std::memory_order_release);
+
+        if (done)
+            done(std::move(contents));
+    }
+
+    m_delivering.clear();
+}
+
+// ============================================================================
+// WORKER
+// ============================================================================
+
+void CLiquidGlassIOWorker::run() {
+    while (true) {
+        m_tail.wait(m_head.load(std::memory_order_relaxed), std::memory_order_acquire);
+
+        bool stopping = drain();
+
+        // A burst (several regions publishing in one frame) becomes one write
+        if (!stopping && m_colorsDirty) {
+            std::this_thread::sleep_for(COALESCE_WINDOW);
+            stopping = drain();
+        }
+
+        flush();
+        if (stopping)
+            return;
+    }
+}
+
+bool CLiquidGlassIOWorker::drain() {
+    const uint32_t TAIL = m_tail.load(std::memory_order_acquire);
+    uint32_t       head = m_head.load(std::memory_order_relaxed);
+    bool           stop = false;
+
+    for (; head != TAIL; ++head) {
+        auto& record = m_ring[head % CAPACITY];
+        if (record.type == IO_STOP)
+            stop = true;
+        else
+            apply(record);
+    }
+
+    // Slots are only handed back once read
+    m_head.store(head, std::memory_order_release);
+    return stop;
+}
+
+void CLiquidGlassIOWorker::apply(SRecord& record) {
+    const std::string_view TEXT{record.text, record.length};
+
+    switch (record.type) {
+        case IO_COLORS: {
+            // Later records for a region replace earlier ones: only the newest is written
+            auto it = m_colors.find(std::string{TEXT});
+            if (it == m_colors.end())
+                it = m_colors.emplace(std::string{TEXT}, SColors{}).first;
+
+            it->second    = {record.luminance, record.isDark, record.palette};
+            m_colorsDirty = true;
+            break;
+        }
+
+        case IO_LOG: {
+            if (TEXT == m_lastLine) {
+                ++m_repeats;
+                break;
+            }
+
+            flushRepeats();
+            m_lastLine = TEXT;
+            m_logBuffer.append(TEXT).push_back('\n');
+            break;
+        }
+
+        case IO_STATS: {
+            m_stats      = record.stats;
+            m_statsPath  = TEXT;
+            m_statsDirty = true;
+            break;
+        }
+
+        case IO_TRACE: {
+            // Rare, and the recorder is safe to read while it records
+            if (record.trace && writeAtomically(std::string{TEXT}, record.trace->dump()))
+                m_writes.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+
+        case IO_READ: {
+            // The slot stays taken until the compositor thread has delivered the contents
+            auto&         file = m_files[record.file];
+            std::ifstream in(file.path, std::ios::binary);
+            file.found = in.is_open();
+            if (file.found)
+                file.data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+            {
+                std::lock_guard lock(m_resultsMutex);
+                m_results.push_back(record.file);
+            }
+
+            const uint64_t ONE = 1;
+            write(m_eventFd, &ONE, sizeof(ONE));
+            break;
+        }
+
+        case IO_WRITE: {
+            // Moved out so the file slot doesn't hold on to a large buffer
+            auto&             file = m_files[record.file];
+            const std::string DATA = std::exchange(file.data, {});
+
+            std::error_code   ec;
+            std::filesystem::create_directories(std::filesystem::path(file.path).parent_path(), ec);
+            if (!ec && writeAtomically(file.path, DATA))
+                m_writes.fetch_add(1, std::memory_order_relaxed);
+
+            file.busy.store(false, std::memory_order_release);
+            break;
+        }
+
+        case IO_REMOVE: {
+            auto& file = m_files[record.file];
+            std::remove(file.path);
+            file.busy.store(false, std::memory_order_release);
+            break;
+        }
+
+        case IO_STOP: break;
+    }
+}
+
+void CLiquidGlassIOWorker::flushRepeats() {
+    if (m_repeats)
+        m_logBuffer += std::format("last message repeated {} times\n", m_repeats);
+
+    m_repeats = 0;
+}
+
+void CLiquidGlassIOWorker::flush() {
+    if (m_colorsDirty) {
+        m_colorsDirty = false;
+
+        auto& json = m_colorsJSON;
+        json.clear();
+
+        auto out = std::back_inserter(json);
+        *out++   = '{';
+        bool first = true;
+        for (const auto& [name, colors] : m_colors) {
+            if (!first)
+                *out++ = ',';
+            first = false;
+
+            const auto& PALETTE = colors.palette;
+            const char* TEXT    = colors.isDark ? "#ffffff" : "#000000";
+
+            out = std::format_to(out, R"("{}":{{"luminance":{:.6f},"isDark":{},"textColor":"{}","iconColor":"{}",)", escapeJSON(name), colors.luminance, colors.isDark, TEXT,
+                                 TEXT);
+            out = std::format_to(out, R"("averageColor":"{}","dominantColor":"{}","dominantHue":{:.6f},"accentColor":"{}"}})", PALETTE.average.toHex(),
+                                 PALETTE.dominant.toHex(), PALETTE.dominantHue, PALETTE.accent.toHex());
+        }
+        *out++ = '}';
+
+        if (writeAtomically(COLORS_PATH, json))
+            m_writes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (m_statsDirty && !m_statsPath.empty()) {
+        m_statsDirty = false;
+
+        const auto STAMP = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        const auto JSON  = std::format(R"({{"time":{},"buffers":{},"usageBytes":{},"peakBytes":{},"evictions":{},"glStateChanges":{},"glStateSkipped":{},"ioDropped":{}}})",
+                                       STAMP, m_stats.buffers, m_stats.usageBytes, m_stats.peakBytes, m_stats.evictions, m_stats.glChanges, m_stats.glSkipped,
+                                       m_dropped.load(std::memory_order_relaxed));
+
+        if (writeAtomically(m_statsPath, JSON))
+            m_writes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (!m_logBuffer.empty()) {
+        std::ofstream file(LOG_PATH, std::ios::app);
+        if (file.is_open()) {
+            file << m_logBuffer;
+            m_writes.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_logBuffer.clear();
+    }
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+std::string CLiquidGlassIOWorker::getStats(eHyprCtlOutputFormat format) const {
+    const uint32_t QUEUED  = m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed);
+    const uint64_t DROPPED = m_dropped.load(std::memory_order_relaxed);
+    const uint64_t WRITES  = m_writes.load(std::memory_order_relaxed);
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        return std::format(R"({{"ioQueued":{},"ioDropped":{},"ioWrites":{}}})", QUEUED, DROPPED, WRITES);
+
+    return std::format("io records queued: {}\nio records dropped: {}\nio file writes: {}\n", QUEUED, DROPPED, WRITES);
+}
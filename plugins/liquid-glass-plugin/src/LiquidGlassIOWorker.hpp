@@ -0,0 +1,162 @@
+#pragma once
+
+/*
+ * Liquid Glass I/O Worker
+ * All of the plugin's file I/O happens on one background thread: the
+ * adaptive colors file the shell polls, the debug log, the stats file,
+ * flight recorder dumps, the shader cache's binaries and shader dev mode's
+ * sources. The compositor thread, the only producer, copies a fixed-size
+ * record into a single-producer single-consumer ring and moves on; a full
+ * ring drops the record (counted) rather than wait. Whole-file records keep
+ * their path and contents in one of a few preallocated file slots instead,
+ * so queueing never allocates on the compositor thread. The worker applies
+ * everything queued before writing, so a burst of color changes is one file
+ * write, only the newest stats snapshot is written, and repeated log lines
+ * collapse into a count. What a read returns comes back to the compositor
+ * thread through an eventfd on its event loop.
+ */
+
+#include "LiquidGlassPalette.hpp"
+
+#include <hyprland/src/SharedDefs.hpp>
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class CLiquidGlassTrace;
+struct wl_event_source;
+
+// Counters for the stats file, gathered on the compositor thread
+struct SIOStats {
+    uint64_t buffers    = 0;
+    uint64_t usageBytes = 0;
+    uint64_t peakBytes  = 0;
+    uint64_t evictions  = 0;
+    uint64_t glChanges  = 0;
+    uint64_t glSkipped  = 0;
+};
+
+class CLiquidGlassIOWorker {
+  public:
+    static constexpr size_t CAPACITY   = 256; // Records; a power of two
+    static constexpr size_t TEXT_MAX   = 192; // Region names, log lines and paths are cut to this
+    static constexpr size_t FILE_SLOTS = 16;  // Whole-file records in flight; more are dropped
+
+    using FReadDone = std::function<void(std::optional<std::string>)>;
+
+    ~CLiquidGlassIOWorker();
+
+    void        start();
+
+    // Writes whatever is still queued, then joins
+    void        stop();
+
+    // Compositor thread only. Each returns false when the ring was full and the record dropped.
+    bool        publishColors(std::string_view region, float luminance, bool isDark, const SGlassPalette& palette);
+    bool        log(std::string_view line);
+    bool        writeStats(const SIOStats& stats, std::string_view path);
+    bool        dumpTrace(const CLiquidGlassTrace& trace, std::string_view path);
+
+    // Read a whole file. done runs later on the compositor thread, from its event loop, with the contents
+    // or nullopt if the file couldn't be read; never if the worker stops first. Paths aren't cut: one
+    // of PATH_MAX or more is refused.
+    bool        readFile(std::string_view path, FReadDone done);
+
+    // Write contents (moved, never copied) to path atomically, creating its directory; delete path
+    bool        writeFile(std::string_view path, std::string contents);
+    bool        removeFile(std::string_view path);
+
+    // hyprctl liquidglass stats
+    std::string getStats(eHyprCtlOutputFormat format) const;
+
+  private:
+    enum eRecord : uint8_t {
+        IO_COLORS = 0, // Adaptive colors of one region
+        IO_LOG,        // One debug log line
+        IO_STATS,      // Snapshot for the stats file
+        IO_TRACE,      // Flight recorder dump
+        IO_READ,       // Whole file, handed back to the compositor thread
+        IO_WRITE,      // Whole file, written atomically
+        IO_REMOVE,
+        IO_STOP,
+    };
+
+    struct SRecord {
+        eRecord                  type   = IO_STOP;
+        uint16_t                 length = 0;
+        char                     text[TEXT_MAX]; // Region, log line or path
+        float                    luminance = 0;
+        bool                     isDark    = true;
+        SGlassPalette            palette;
+        SIOStats                 stats;
+        const CLiquidGlassTrace* trace = nullptr;
+        uint8_t                  file  = 0; // IO_READ, IO_WRITE, IO_REMOVE: index into m_files
+    };
+
+    // A whole-file record's path and contents. Taken by the producer; handed back by the worker once
+    // applied, or for a read once the compositor thread has delivered its result.
+    struct SFileSlot {
+        std::atomic<bool> busy{false};
+        char              path[PATH_MAX];
+        std::string       data;          // Moved in by writeFile and out by the worker, a read's contents the other way
+        bool              found = false; // IO_READ: the file could be read
+        FReadDone         done;          // IO_READ
+    };
+
+    struct SColors {
+        float         luminance = 0;
+        bool          isDark    = true;
+        SGlassPalette palette;
+    };
+
+    std::array<SRecord, CAPACITY>     m_ring;
+    std::array<SFileSlot, FILE_SLOTS> m_files;
+
+    // Free-running counters: tail - head records are queued
+    alignas(64) std::atomic<uint32_t> m_head{0}; // Advanced by the worker
+    alignas(64) std::atomic<uint32_t> m_tail{0}; // Advanced by the producer
+    std::atomic<uint64_t>             m_dropped{0};
+    std::atomic<uint64_t>             m_writes{0};
+    uint32_t                          m_claimed = 0;
+    std::thread                       m_thread;
+
+    // Finished reads' file slots, from the worker to the compositor thread; both reserved for every slot
+    std::mutex                               m_resultsMutex;
+    std::vector<uint8_t>                     m_results;
+    std::vector<uint8_t>                     m_delivering;
+    int                                      m_eventFd     = -1;
+    wl_event_source*                         m_eventSource = nullptr;
+
+    // Worker state
+    std::unordered_map<std::string, SColors> m_colors;
+    std::string                              m_colorsJSON;
+    bool                                     m_colorsDirty = false;
+    SIOStats                                 m_stats;
+    std::string                              m_statsPath;
+    bool                                     m_statsDirty = false;
+    std::string                              m_logBuffer;
+    std::string                              m_lastLine;
+    uint64_t                                 m_repeats = 0;
+
+    SRecord*                                 claim(eRecord type, std::string_view text);
+    SFileSlot*                               claimFile(SRecord& record, std::string_view path);
+    void                                     commit();
+
+    void                                     run();
+    bool                                     drain();
+    void                                     apply(SRecord& record);
+    void                                     flush();
+    void                                     flushRepeats();
+
+    static int                               onReadResults(int fd, uint32_t mask, void* data);
+    void                                     deliverResults();
+};
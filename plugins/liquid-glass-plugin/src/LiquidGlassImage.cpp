@@ -0,0 +1,37 @@
+#include "LiquidGlassImage.hpp"
+
+CLiquidGlassImage::~CLiquidGlassImage() {
+    release();
+}
+
+bool CLiquidGlassImage::alloc(int width, int height) {
+    // Immutable storage can't be resized, so any size change is a new texture
+    release();
+
+    if (width <= 0 || height <= 0)
+        return false;
+
+    glGenTextures(1, &m_tex);
+    glBindTexture(GL_TEXTURE_2D, m_tex);
+    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    m_size = {width, height};
+    return true;
+}
+
+void CLiquidGlassImage::release() {
+    if (m_tex)
+        glDeleteTextures(1, &m_tex);
+
+    m_tex  = 0;
+    m_size = {};
+}
+
+bool CLiquidGlassImage::isAllocated() const {
+    return m_tex != 0;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+/*
+ * Liquid Glass Storage Image
+ * Immutable RGBA8 texture usable both as a compute shader image and as a
+ * regular sampler source (CFramebuffer textures are mutable and can't be
+ * bound to image units on GLES).
+ */
+
+#include <GLES3/gl32.h>
+#include <hyprutils/math/Vector2D.hpp>
+
+using namespace Hyprutils::Math;
+
+class CLiquidGlassImage {
+  public:
+    CLiquidGlassImage() = default;
+    ~CLiquidGlassImage();
+
+    CLiquidGlassImage(const CLiquidGlassImage&)            = delete;
+    CLiquidGlassImage& operator=(const CLiquidGlassImage&) = delete;
+
+    bool     alloc(int width, int height);
+    void     release();
+    bool     isAllocated() const;
+
+    GLuint   getTexID() const {
+        return m_tex;
+    }
+
+    Vector2D m_size;
+
+  private:
+    GLuint m_tex = 0;
+};
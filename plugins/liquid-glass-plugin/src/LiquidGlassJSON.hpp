@@ -0,0 +1,29 @@
+#pragma once
+
+/*
+ * Liquid Glass JSON
+ * String escaping for the JSON the plugin writes by hand with std::format
+ * (hyprctl -j output, trace dumps). Window titles and compiler logs may
+ * hold quotes, backslashes and control characters.
+ */
+
+#include <format>
+#include <string>
+#include <string_view>
+
+inline std::string escapeJSON(std::string_view str) {
+    std::string result;
+    result.reserve(str.size());
+
+    for (const char c : str) {
+        if (c == '"' || c == '\\')
+            result += '\\';
+
+        if (static_cast<unsigned char>(c) < 0x20)
+            result += std::format("\\u{:04x}", static_cast<unsigned char>(c));
+        else
+            result += c;
+    }
+
+    return result;
+}
@@ -0,0 +1,435 @@
+#include "LiquidGlassMerge.hpp"
+#include "LiquidGlassDecoration.hpp"
+#include "LiquidGlassOcclusion.hpp"
+#include "globals.hpp"
+
+#include <GLES3/gl32.h>
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/desktop/Window.hpp>
+#include <hyprland/src/render/OpenGL.hpp>
+#include <hyprland/src/render/Renderer.hpp>
+#include <hyprutils/math/Region.hpp>
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+// ============================================================================
+// INITIALIZATION
+// ============================================================================
+
+void CLiquidGlassMerge::setProgram(GLuint prog) {
+    m_locMemberCount = glGetUniformLocation(prog, "memberCount");
+    m_locMemberRects = glGetUniformLocation(prog, "memberRects");
+    m_locMemberRadii = glGetUniformLocation(prog, "memberRadii");
+    m_locSmoothness  = glGetUniformLocation(prog, "smoothness");
+    m_locRefHeight   = glGetUniformLocation(prog, "refHeight");
+    m_locWindowAlpha = glGetUniformLocation(prog, "windowAlpha");
+    m_locLOD         = glGetUniformLocation(prog, "lod");
+    m_locTime        = glGetUniformLocation(prog, "time");
+    m_locShimmer     = glGetUniformLocation(prog, "shimmerStrength");
+    m_locBlurTex     = glGetUniformLocation(prog, "blurTex");
+    m_locPreBlurred  = glGetUniformLocation(prog, "preBlurred");
+    m_locBridgeOwner = glGetUniformLocation(prog, "bridgeOwner");
+}
+
+void CLiquidGlassMerge::destroy() {
+    for (auto& [id, monitor] : m_monitors)
+        releaseSamples(monitor, 0);
+
+    m_monitors.clear();
+    m_locMemberCount = -1;
+}
+
+void CLiquidGlassMerge::releaseSamples(SMonitorGroups& monitor, size_t keep) {
+    while (monitor.samples.size() > keep) {
+        g_pGlobalState->bufferBudget.release(monitor.samples.back());
+        monitor.samples.pop_back();
+    }
+
+    while (monitor.blurred.size() > keep) {
+        g_pGlobalState->bufferBudget.release(monitor.blurred.back());
+        monitor.blurred.pop_back();
+    }
+}
+
+// ============================================================================
+// GROUPING
+// ============================================================================
+
+void CLiquidGlassMerge::update(PHLMONITOR pMonitor) {
+    static auto* const PENABLED  = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:enabled")->getDataStaticPtr();
+    static auto* const PDISTANCE = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:merge_distance")->getDataStaticPtr();
+
+    // Monitors that went away keep no samples
+    std::erase_if(m_monitors, [this](auto& entry) {
+        if (g_pCompositor->getMonitorFromID(entry.first))
+            return false;
+
+        releaseSamples(entry.second, 0);
+        return true;
+    });
+
+    auto& monitor = m_monitors[pMonitor->m_id];
+    monitor.groups.clear();
+    monitor.index.clear();
+
+    if (!**PENABLED || **PDISTANCE <= 0 || !isAvailable() || !g_pGlobalState->mergeShader.program) {
+        releaseSamples(monitor, 0);
+        damageChanged(pMonitor, monitor);
+        return;
+    }
+
+    // Glass surfaces rendered on this monitor, in monitor-local render coordinates
+    auto& decos = m_decos;
+    auto& boxes = m_boxes;
+    decos.clear();
+    boxes.clear();
+    for (auto& deco : g_pGlobalState->decorations) {
+        auto locked = deco.lock();
+        if (!locked)
+            continue;
+
+        const auto OWNER = locked->getOwner();
+        if (!OWNER || !g_pHyprRenderer->shouldRenderWindow(OWNER, pMonitor))
+            continue;
+
+        const CBox BOX = locked->getRenderBox(pMonitor);
+        if (BOX.empty())
+            continue;
+
+        decos.push_back(locked.get());
+        boxes.push_back(BOX);
+    }
+
+    // Union-find over pairs closer than the merge distance, capped at MAX_MEMBERS per group
+    auto& parent = m_parent;
+    auto& size   = m_size;
+    parent.resize(decos.size());
+    size.assign(decos.size(), 1);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    auto find = [&parent](size_t i) {
+        while (parent[i] != i)
+            i = parent[i] = parent[parent[i]];
+        return i;
+    };
+
+    const double GAP = **PDISTANCE * pMonitor->m_scale;
+    for (size_t i = 0; i < decos.size(); ++i) {
+        for (size_t j = i + 1; j < decos.size(); ++j) {
+            const size_t A = find(i), B = find(j);
+            if (A == B || size[A] + size[B] > MAX_MEMBERS)
+                continue;
+
+            if (boxes[i].copy().expand(GAP).intersection(boxes[j]).empty())
+                continue;
+
+            parent[B] = A;
+            size[A] += size[B];
+        }
+    }
+
+    auto& groupOfRoot = m_groupOfRoot;
+    groupOfRoot.assign(decos.size(), SIZE_MAX);
+    for (size_t i = 0; i < decos.size(); ++i) {
+        const size_t ROOT = find(i);
+        if (size[ROOT] < 2)
+            continue;
+
+        if (groupOfRoot[ROOT] == SIZE_MAX) {
+            groupOfRoot[ROOT] = monitor.groups.size();
+            monitor.groups.emplace_back();
+            monitor.groups.back().sample = groupOfRoot[ROOT];
+        }
+
+        auto&      group = monitor.groups[groupOfRoot[ROOT]];
+        const auto OWNER = decos[i]->getOwner();
+
+        group.members[group.count] = decos[i];
+        group.owners[group.count]  = OWNER;
+        group.boxes[group.count]   = boxes[i];
+        group.radii[group.count]   = static_cast<float>(OWNER->rounding() * pMonitor->m_scale);
+        ++group.count;
+        monitor.index.emplace_back(decos[i], groupOfRoot[ROOT]);
+    }
+
+    for (auto& group : monitor.groups) {
+        double x0 = group.boxes[0].x, y0 = group.boxes[0].y;
+        double x1 = group.boxes[0].x + group.boxes[0].width, y1 = group.boxes[0].y + group.boxes[0].height;
+        for (size_t i = 0; i < group.count; ++i) {
+            const auto& BOX = group.boxes[i];
+            x0              = std::min(x0, BOX.x);
+            y0              = std::min(y0, BOX.y);
+            x1              = std::max(x1, BOX.x + BOX.width);
+            y1              = std::max(y1, BOX.y + BOX.height);
+        }
+
+        group.box = CBox{x0, y0, x1 - x0, y1 - y0};
+    }
+
+    releaseSamples(monitor, monitor.groups.size());
+    damageChanged(pMonitor, monitor);
+}
+
+void CLiquidGlassMerge::damageChanged(PHLMONITOR pMonitor, SMonitorGroups& monitor) {
+    auto sameBox = [](const CBox& a, const CBox& b) { return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height; };
+    if (std::ranges::equal(monitor.groups, monitor.lastBoxes, sameBox, &SGroup::box))
+        return;
+
+    auto damage = [pMonitor](const CBox& box) {
+        CBox logical = box.copy().scale(1.0 / pMonitor->m_scale).translate(pMonitor->m_position);
+        g_pHyprRenderer->damageBox(logical);
+    };
+
+    // The bridges between members lie outside every window's own damage
+    for (const auto& BOX : monitor.lastBoxes)
+        damage(BOX);
+
+    monitor.lastBoxes.clear();
+    for (const auto& GROUP : monitor.groups) {
+        damage(GROUP.box);
+        monitor.lastBoxes.push_back(GROUP.box);
+    }
+}
+
+void CLiquidGlassMerge::damageGroups() {
+    for (auto& [id, monitor] : m_monitors) {
+        const auto PMONITOR = g_pCompositor->getMonitorFromID(id);
+        if (!PMONITOR)
+            continue;
+
+        for (const auto& BOX : monitor.lastBoxes) {
+            CBox logical = BOX.copy().scale(1.0 / PMONITOR->m_scale).translate(PMONITOR->m_position);
+            g_pHyprRenderer->damageBox(logical);
+        }
+    }
+}
+
+CLiquidGlassMerge::SGroup* CLiquidGlassMerge::groupFor(const CLiquidGlassDecoration* deco, PHLMONITOR pMonitor) {
+    auto monitor = m_monitors.find(pMonitor->m_id);
+    if (monitor == m_monitors.end())
+        return nullptr;
+
+    for (const auto& [member, group] : monitor->second.index) {
+        if (member == deco)
+            return &monitor->second.groups[group];
+    }
+
+    return nullptr;
+}
+
+CBox CLiquidGlassMerge::groupBox(const CLiquidGlassDecoration* deco, PHLMONITOR pMonitor) {
+    const auto* GROUP = groupFor(deco, pMonitor);
+    return GROUP ? GROUP->box : CBox{};
+}
+
+// ============================================================================
+// RENDERING
+// ============================================================================
+
+bool CLiquidGlassMerge::sample(SGroup& group, SMonitorGroups& monitor, PHLMONITOR pMonitor, CFramebuffer& target, float lod) {
+    // Groups can render in any order; deque growth keeps existing samples in place
+    while (monitor.samples.size() <= group.sample)
+        monitor.samples.emplace_back();
+    while (monitor.blurred.size() <= group.sample)
+        monitor.blurred.emplace_back();
+
+    auto& sampleFB = monitor.samples[group.sample];
+    auto& blurOut  = monitor.blurred[group.sample];
+
+    // Left from the previous member's sample otherwise
+    group.preBlurred = false;
+
+    const auto TR   = wlTransformToHyprutils(invertTransform(pMonitor->m_transform));
+    const auto SIZE = pMonitor->m_transformedSize;
+
+    CBox transformed = group.box;
+    transformed.transform(TR, SIZE.x, SIZE.y);
+
+    // The whole box even under opaque members: their background still feeds the neighbours' refraction and the bridges
+    {
+        CLiquidGlassTraceScope TRACE(TRACE_SAMPLE, nullptr, transformed);
+        if (!CLiquidGlassDecoration::sampleBackground(sampleFB, target, transformed, CLiquidGlassDecoration::motionSampleScale(lod)))
+            return false;
+    }
+
+    const double SAMPLEPIXELS = sampleFB.m_size.x * sampleFB.m_size.y;
+    g_pGlobalState->occlusion.account(0, 0, SAMPLEPIXELS, SAMPLEPIXELS);
+
+    // A large group blurs through the tiled compute path as a large window would. The result
+    // holds one blur strength, so only when every member's profile agrees on it.
+    auto&       profiles = g_pGlobalState->profiles;
+    const float STRENGTH = profiles.forWindow(group.owners[0].lock()).params.blurStrength;
+    bool        shared   = true;
+    for (size_t i = 1; i < group.count; ++i)
+        shared = shared && profiles.forWindow(group.owners[i].lock()).params.blurStrength == STRENGTH;
+
+    auto& compute = g_pGlobalState->computeBlur;
+    if (!shared || !compute.shouldUse(transformed)) {
+        // Small again: give the compute buffer back
+        if (blurOut.isAllocated())
+            g_pGlobalState->bufferBudget.release(blurOut);
+        return true;
+    }
+
+    const int W = static_cast<int>(sampleFB.m_size.x);
+    const int H = static_cast<int>(sampleFB.m_size.y);
+
+    CLiquidGlassTraceScope TRACE(TRACE_COMPUTE_BLUR, nullptr, transformed);
+    group.preBlurred = g_pGlobalState->bufferBudget.ensure(blurOut, W, H) && compute.blur(sampleFB, blurOut, STRENGTH * W / transformed.width);
+    return true;
+}
+
+void CLiquidGlassMerge::draw(SGroup& group, SMonitorGroups& monitor, PHLMONITOR pMonitor, CFramebuffer& target, CLiquidGlassProfiles::SProfile& profile,
+                             float windowAlpha, float lod, std::span<const CBox> clips, int bridgeOwner) {
+    static auto* const PDISTANCE = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:merge_distance")->getDataStaticPtr();
+
+    if (clips.empty())
+        return;
+
+    auto& sampleFB = monitor.samples[group.sample];
+    auto  tex      = sampleFB.getTexture();
+    if (!tex)
+        return;
+
+    const auto TR   = wlTransformToHyprutils(invertTransform(pMonitor->m_transform));
+    const auto SIZE = pMonitor->m_transformedSize;
+
+    CBox transformed = group.box;
+    transformed.transform(TR, SIZE.x, SIZE.y);
+
+    // Member shapes relative to the group box, in the same (transformed) space as the sample
+    std::array<float, MAX_MEMBERS * 4> rects{};
+    float                              refHeight = transformed.height;
+    for (size_t i = 0; i < group.count; ++i) {
+        CBox member = group.boxes[i];
+        member.transform(TR, SIZE.x, SIZE.y);
+
+        rects[i * 4 + 0] = static_cast<float>(member.x - transformed.x);
+        rects[i * 4 + 1] = static_cast<float>(member.y - transformed.y);
+        rects[i * 4 + 2] = static_cast<float>(member.width);
+        rects[i * 4 + 3] = static_cast<float>(member.height);
+        refHeight        = std::min(refHeight, static_cast<float>(member.height));
+    }
+
+    Mat3x3 matrix   = g_pHyprOpenGL->m_renderData.monitorProjection.projectBox(group.box, TR, group.box.rot);
+    Mat3x3 glMatrix = g_pHyprOpenGL->m_renderData.projection.copy().multiply(matrix);
+    glMatrix.transpose();
+
+    auto& gl = g_pGlobalState->glState;
+    gl.bindFramebuffer(GL_FRAMEBUFFER, target.getFBID());
+
+    // Pre-blurred background from the compute path goes on unit 1
+    if (group.preBlurred)
+        gl.bindTexture(1, monitor.blurred[group.sample].getTexID());
+    gl.bindTexture(0, tex->m_texID);
+
+    gl.enableBlend();
+    gl.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    auto& shader = g_pGlobalState->mergeShader;
+    gl.useProgram(shader.program);
+    g_pGlobalState->profiles.bind(profile);
+
+    shader.setUniformMatrix3fv(SHADER_PROJ, 1, GL_FALSE, glMatrix.getMatrix());
+    shader.setUniformInt(SHADER_TEX, 0);
+    shader.setUniformFloat2(SHADER_FULL_SIZE, static_cast<float>(transformed.width), static_cast<float>(transformed.height));
+
+    glUniform1i(m_locMemberCount, static_cast<GLint>(group.count));
+    glUniform4fv(m_locMemberRects, MAX_MEMBERS, rects.data());
+    glUniform1fv(m_locMemberRadii, static_cast<GLsizei>(group.count), group.radii.data());
+    glUniform1f(m_locSmoothness, static_cast<float>(**PDISTANCE * pMonitor->m_scale));
+    glUniform1f(m_locRefHeight, std::max(refHeight, 1.0f));
+    glUniform1f(m_locWindowAlpha, windowAlpha);
+    glUniform1f(m_locLOD, lod);
+    glUniform1f(m_locTime, g_pGlobalState->animator.time());
+    glUniform1f(m_locShimmer, g_pGlobalState->animator.shimmer());
+    glUniform1i(m_locBlurTex, 1);
+    glUniform1i(m_locPreBlurred, group.preBlurred ? 1 : 0);
+    glUniform1i(m_locBridgeOwner, bridgeOwner);
+
+    // Only where this element is damaged: the rest still holds last frame's windows on top.
+    // Clipped rect by rect against the damage region itself, so no temporary region is built.
+    int         rectCount = 0;
+    const auto* RECTS     = pixman_region32_rectangles(g_pHyprOpenGL->m_renderData.damage.pixman(), &rectCount);
+
+    gl.bindVertexArray(shader.uniformLocations[SHADER_SHADER_VAO]);
+    for (const auto& CLIP : clips) {
+        for (int i = 0; i < rectCount; ++i) {
+            const auto& RECT    = RECTS[i];
+            const CBox  CLIPPED = CBox{(double)RECT.x1, (double)RECT.y1, (double)(RECT.x2 - RECT.x1), (double)(RECT.y2 - RECT.y1)}.intersection(CLIP);
+            if (CLIPPED.empty())
+                continue;
+
+            g_pHyprOpenGL->scissor(CLIPPED);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+    }
+
+    g_pHyprOpenGL->scissor(nullptr);
+}
+
+double CLiquidGlassMerge::render(SGroup& group, const CLiquidGlassDecoration* deco, PHLMONITOR pMonitor, CFramebuffer& target, float windowAlpha, float lod,
+                                 const CBox& hole) {
+    const auto IT = std::find(group.members.begin(), group.members.begin() + group.count, deco);
+    if (IT == group.members.begin() + group.count)
+        return 0;
+
+    const size_t           INDEX = IT - group.members.begin();
+    const auto             OWNER = group.owners[INDEX].lock();
+    CLiquidGlassTraceScope TRACE(TRACE_MERGE, OWNER ? OWNER->m_title.c_str() : nullptr, group.boxes[INDEX]);
+
+    auto& monitor = m_monitors[pMonitor->m_id];
+
+    // Each member samples when it renders, so it refracts what is below it now: the members under it
+    // included, and any other window stacked between them
+    group.sampled = sample(group, monitor, pMonitor, target, lod);
+    if (!group.sampled)
+        return 0;
+
+    auto& profile = g_pGlobalState->profiles.forWindow(OWNER);
+
+    // This member's own box, less what its opaque content covers
+    std::array<CBox, 4> pieces;
+    const size_t        COUNT  = CLiquidGlassOcclusion::subtract(group.boxes[INDEX], hole, pieces);
+    double              shaded = 0;
+    for (size_t i = 0; i < COUNT; ++i)
+        shaded += pieces[i].width * pieces[i].height;
+
+    draw(group, monitor, pMonitor, target, profile, windowAlpha, lod, std::span<const CBox>(pieces.data(), COUNT), -1);
+
+    // The bridges belong to no box: each member adds the part closest to it, which stacks with it. One that
+    // is occluded or undamaged this frame leaves out only that part, not the whole group's.
+    draw(group, monitor, pMonitor, target, profile, windowAlpha, lod, std::span<const CBox>(&group.box, 1), static_cast<int>(INDEX));
+
+    return shaded;
+}
+
+CFramebuffer* CLiquidGlassMerge::sampleFor(SGroup& group, const CLiquidGlassDecoration* deco, PHLMONITOR pMonitor, CBox& region) {
+    auto& monitor = m_monitors[pMonitor->m_id];
+    if (!group.sampled || monitor.samples.size() <= group.sample)
+        return nullptr;
+
+    auto& sampleFB = monitor.samples[group.sample];
+    if (!sampleFB.isAllocated())
+        return nullptr;
+
+    const auto IT = std::find(group.members.begin(), group.members.begin() + group.count, deco);
+    if (IT == group.members.begin() + group.count)
+        return nullptr;
+
+    const auto TR   = wlTransformToHyprutils(invertTransform(pMonitor->m_transform));
+    const auto SIZE = pMonitor->m_transformedSize;
+
+    CBox transformed = group.box;
+    CBox member      = group.boxes[IT - group.members.begin()];
+    transformed.transform(TR, SIZE.x, SIZE.y);
+    member.transform(TR, SIZE.x, SIZE.y);
+
+    // The sample may be at reduced resolution
+    const double SX = sampleFB.m_size.x / transformed.width;
+    const double SY = sampleFB.m_size.y / transformed.height;
+    region          = CBox{(member.x - transformed.x) * SX, (member.y - transformed.y) * SY, member.width * SX, member.height * SY};
+
+    return &sampleFB;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+ * Liquid Glass Merge
+ * Groups glass surfaces on a monitor that are close enough to touch and
+ * renders each group as the smooth union of their shapes. Each member draws
+ * the merged shape over its own box in its own pass, from a sample of the
+ * group's box taken right then, so it stacks, is damaged and is occluded
+ * like its window alone would be and refracts the members below it. It also
+ * draws the part of the bridges closest to it: a member that doesn't render
+ * this frame takes only its own share of them along.
+ */
+
+#include "LiquidGlassImage.hpp"
+#include "LiquidGlassProfiles.hpp"
+
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <hyprutils/math/Box.hpp>
+#include <array>
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CLiquidGlassDecoration;
+
+class CLiquidGlassMerge {
+  public:
+    // Must match MAX_MEMBERS in liquidglass_merge.frag
+    static constexpr size_t MAX_MEMBERS = 4;
+
+    // Fixed capacity so regrouping every frame reuses the same storage
+    struct SGroup {
+        std::array<const CLiquidGlassDecoration*, MAX_MEMBERS> members = {};
+        std::array<PHLWINDOWREF, MAX_MEMBERS>                  owners; // Supply each member's parameter profile, in members order
+        std::array<CBox, MAX_MEMBERS>                          boxes;  // Monitor-local render boxes, in members order
+        std::array<float, MAX_MEMBERS>                         radii = {};
+        size_t                                                 count = 0;
+        CBox                                                   box;    // Union of boxes
+        size_t                                                 sample     = 0;
+        bool                                                   sampled    = false; // The last member to render took its sample
+        bool                                                   preBlurred = false; // ...and blurred it through the compute path
+    };
+
+    // Fetch the merge program's own uniform locations (the rest live in g_pGlobalState->mergeShader)
+    void    setProgram(GLuint prog);
+    void    destroy();
+
+    bool    isAvailable() const {
+        return m_locMemberCount >= 0;
+    }
+
+    // preRender: regroup the glass surfaces on this monitor
+    void    update(PHLMONITOR pMonitor);
+
+    // Group this decoration renders in on pMonitor, or nullptr if it renders alone
+    SGroup* groupFor(const CLiquidGlassDecoration* deco, PHLMONITOR pMonitor);
+
+    // Damage every group's box (bridges between members belong to no window)
+    void    damageGroups();
+
+    // Monitor-local render box of the group deco belongs to on pMonitor, empty if it renders alone
+    CBox    groupBox(const CLiquidGlassDecoration* deco, PHLMONITOR pMonitor);
+
+    // Sample the group's box and draw deco's part of it into target: the merged shape over its box minus
+    // hole, with its own profile, plus the bridges closest to it. Returns the box pixels shaded.
+    double  render(SGroup& group, const CLiquidGlassDecoration* deco, PHLMONITOR pMonitor, CFramebuffer& target, float windowAlpha, float lod,
+                   const CBox& hole);
+
+    // The sample deco rendered from and the part of it behind deco (valid right after its render)
+    CFramebuffer* sampleFor(SGroup& group, const CLiquidGlassDecoration* deco, PHLMONITOR pMonitor, CBox& region);
+
+  private:
+    struct SMonitorGroups {
+        std::vector<SGroup>                                           groups;
+        std::vector<std::pair<const CLiquidGlassDecoration*, size_t>> index;     // Member -> group; a handful of entries
+        std::vector<CBox>                                             lastBoxes; // Previous frame's group boxes, for damage
+        std::deque<CFramebuffer>                                      samples;   // One per group, reused across frames
+        std::deque<CLiquidGlassImage>                                 blurred;   // Compute-blurred samples, parallel to samples
+    };
+
+    std::unordered_map<MONITORID, SMonitorGroups> m_monitors;
+
+    // Grouping scratch, cleared rather than freed between frames
+    std::vector<CLiquidGlassDecoration*> m_decos;
+    std::vector<CBox>                    m_boxes;
+    std::vector<size_t>                  m_parent;
+    std::vector<size_t>                  m_size;
+    std::vector<size_t>                  m_groupOfRoot;
+
+    GLint m_locMemberCount  = -1;
+    GLint m_locMemberRects  = -1;
+    GLint m_locMemberRadii  = -1;
+    GLint m_locSmoothness   = -1;
+    GLint m_locRefHeight    = -1;
+    GLint m_locWindowAlpha  = -1;
+    GLint m_locLOD          = -1;
+    GLint m_locTime         = -1;
+    GLint m_locShimmer      = -1;
+    GLint m_locBlurTex      = -1;
+    GLint m_locPreBlurred   = -1;
+    GLint m_locBridgeOwner  = -1;
+
+    void  releaseSamples(SMonitorGroups& monitor, size_t keep);
+
+    // Take a member's sample of the group's box and, for a large group, blur it through the compute path
+    bool  sample(SGroup& group, SMonitorGroups& monitor, PHLMONITOR pMonitor, CFramebuffer& target, float lod);
+
+    // Draw the merged shape over the parts of clips inside this element's damage (bridgeOwner >= 0: only the
+    // bridges closest to that member)
+    void  draw(SGroup& group, SMonitorGroups& monitor, PHLMONITOR pMonitor, CFramebuffer& target, CLiquidGlassProfiles::SProfile& profile, float windowAlpha,
+               float lod, std::span<const CBox> clips, int bridgeOwner);
+    void  damageChanged(PHLMONITOR pMonitor, SMonitorGroups& monitor);
+};
@@ -0,0 +1,175 @@
+#include "LiquidGlassOcclusion.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/desktop/Window.hpp>
+#include <hyprland/src/desktop/WLSurface.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <hyprland/src/protocols/core/Compositor.hpp>
+#include <hyprland/src/render/Texture.hpp>
+#include <hyprutils/math/Region.hpp>
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+// ============================================================================
+// OPAQUE REGION
+// ============================================================================
+
+CBox CLiquidGlassOcclusion::opaqueBox(PHLWINDOW pWindow, PHLMONITOR pMonitor, const CBox& renderBox, float alpha) const {
+    static auto* const PSKIP = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:skip_opaque")->getDataStaticPtr();
+
+    if (!**PSKIP)
+        return {};
+
+    return opaquePart(pWindow, pMonitor, renderBox, alpha);
+}
+
+CBox CLiquidGlassOcclusion::opaquePart(PHLWINDOW pWindow, PHLMONITOR pMonitor, const CBox& renderBox, float alpha) {
+    // Content drawn with any transparency (opacity rules, fades) lets all of the glass through
+    if (alpha < 1.f || renderBox.empty())
+        return {};
+
+    const auto SURFACE = pWindow->m_wlSurface ? pWindow->m_wlSurface->resource() : nullptr;
+    if (!SURFACE)
+        return {};
+
+    auto&          state = SURFACE->m_current;
+    const Vector2D SIZE  = state.size;
+    if (SIZE.x <= 0 || SIZE.y <= 0)
+        return {};
+
+    // Surface-local, logical pixels
+    CBox opaque;
+    if (pWindow->m_windowData.opaque.valueOrDefault() || (state.texture && state.texture->m_opaque))
+        opaque = {0, 0, SIZE.x, SIZE.y};
+    else {
+        // Clients declare a handful of rectangles at most; the largest one carries the savings.
+        // Read straight from pixman: getRects() would allocate every frame.
+        int         count = 0;
+        const auto* RECTS = pixman_region32_rectangles(state.opaque.pixman(), &count);
+        double      best  = 0;
+        for (int i = 0; i < count; ++i) {
+            const double W = RECTS[i].x2 - RECTS[i].x1;
+            const double H = RECTS[i].y2 - RECTS[i].y1;
+            if (W * H > best) {
+                best   = W * H;
+                opaque = {static_cast<double>(RECTS[i].x1), static_cast<double>(RECTS[i].y1), W, H};
+            }
+        }
+    }
+
+    if (opaque.empty())
+        return {};
+
+    // Into render coordinates, rounded inward so a partly covered pixel is still shaded
+    const double SX = renderBox.width / SIZE.x;
+    const double SY = renderBox.height / SIZE.y;
+    const double X0 = std::ceil(renderBox.x + opaque.x * SX);
+    const double Y0 = std::ceil(renderBox.y + opaque.y * SY);
+    const double X1 = std::floor(renderBox.x + (opaque.x + opaque.width) * SX);
+    const double Y1 = std::floor(renderBox.y + (opaque.y + opaque.height) * SY);
+    if (X1 <= X0 || Y1 <= Y0)
+        return {};
+
+    CBox hole = CBox{X0, Y0, X1 - X0, Y1 - Y0}.intersection(renderBox);
+
+    // Rounded corners show the glass: keep clear of them across or down, whichever leaves more
+    const double R = std::ceil(pWindow->rounding() * pMonitor->m_scale);
+    if (R > 0 && !hole.empty()) {
+        const CBox TALL = hole.intersection({renderBox.x + R, renderBox.y, renderBox.width - R * 2.0, renderBox.height});
+        const CBox WIDE = hole.intersection({renderBox.x, renderBox.y + R, renderBox.width, renderBox.height - R * 2.0});
+        hole            = TALL.width * TALL.height >= WIDE.width * WIDE.height ? TALL : WIDE;
+    }
+
+    return hole.empty() ? CBox{} : hole;
+}
+
+bool CLiquidGlassOcclusion::isCovered(PHLWINDOW pWindow) const {
+    const auto PMONITOR = pWindow->m_monitor.lock();
+    if (!PMONITOR)
+        return false;
+
+    // Logical coordinates throughout: the holes only need to line up with each other
+    const CBox BOX = pWindow->getWindowMainSurfaceBox();
+    if (BOX.empty())
+        return false;
+
+    // Tiled windows draw below floating ones; within each, later in m_windows is higher
+    CRegion uncovered{BOX};
+    bool    above = false;
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (w == pWindow) {
+            above = true;
+            continue;
+        }
+
+        const bool HIGHER = w->m_isFloating != pWindow->m_isFloating ? w->m_isFloating : above;
+        if (!HIGHER || !w->m_isMapped || w->isHidden() || w->m_fadingOut || w->m_workspace != pWindow->m_workspace)
+            continue;
+
+        const CBox HOLE = opaquePart(w, PMONITOR, w->getWindowMainSurfaceBox(), w->m_alpha->value() * w->m_activeInactiveAlpha->value());
+        if (HOLE.empty())
+            continue;
+
+        uncovered.subtract(HOLE);
+        if (uncovered.empty())
+            return true;
+    }
+
+    return false;
+}
+
+size_t CLiquidGlassOcclusion::subtract(const CBox& box, const CBox& hole, std::array<CBox, 4>& out) {
+    const double RIGHT  = box.x + box.width;
+    const double BOTTOM = box.y + box.height;
+    const double X0     = std::max(box.x, hole.x);
+    const double Y0     = std::max(box.y, hole.y);
+    const double X1     = std::min(RIGHT, hole.x + hole.width);
+    const double Y1     = std::min(BOTTOM, hole.y + hole.height);
+
+    if (hole.empty() || X1 <= X0 || Y1 <= Y0) {
+        out[0] = box;
+        return 1;
+    }
+
+    // Full-width strips above and below the hole, then what is left beside it
+    size_t count = 0;
+    if (Y0 > box.y)
+        out[count++] = CBox{box.x, box.y, box.width, Y0 - box.y};
+    if (BOTTOM > Y1)
+        out[count++] = CBox{box.x, Y1, box.width, BOTTOM - Y1};
+    if (X0 > box.x)
+        out[count++] = CBox{box.x, Y0, X0 - box.x, Y1 - Y0};
+    if (RIGHT > X1)
+        out[count++] = CBox{X1, Y0, RIGHT - X1, Y1 - Y0};
+
+    return count;
+}
+
+// ============================================================================
+// COUNTERS
+// ============================================================================
+
+void CLiquidGlassOcclusion::account(double boxPixels, double shadedPixels, double samplePixels, double sampledPixels) {
+    m_frame.boxPixels += static_cast<uint64_t>(boxPixels);
+    m_frame.shadedPixels += static_cast<uint64_t>(shadedPixels);
+    m_frame.samplePixels += static_cast<uint64_t>(samplePixels);
+    m_frame.sampledPixels += static_cast<uint64_t>(sampledPixels);
+}
+
+void CLiquidGlassOcclusion::onFrame() {
+    m_savedTotal += (m_frame.boxPixels - std::min(m_frame.shadedPixels, m_frame.boxPixels)) +
+        (m_frame.samplePixels - std::min(m_frame.sampledPixels, m_frame.samplePixels));
+    m_last  = m_frame;
+    m_frame = {};
+}
+
+std::string CLiquidGlassOcclusion::getStats(eHyprCtlOutputFormat format) const {
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        return std::format(R"({{"glassPixels":{},"glassPixelsShaded":{},"samplePixels":{},"samplePixelsCopied":{},"opaquePixelsSkipped":{}}})", m_last.boxPixels,
+                           m_last.shadedPixels, m_last.samplePixels, m_last.sampledPixels, m_savedTotal);
+
+    return std::format("glass pixels shaded (last frame): {} of {}\nbackground pixels sampled (last frame): {} of {}\npixels skipped under opaque content (total): {}\n",
+                       m_last.shadedPixels, m_last.boxPixels, m_last.sampledPixels, m_last.samplePixels, m_savedTotal);
+}
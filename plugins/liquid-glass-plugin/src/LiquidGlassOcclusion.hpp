@@ -0,0 +1,57 @@
+#pragma once
+
+/*
+ * Liquid Glass Occlusion
+ * The glass is drawn beneath the window's content, so wherever the client
+ * is fully opaque it is overwritten without ever being seen. This reads the
+ * surface's declared opaque region (or an opaque buffer, or an "opaque"
+ * window rule) and picks its largest rectangle clear of the rounded corners
+ * as a hole the decoration neither samples nor shades. A window drawn with
+ * any transparency (opacity rules, fades) has no hole. The same holes tell
+ * the animator when a window's glass is buried under opaque windows above.
+ */
+
+#include <hyprland/src/SharedDefs.hpp>
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprutils/math/Box.hpp>
+#include <array>
+#include <cstdint>
+#include <string>
+
+class CLiquidGlassOcclusion {
+  public:
+    // Part of renderBox (the window's main surface in render coordinates) covered by opaque
+    // content, shrunk to whole pixels; empty when there is none or plugin:liquid-glass:skip_opaque is off
+    CBox          opaqueBox(PHLWINDOW pWindow, PHLMONITOR pMonitor, const CBox& renderBox, float alpha) const;
+
+    // Whether every pixel of the window's glass is under opaque content of windows stacked above it,
+    // whatever skip_opaque says (only their largest opaque rectangles count, so it may miss some)
+    bool          isCovered(PHLWINDOW pWindow) const;
+
+    // box minus hole as up to four non-overlapping boxes (box itself when they don't intersect)
+    static size_t subtract(const CBox& box, const CBox& hole, std::array<CBox, 4>& out);
+
+    // Pixels of one window's glass this frame: the whole box and what was shaded,
+    // the full background sample and what was copied
+    void          account(double boxPixels, double shadedPixels, double samplePixels, double sampledPixels);
+
+    // render: RENDER_POST, closes the frame's counters
+    void          onFrame();
+
+    // hyprctl liquidglass stats
+    std::string   getStats(eHyprCtlOutputFormat format) const;
+
+  private:
+    static CBox   opaquePart(PHLWINDOW pWindow, PHLMONITOR pMonitor, const CBox& renderBox, float alpha);
+
+    struct SCounters {
+        uint64_t boxPixels     = 0;
+        uint64_t shadedPixels  = 0;
+        uint64_t samplePixels  = 0;
+        uint64_t sampledPixels = 0;
+    };
+
+    SCounters m_frame;
+    SCounters m_last;
+    uint64_t  m_savedTotal = 0; // Shading and sampling pixels skipped since load
+};
@@ -0,0 +1,139 @@
+#include "LiquidGlassPalette.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+// Samples below this chroma (max - min) carry no usable hue
+constexpr float MIN_CHROMA = 0.08f;
+
+// WCAG contrast the accent keeps against the average background (non-text UI)
+constexpr float ACCENT_CONTRAST = 3.0f;
+
+// Change thresholds for republishing
+constexpr float COLOR_EPSILON = 0.04f;
+constexpr float HUE_EPSILON   = 15.0f;
+
+// ============================================================================
+// COLOR HELPERS
+// ============================================================================
+
+std::string SGlassColor::toHex() const {
+    auto channel = [](float v) { return static_cast<int>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f)); };
+    return std::format("#{:02x}{:02x}{:02x}", channel(r), channel(g), channel(b));
+}
+
+static float relativeLuminance(const SGlassColor& c) {
+    auto linear = [](float v) { return v <= 0.03928f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f); };
+    return 0.2126f * linear(c.r) + 0.7152f * linear(c.g) + 0.0722f * linear(c.b);
+}
+
+static float contrastRatio(const SGlassColor& a, const SGlassColor& b) {
+    const float LA = relativeLuminance(a), LB = relativeLuminance(b);
+    return (std::max(LA, LB) + 0.05f) / (std::min(LA, LB) + 0.05f);
+}
+
+static float hueOf(float r, float g, float b, float chroma) {
+    const float MAX = std::max({r, g, b});
+    float       hue = 0.0f;
+    if (MAX == r)
+        hue = std::fmod((g - b) / chroma, 6.0f);
+    else if (MAX == g)
+        hue = (b - r) / chroma + 2.0f;
+    else
+        hue = (r - g) / chroma + 4.0f;
+
+    hue *= 60.0f;
+    return hue < 0.0f ? hue + 360.0f : hue;
+}
+
+static SGlassColor fromHSL(float hue, float saturation, float lightness) {
+    const float C  = (1.0f - std::abs(2.0f * lightness - 1.0f)) * saturation;
+    const float HP = hue / 60.0f;
+    const float X  = C * (1.0f - std::abs(std::fmod(HP, 2.0f) - 1.0f));
+    const float M  = lightness - C / 2.0f;
+
+    SGlassColor c;
+    switch (static_cast<int>(HP) % 6) {
+        case 0: c = {C, X, 0}; break;
+        case 1: c = {X, C, 0}; break;
+        case 2: c = {0, C, X}; break;
+        case 3: c = {0, X, C}; break;
+        case 4: c = {X, 0, C}; break;
+        default: c = {C, 0, X}; break;
+    }
+
+    return {c.r + M, c.g + M, c.b + M};
+}
+
+// ============================================================================
+// PALETTE
+// ============================================================================
+
+bool SGlassPalette::differsFrom(const SGlassPalette& other) const {
+    auto colorDiffers = [](const SGlassColor& a, const SGlassColor& b) {
+        return std::abs(a.r - b.r) > COLOR_EPSILON || std::abs(a.g - b.g) > COLOR_EPSILON || std::abs(a.b - b.b) > COLOR_EPSILON;
+    };
+
+    if ((dominantHue < 0.0f) != (other.dominantHue < 0.0f))
+        return true;
+
+    if (dominantHue >= 0.0f) {
+        const float DELTA = std::abs(dominantHue - other.dominantHue);
+        if (std::min(DELTA, 360.0f - DELTA) > HUE_EPSILON)
+            return true;
+    }
+
+    return colorDiffers(average, other.average) || colorDiffers(dominant, other.dominant);
+}
+
+void CLiquidGlassPaletteBuilder::add(float r, float g, float b) {
+    m_sum.r += r;
+    m_sum.g += g;
+    m_sum.b += b;
+    m_count++;
+
+    const float CHROMA = std::max({r, g, b}) - std::min({r, g, b});
+    if (CHROMA < MIN_CHROMA)
+        return;
+
+    // Vivid samples count more towards the dominant hue
+    auto& bucket = m_buckets[static_cast<size_t>(hueOf(r, g, b, CHROMA) / (360.0f / HUE_BUCKETS)) % HUE_BUCKETS];
+    bucket.weight += CHROMA;
+    bucket.sum.r += r * CHROMA;
+    bucket.sum.g += g * CHROMA;
+    bucket.sum.b += b * CHROMA;
+}
+
+SGlassPalette CLiquidGlassPaletteBuilder::build() const {
+    SGlassPalette palette;
+    if (m_count == 0)
+        return palette;
+
+    palette.average  = {m_sum.r / m_count, m_sum.g / m_count, m_sum.b / m_count};
+    palette.dominant = palette.average;
+
+    const auto BEST = std::ranges::max_element(m_buckets, {}, &SBucket::weight);
+
+    // Needs enough vivid area to be a hue rather than noise
+    if (BEST->weight > m_count * MIN_CHROMA * 0.25f) {
+        palette.dominant    = {BEST->sum.r / BEST->weight, BEST->sum.g / BEST->weight, BEST->sum.b / BEST->weight};
+        const float CHROMA  = std::max({palette.dominant.r, palette.dominant.g, palette.dominant.b}) -
+            std::min({palette.dominant.r, palette.dominant.g, palette.dominant.b});
+        palette.dominantHue = CHROMA > 0.0f ? hueOf(palette.dominant.r, palette.dominant.g, palette.dominant.b, CHROMA) : -1.0f;
+    }
+
+    // Accent: the dominant hue (or neutral), walked away from the background's lightness until it reads
+    const float HUE        = std::max(palette.dominantHue, 0.0f);
+    const float SATURATION = palette.dominantHue < 0.0f ? 0.0f : 0.7f;
+    const bool  DARKBG     = relativeLuminance(palette.average) < 0.18f;
+
+    float lightness = 0.5f;
+    palette.accent  = fromHSL(HUE, SATURATION, lightness);
+    while (contrastRatio(palette.accent, palette.average) < ACCENT_CONTRAST && lightness > 0.0f && lightness < 1.0f) {
+        lightness += DARKBG ? 0.05f : -0.05f;
+        palette.accent = fromHSL(HUE, SATURATION, std::clamp(lightness, 0.0f, 1.0f));
+    }
+
+    return palette;
+}
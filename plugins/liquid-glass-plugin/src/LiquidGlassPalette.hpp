@@ -0,0 +1,48 @@
+#pragma once
+
+/*
+ * Liquid Glass Palette
+ * Small colour palette of the background behind a glass surface (average
+ * colour, dominant hue, contrast-safe accent), built from the same sparse
+ * samples the luminance readback already takes.
+ */
+
+#include <array>
+#include <string>
+
+struct SGlassColor {
+    float r = 0.0f;
+    float g = 0.0f;
+    float b = 0.0f;
+
+    std::string toHex() const;
+};
+
+struct SGlassPalette {
+    SGlassColor average;
+    SGlassColor dominant;         // Average of the samples in the dominant hue bucket (= average when greyscale)
+    SGlassColor accent;           // Dominant hue at a lightness that stays readable over average
+    float       dominantHue = -1; // Degrees, -1 when the background has no meaningful hue
+
+    // Whether the shell would notice the difference
+    bool        differsFrom(const SGlassPalette& other) const;
+};
+
+class CLiquidGlassPaletteBuilder {
+  public:
+    // Feed one sample (0-1 sRGB)
+    void          add(float r, float g, float b);
+    SGlassPalette build() const;
+
+  private:
+    static constexpr size_t HUE_BUCKETS = 12;
+
+    struct SBucket {
+        float       weight = 0.0f;
+        SGlassColor sum;
+    };
+
+    std::array<SBucket, HUE_BUCKETS> m_buckets;
+    SGlassColor                      m_sum;
+    int                              m_count = 0;
+};
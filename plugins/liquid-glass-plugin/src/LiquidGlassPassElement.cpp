@@ -1,9 +1,58 @@
 #include "LiquidGlassPassElement.hpp"
+#include "LiquidGlassAllocCounter.hpp"
 #include "LiquidGlassDecoration.hpp"
+#include "LiquidGlassWindows.hpp"
 #include "globals.hpp"
 
 #include <hyprland/src/desktop/Window.hpp>
 #include <hyprland/src/render/OpenGL.hpp>
+#include <vector>
+
+// Free blocks, reserved ahead so returning one never reallocates
+static std::vector<void*>                  g_freeElements;
+static CLiquidGlassPassElement::SPoolStats g_poolStats;
+
+// ============================================================================
+// POOL
+// ============================================================================
+
+void* CLiquidGlassPassElement::operator new(std::size_t size) {
+    if (!g_freeElements.empty()) {
+        void* block = g_freeElements.back();
+        g_freeElements.pop_back();
+        return block;
+    }
+
+    ++g_poolStats.blocks;
+    if (g_freeElements.capacity() < g_poolStats.blocks)
+        g_freeElements.reserve(g_poolStats.blocks * 2);
+
+    return ::operator new(size);
+}
+
+void CLiquidGlassPassElement::operator delete(void* ptr) {
+    if (ptr)
+        g_freeElements.push_back(ptr);
+}
+
+CLiquidGlassPassElement::SPoolStats CLiquidGlassPassElement::poolStats() {
+    auto stats = g_poolStats;
+    stats.free = g_freeElements.size();
+    return stats;
+}
+
+void CLiquidGlassPassElement::releasePool() {
+    for (void* block : g_freeElements)
+        ::operator delete(block);
+
+    g_freeElements.clear();
+    g_freeElements.shrink_to_fit();
+    g_poolStats = {};
+}
+
+// ============================================================================
+// PASS ELEMENT
+// ============================================================================
 
 CLiquidGlassPassElement::CLiquidGlassPassElement(const SLiquidGlassData& data) 
     : m_data(data) {}
@@ -11,26 +60,38 @@ CLiquidGlassPassElement::CLiquidGlassPassElement(const SLiquidGlassData& data)
 void CLiquidGlassPassElement::draw(const CRegion& damage) {
     if (!m_data.deco)
         return;
-    
+
+    CLiquidGlassAllocCounter::CScope ALLOCSCOPE;
+
+    // Hyprland's renderer has touched GL state since our last element
+    auto& gl = g_pGlobalState->glState;
+    gl.invalidate();
+
     m_data.deco->renderPass(g_pHyprOpenGL->m_renderData.pMonitor.lock(), m_data.a);
+
+    gl.restore(g_pHyprOpenGL->m_renderData.currentFB);
 }
 
 std::optional<CBox> CLiquidGlassPassElement::boundingBox() {
-    if (!m_data.deco)
+    return glassBox(m_data.deco, g_pHyprOpenGL->m_renderData.pMonitor.lock());
+}
+
+std::optional<CBox> CLiquidGlassPassElement::glassBox(CLiquidGlassDecoration* deco, PHLMONITOR pMonitor) {
+    if (!deco)
         return std::nullopt;
 
-    const auto PWINDOW = m_data.deco->getOwner();
+    const auto PWINDOW = deco->getOwner();
     if (!PWINDOW)
         return std::nullopt;
 
-    const auto PWINDOWWORKSPACE = PWINDOW->m_workspace;
-    auto surfaceBox = PWINDOW->getWindowMainSurfaceBox();
-
-    if (PWINDOWWORKSPACE && PWINDOWWORKSPACE->m_renderOffset->isBeingAnimated() && !PWINDOW->m_pinned)
-        surfaceBox.translate(PWINDOWWORKSPACE->m_renderOffset->value());
-    surfaceBox.translate(PWINDOW->m_floatingOffset);
+    // In a merged group every member draws part of the bridges, so every member's damage has to reach them
+    if (pMonitor) {
+        const CBox GROUP = g_pGlobalState->merge.groupBox(deco, pMonitor);
+        if (!GROUP.empty())
+            return GROUP.copy().scale(1.0 / pMonitor->m_scale).translate(pMonitor->m_position);
+    }
 
-    return surfaceBox;
+    return CLiquidGlassWindows::glassBox(PWINDOW);
 }
 
 bool CLiquidGlassPassElement::needsLiveBlur() {
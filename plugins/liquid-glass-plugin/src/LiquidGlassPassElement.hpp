@@ -2,7 +2,9 @@
 
 /*
  * Liquid Glass Render Pass Element
- * Integrates with Hyprland's render pass system
+ * Integrates with Hyprland's render pass system. One element is queued per
+ * glass window per frame, so they come from a free list that only grows when
+ * more glass is on screen than ever before.
  */
 
 #include <hyprland/src/render/pass/PassElement.hpp>
@@ -11,7 +13,8 @@
 
 class CLiquidGlassDecoration;
 
-class CLiquidGlassPassElement : public IPassElement {
+// Final: every pool block is sizeof(CLiquidGlassPassElement)
+class CLiquidGlassPassElement final : public IPassElement {
   public:
     struct SLiquidGlassData {
         CLiquidGlassDecoration* deco = nullptr;
@@ -30,6 +33,23 @@ class CLiquidGlassPassElement : public IPassElement {
         return "CLiquidGlassPassElement";
     }
 
+    // Logical box deco's element draws into on pMonitor: its glass, or its merged group's box
+    static std::optional<CBox> glassBox(CLiquidGlassDecoration* deco, PHLMONITOR pMonitor);
+
+    // Pooled: the render pass still owns and deletes elements as usual
+    static void* operator new(std::size_t size);
+    static void  operator delete(void* ptr);
+
+    struct SPoolStats {
+        size_t blocks = 0; // Allocated so far: the most elements ever queued at once
+        size_t free   = 0;
+    };
+
+    static SPoolStats poolStats();
+
+    // Plugin exit: give the free blocks back (no elements may be alive)
+    static void       releasePool();
+
   private:
     SLiquidGlassData m_data;
 };
@@ -0,0 +1,187 @@
+#include "LiquidGlassProfiles.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/desktop/Window.hpp>
+#include <hyprland/src/render/OpenGL.hpp>
+#include <hyprutils/string/String.hpp>
+#include <hyprutils/string/VarList.hpp>
+#include <format>
+
+using namespace Hyprutils::String;
+
+// Parameter names, in SGlassParams order
+static constexpr std::array<const char*, 7> PARAM_NAMES = {
+    "blur_strength", "refraction_strength", "chromatic_aberration", "fresnel_strength", "specular_strength", "glass_opacity", "edge_thickness",
+};
+
+// ============================================================================
+// CONFIG
+// ============================================================================
+
+Hyprlang::CParseResult CLiquidGlassProfiles::onProfileKeyword(const char* value) {
+    Hyprlang::CParseResult result;
+    CVarList               args(value, 0, ',');
+
+    const std::string NAME = trim(args[0]);
+    if (NAME.empty() || NAME == m_default.name) {
+        result.setError("liquid-glass profile needs a name other than \"default\"");
+        return result;
+    }
+
+    SProfile profile{.name = NAME, .tag = "glass-" + NAME};
+
+    for (size_t i = 1; i < args.size(); ++i) {
+        const std::string ARG   = trim(args[i]);
+        const auto        COLON = ARG.find(':');
+        if (COLON == std::string::npos) {
+            result.setError(std::format("liquid-glass profile {}: expected key:value, got \"{}\"", NAME, ARG).c_str());
+            return result;
+        }
+
+        const std::string KEY = trim(ARG.substr(0, COLON));
+        const auto        IT  = std::ranges::find_if(PARAM_NAMES, [&KEY](const char* name) { return KEY == name; });
+        if (IT == PARAM_NAMES.end()) {
+            result.setError(std::format("liquid-glass profile {}: unknown parameter \"{}\"", NAME, KEY).c_str());
+            return result;
+        }
+
+        try {
+            profile.overrides[IT - PARAM_NAMES.begin()] = std::stof(trim(ARG.substr(COLON + 1)));
+        } catch (...) {
+            result.setError(std::format("liquid-glass profile {}: invalid value for {}", NAME, KEY).c_str());
+            return result;
+        }
+    }
+
+    // Redefining a profile, or defining it again on a reload, replaces it in place and keeps its buffer
+    auto existing = std::ranges::find_if(m_profiles, [&NAME](const auto& p) { return p.name == NAME; });
+    if (existing != m_profiles.end()) {
+        profile.ubo = existing->ubo;
+        *existing   = std::move(profile);
+    } else
+        m_profiles.emplace_back(std::move(profile));
+
+    return result;
+}
+
+void CLiquidGlassProfiles::onPreConfigReload() {
+    // The config being loaded defines them again; no GL here, the context may not be current
+    for (auto& profile : m_profiles)
+        profile.defined = false;
+}
+
+void CLiquidGlassProfiles::onConfigReloaded() {
+    // Resolved here once; lookups and draws only read the result
+    resolve(m_default);
+    m_default.dirty = true;
+
+    bool dropped = false;
+    for (auto& profile : m_profiles) {
+        if (!profile.defined) {
+            dropped |= profile.ubo != 0;
+            continue;
+        }
+
+        resolve(profile);
+        profile.dirty = true;
+    }
+
+    if (!dropped)
+        return;
+
+    // Profiles the new config left out give back their buffers
+    g_pHyprOpenGL->makeEGLCurrent();
+    for (auto& profile : m_profiles) {
+        if (!profile.defined)
+            releaseBuffer(profile);
+    }
+}
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+void CLiquidGlassProfiles::resolve(SProfile& profile) {
+    static auto* const PBLUR      = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:blur_strength")->getDataStaticPtr();
+    static auto* const PREFRACT   = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:refraction_strength")->getDataStaticPtr();
+    static auto* const PCHROMATIC = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:chromatic_aberration")->getDataStaticPtr();
+    static auto* const PFRESNEL   = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:fresnel_strength")->getDataStaticPtr();
+    static auto* const PSPECULAR  = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:specular_strength")->getDataStaticPtr();
+    static auto* const POPACITY   = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:glass_opacity")->getDataStaticPtr();
+    static auto* const PEDGE      = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:edge_thickness")->getDataStaticPtr();
+
+    // Profile overrides on top of the global plugin:liquid-glass:* values
+    const std::array<float, 7> GLOBALS = {
+        static_cast<float>(**PBLUR),     static_cast<float>(**PREFRACT), static_cast<float>(**PCHROMATIC), static_cast<float>(**PFRESNEL),
+        static_cast<float>(**PSPECULAR), static_cast<float>(**POPACITY), static_cast<float>(**PEDGE),
+    };
+
+    auto pick = [&profile, &GLOBALS](size_t i) { return profile.overrides[i].value_or(GLOBALS[i]); };
+
+    profile.params.blurStrength        = pick(0);
+    profile.params.refractionStrength  = pick(1);
+    profile.params.chromaticAberration = pick(2);
+    profile.params.fresnelStrength     = pick(3);
+    profile.params.specularStrength    = pick(4);
+    profile.params.glassOpacity        = pick(5);
+    profile.params.edgeThickness       = pick(6);
+}
+
+CLiquidGlassProfiles::SProfile& CLiquidGlassProfiles::defaults() {
+    return m_default;
+}
+
+CLiquidGlassProfiles::SProfile& CLiquidGlassProfiles::forWindow(PHLWINDOW pWindow) {
+    if (pWindow) {
+        for (auto& profile : m_profiles) {
+            if (profile.defined && pWindow->m_tags.isTagged(profile.tag))
+                return profile;
+        }
+    }
+
+    return defaults();
+}
+
+// ============================================================================
+// UNIFORM BUFFERS
+// ============================================================================
+
+void CLiquidGlassProfiles::bind(SProfile& profile) {
+    if (!profile.ubo) {
+        // The new name may be one the GL state cache still holds from a deleted buffer
+        glGenBuffers(1, &profile.ubo);
+        g_pGlobalState->glState.invalidate();
+        g_pGlobalState->glState.bindUniformBuffer(profile.ubo);
+        glBufferData(GL_UNIFORM_BUFFER, sizeof(SGlassParams), nullptr, GL_DYNAMIC_DRAW);
+        profile.dirty = true;
+    }
+
+    if (profile.dirty) {
+        g_pGlobalState->glState.bindUniformBuffer(profile.ubo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(SGlassParams), &profile.params);
+        profile.dirty = false;
+    }
+
+    g_pGlobalState->glState.bindUniformBufferBase(LG_PARAMS_BINDING, profile.ubo);
+}
+
+void CLiquidGlassProfiles::bindBlock(GLuint prog) {
+    const GLuint INDEX = glGetUniformBlockIndex(prog, "GlassParams");
+    if (INDEX != GL_INVALID_INDEX)
+        glUniformBlockBinding(prog, INDEX, LG_PARAMS_BINDING);
+}
+
+void CLiquidGlassProfiles::releaseBuffer(SProfile& profile) {
+    if (profile.ubo)
+        glDeleteBuffers(1, &profile.ubo);
+
+    profile.ubo = 0;
+}
+
+void CLiquidGlassProfiles::destroy() {
+    releaseBuffer(m_default);
+    for (auto& profile : m_profiles)
+        releaseBuffer(profile);
+
+    m_profiles.clear();
+}
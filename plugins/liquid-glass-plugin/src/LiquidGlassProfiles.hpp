@@ -0,0 +1,77 @@
+#pragma once
+
+/*
+ * Liquid Glass Parameter Profiles
+ * Named sets of glass parameters ("notch", "panel", "lite", ...) assigned to
+ * windows with a glass-<name> tag. Each profile lives in its own uniform
+ * buffer that is uploaded once and only re-uploaded when the config reloads,
+ * so a draw just rebinds it.
+ *
+ *   plugin:liquid-glass:profile = notch, refraction_strength:0.12, chromatic_aberration:0.02
+ *   windowrulev2 = tag +glass-notch, title:^molten-glass-notch$
+ */
+
+#include <GLES3/gl32.h>
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprlang.hpp>
+#include <array>
+#include <deque>
+#include <optional>
+#include <string>
+
+// Uniform buffer binding point for the GlassParams block
+constexpr GLuint LG_PARAMS_BINDING = 1;
+
+// std140 layout of the GlassParams uniform block in the shaders
+struct SGlassParams {
+    float blurStrength        = 0.f;
+    float refractionStrength  = 0.f;
+    float chromaticAberration = 0.f;
+    float fresnelStrength     = 0.f;
+    float specularStrength    = 0.f;
+    float glassOpacity        = 0.f;
+    float edgeThickness       = 0.f;
+    float padding             = 0.f;
+};
+
+class CLiquidGlassProfiles {
+  public:
+    struct SProfile {
+        std::string                         name;
+        std::string                         tag;
+        std::array<std::optional<float>, 7> overrides;
+        SGlassParams                        params; // Resolved once per config reload
+        GLuint                              ubo     = 0;
+        bool                                dirty   = true; // params not uploaded yet
+        bool                                defined = true; // By the current config; dropped ones are skipped
+    };
+
+    // plugin:liquid-glass:profile keyword handler
+    Hyprlang::CParseResult onProfileKeyword(const char* value);
+
+    // Named profiles are redefined by every config load
+    void                   onPreConfigReload();
+
+    // Global values may have changed: resolve every profile again, re-upload on next use
+    void                   onConfigReloaded();
+
+    // Profile assigned to a window (the global defaults if none). Profiles are never removed, so the
+    // reference stays valid across config reloads.
+    SProfile&              forWindow(PHLWINDOW pWindow);
+    SProfile&              defaults();
+
+    // Upload (if dirty) and bind a profile's uniform buffer
+    void                   bind(SProfile& profile);
+
+    // Hook a linked program's GlassParams block up to our binding point
+    static void            bindBlock(GLuint prog);
+
+    void                   destroy();
+
+  private:
+    SProfile             m_default{.name = "default"};
+    std::deque<SProfile> m_profiles; // Only grows: a profile a reload drops keeps its slot, undefined
+
+    void                 resolve(SProfile& profile);
+    static void          releaseBuffer(SProfile& profile);
+};
@@ -0,0 +1,221 @@
+#include "LiquidGlassScheduler.hpp"
+#include "globals.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+using namespace std::chrono;
+
+// Assumed cost of a task that has not run yet
+constexpr nanoseconds INITIAL_COST = microseconds(50);
+
+// Frames a claimed task's owner may go undrawn (hidden windows) before it stops taking budget
+constexpr uint64_t REQUEST_FRAMES = 8;
+
+// ============================================================================
+// TASKS
+// ============================================================================
+
+CLiquidGlassScheduler::TaskID CLiquidGlassScheduler::add(const char* name, eLiquidGlassTaskPriority priority, milliseconds period, milliseconds deadline,
+                                                         std::function<void()> run) {
+    TaskID id;
+    if (!m_free.empty()) {
+        id = m_free.back();
+        m_free.pop_back();
+    } else {
+        id = static_cast<TaskID>(m_tasks.size());
+        m_tasks.emplace_back();
+    }
+
+    // Golden-ratio phases: however many tasks share a period, their first runs stay evenly spread
+    const double PHASE = std::fmod(m_added++ * 0.6180339887, 1.0);
+
+    auto&        task = m_tasks[id];
+    task.name         = name;
+    task.priority     = priority;
+    task.period       = period;
+    task.deadline     = deadline;
+    task.due          = steady_clock::now() + duration_cast<steady_clock::duration>(period * PHASE);
+    task.cost         = INITIAL_COST;
+    task.run          = std::move(run);
+    task.requested    = m_frameIndex;
+    task.active       = true;
+
+    return id;
+}
+
+void CLiquidGlassScheduler::remove(TaskID task) {
+    if (task >= m_tasks.size() || !m_tasks[task].active)
+        return;
+
+    m_tasks[task] = {};
+    m_free.push_back(task);
+}
+
+// ============================================================================
+// FRAME
+// ============================================================================
+
+void CLiquidGlassScheduler::beginFrame() {
+    static auto* const PBUDGET = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:frame_budget_us")->getDataStaticPtr();
+
+    // RENDER_PRE comes once per monitor: only the first pass of a frame starts a new budget
+    const auto& CLOCK = g_pGlobalState->frameClock;
+    if (CLOCK.frame() != m_frameIndex) {
+        closeFrame();
+        m_frameIndex = CLOCK.frame();
+    }
+
+    const auto NOW = steady_clock::now();
+    m_due.clear();
+    for (TaskID id = 0; id < m_tasks.size(); ++id) {
+        auto& task    = m_tasks[id];
+        task.admitted = false;
+        task.forced   = false;
+
+        if (!task.active || task.due > NOW)
+            continue;
+
+        // A surface task waits for a pass of the monitor its owner is drawn on
+        if (!task.run && (m_frameIndex - task.requested > REQUEST_FRAMES || (task.monitor && *task.monitor != CLOCK.monitor())))
+            continue;
+
+        task.forced = NOW - task.due >= task.deadline;
+        m_due.push_back(id);
+    }
+
+    if (m_due.empty())
+        return;
+
+    // Overdue first, then by priority, then the longest waiting
+    std::sort(m_due.begin(), m_due.end(), [this](TaskID a, TaskID b) {
+        const auto& A = m_tasks[a];
+        const auto& B = m_tasks[b];
+        if (A.forced != B.forced)
+            return A.forced;
+        if (A.priority != B.priority)
+            return A.priority < B.priority;
+        return A.due < B.due;
+    });
+
+    // What earlier passes of this frame spent is gone. A cheaper task further down may still fit after
+    // an expensive one didn't; the expensive one keeps its place and is forced through at its deadline.
+    const nanoseconds BUDGET = microseconds(std::max<Hyprlang::INT>(**PBUDGET, 0));
+    nanoseconds       planned = m_frame.spent;
+    for (const TaskID id : m_due) {
+        auto& task = m_tasks[id];
+        if (task.forced || BUDGET.count() == 0 || planned + task.cost <= BUDGET) {
+            task.admitted = true;
+            planned += task.cost;
+        } else
+            defer(task);
+    }
+}
+
+void CLiquidGlassScheduler::defer(STask& task) {
+    // Once per frame, however many passes it waits through
+    if (task.deferredIn == m_frameIndex)
+        return;
+
+    task.deferredIn = m_frameIndex;
+    m_frame.deferred++;
+}
+
+CLiquidGlassScheduler::CClaim CLiquidGlassScheduler::claim(TaskID task) {
+    if (task >= m_tasks.size())
+        return {nullptr, task};
+
+    m_tasks[task].requested = m_frameIndex;
+    m_tasks[task].monitor   = g_pGlobalState->frameClock.monitor();
+    if (!m_tasks[task].admitted)
+        return {nullptr, task};
+
+    // Once per admission, however many times the owner is drawn this frame
+    m_tasks[task].admitted = false;
+    return {this, task};
+}
+
+void CLiquidGlassScheduler::endFrame() {
+    static auto* const PBUDGET = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:frame_budget_us")->getDataStaticPtr();
+
+    const nanoseconds  BUDGET = microseconds(std::max<Hyprlang::INT>(**PBUDGET, 0));
+
+    for (const TaskID id : m_due) {
+        auto& task = m_tasks[id];
+        if (!task.run || !task.admitted)
+            continue;
+
+        // Surface tasks may have run over their estimates: what no longer fits waits a pass
+        if (!task.forced && BUDGET.count() > 0 && m_frame.spent + task.cost > BUDGET) {
+            task.admitted = false;
+            defer(task);
+            continue;
+        }
+
+        if (auto run = claim(id))
+            task.run();
+    }
+
+    // Admissions this pass's surfaces didn't claim lapse; they are planned again in a later pass
+    for (const TaskID id : m_due)
+        m_tasks[id].admitted = false;
+
+    m_due.clear();
+}
+
+void CLiquidGlassScheduler::closeFrame() {
+    m_deferredTotal += m_frame.deferred;
+    m_forcedTotal += m_frame.forced;
+    m_peak  = std::max(m_peak, m_frame.spent);
+    m_last  = m_frame;
+    m_frame = {};
+}
+
+void CLiquidGlassScheduler::finish(TaskID id, nanoseconds elapsed) {
+    auto& task = m_tasks[id];
+    if (!task.active)
+        return;
+
+    task.cost = (task.cost * 7 + elapsed) / 8;
+
+    // Keep the task's phase unless it fell a whole period behind
+    const auto NOW = steady_clock::now();
+    task.due += task.period;
+    if (task.due <= NOW)
+        task.due = NOW + task.period;
+
+    m_frame.runs++;
+    m_frame.spent += elapsed;
+    if (task.forced)
+        m_frame.forced++;
+}
+
+// ============================================================================
+// CLAIM
+// ============================================================================
+
+CLiquidGlassScheduler::CClaim::CClaim(CLiquidGlassScheduler* scheduler, TaskID task) : m_scheduler(scheduler), m_task(task) {
+    if (m_scheduler)
+        m_start = steady_clock::now();
+}
+
+CLiquidGlassScheduler::CClaim::~CClaim() {
+    if (m_scheduler)
+        m_scheduler->finish(m_task, duration_cast<nanoseconds>(steady_clock::now() - m_start));
+}
+
+// ============================================================================
+// STATS
+// ============================================================================
+
+std::string CLiquidGlassScheduler::getStats(eHyprCtlOutputFormat format) const {
+    const size_t TASKS = m_tasks.size() - m_free.size();
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        return std::format(R"({{"scheduledTasks":{},"tasksRunLastFrame":{},"taskTimeLastFrameUs":{:.1f},"taskTimePeakUs":{:.1f},"tasksDeferred":{},"tasksForced":{}}})", TASKS,
+                           m_last.runs, m_last.spent.count() / 1000.0, m_peak.count() / 1000.0, m_deferredTotal, m_forcedTotal);
+
+    return std::format("scheduled tasks: {}\ntasks run (last frame): {} in {:.1f} us\ntask time peak: {:.1f} us\ntasks deferred over budget (total): {}\ntasks forced past deadline (total): {}\n",
+                       TASKS, m_last.runs, m_last.spent.count() / 1000.0, m_peak.count() / 1000.0, m_deferredTotal, m_forcedTotal);
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+/*
+ * Liquid Glass Scheduler
+ * Periodic work (each surface's luminance and palette readback, the stats
+ * file, buffer reclamation) is spread across frames instead of landing on
+ * the same one. Tasks start at staggered phases of their period, and each
+ * frame only admits as many due tasks as fit in plugin:liquid-glass:
+ * frame_budget_us, by their measured cost: higher priority first, then the
+ * longest waiting. A task left waiting past its deadline runs regardless of
+ * the budget, so nothing starves when the frame is crowded.
+ *
+ * The budget belongs to a frame of the frame clock, not to a monitor's
+ * pass: with several monitors, each pass admits work against what the
+ * earlier passes of the same frame left. Tasks with a callback run from
+ * RENDER_POST. Per-surface tasks are claimed by their owner in the render
+ * pass, where their framebuffer is at hand; they are only admitted in a pass
+ * of the monitor their owner last drew on, and an admission not claimed by
+ * the end of that pass lapses instead of holding budget for later ones.
+ */
+
+#include <hyprland/src/SharedDefs.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+enum eLiquidGlassTaskPriority : uint8_t {
+    TASK_PRIORITY_HIGH = 0,
+    TASK_PRIORITY_NORMAL,
+    TASK_PRIORITY_LOW,
+};
+
+class CLiquidGlassScheduler {
+  public:
+    using TaskID = uint32_t;
+
+    static constexpr TaskID INVALID_TASK = UINT32_MAX;
+
+    // Runs and times a claimed task; false when the task isn't admitted this frame
+    class CClaim {
+      public:
+        CClaim(CLiquidGlassScheduler* scheduler, TaskID task);
+        ~CClaim();
+
+        CClaim(const CClaim&)            = delete;
+        CClaim& operator=(const CClaim&) = delete;
+
+        explicit operator bool() const {
+            return m_scheduler != nullptr;
+        }
+
+      private:
+        CLiquidGlassScheduler*                m_scheduler = nullptr;
+        TaskID                                m_task      = INVALID_TASK;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // Every period, at most deadline late. Without run, the owner claims the task itself.
+    TaskID      add(const char* name, eLiquidGlassTaskPriority priority, std::chrono::milliseconds period, std::chrono::milliseconds deadline,
+                    std::function<void()> run = {});
+    void        remove(TaskID task);
+
+    // render: RENDER_PRE of each monitor's pass, admits the tasks that fit in what is left of the frame's budget
+    void        beginFrame();
+
+    // Per-surface tasks, in the render pass
+    CClaim      claim(TaskID task);
+
+    // render: RENDER_POST of each monitor's pass, runs the admitted tasks that have a callback
+    void        endFrame();
+
+    // hyprctl liquidglass stats
+    std::string getStats(eHyprCtlOutputFormat format) const;
+
+  private:
+    struct STask {
+        const char*                           name      = nullptr;
+        eLiquidGlassTaskPriority              priority  = TASK_PRIORITY_NORMAL;
+        std::chrono::steady_clock::duration   period{};
+        std::chrono::steady_clock::duration   deadline{};
+        std::chrono::steady_clock::time_point due;
+        std::chrono::nanoseconds              cost{}; // Moving average of the measured run time
+        std::function<void()>                 run;
+        uint64_t                              requested  = 0; // Frame the owner last tried to claim it
+        std::optional<MONITORID>              monitor;        // Where the owner last tried to claim it
+        uint64_t                              deferredIn = 0; // Frame it was last counted as deferred in
+        bool                                  active     = false;
+        bool                                  admitted   = false; // This pass
+        bool                                  forced     = false; // Admitted past its deadline
+    };
+
+    struct SCounters {
+        uint64_t                 runs     = 0;
+        uint64_t                 deferred = 0; // Due but over the budget
+        uint64_t                 forced   = 0; // Run over the budget past their deadline
+        std::chrono::nanoseconds spent{};
+    };
+
+    std::vector<STask>       m_tasks;
+    std::vector<TaskID>      m_free;
+    std::vector<TaskID>      m_due; // Planning scratch, kept for its capacity
+    uint32_t                 m_added      = 0;
+    uint64_t                 m_frameIndex = 0; // g_pGlobalState->frameClock's frame that m_frame belongs to
+
+    // Counters of the frame in progress, across every monitor's pass, and of the last complete one
+    SCounters                m_frame;
+    SCounters                m_last;
+    uint64_t                 m_deferredTotal = 0;
+    uint64_t                 m_forcedTotal   = 0;
+    std::chrono::nanoseconds m_peak{};
+
+    void                     finish(TaskID task, std::chrono::nanoseconds elapsed);
+    void                     closeFrame();
+    void                     defer(STask& task);
+};
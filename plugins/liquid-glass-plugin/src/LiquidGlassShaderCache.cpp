@@ -0,0 +1,327 @@
+#include "LiquidGlassShaderCache.hpp"
+#include "LiquidGlassWindows.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/render/OpenGL.hpp>
+#include <EGL/egl.h>
+#include <GLES2/gl2ext.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <wayland-server-core.h>
+
+// File header for cached binaries
+constexpr char     CACHE_MAGIC[4] = {'L', 'G', 'P', 'B'};
+constexpr uint64_t FNV_OFFSET     = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME      = 1099511628211ULL;
+
+// Without KHR_parallel_shader_compile: polls (preRenders) before a link status is asked for, outside the frame
+constexpr int BLIND_WAIT_POLLS = 8;
+
+static uint64_t fnv1a(uint64_t hash, const std::string& data) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= FNV_PRIME;
+    }
+
+    // Separator so ("ab", "c") and ("a", "bc") differ
+    hash ^= 0xFF;
+    hash *= FNV_PRIME;
+    return hash;
+}
+
+static std::string glString(GLenum name) {
+    const auto* str = reinterpret_cast<const char*>(glGetString(name));
+    return str ? str : "";
+}
+
+// Info log of a shader or program, through the matching pair of getters
+template <typename GetIv, typename GetLog>
+static std::string infoLog(GLuint object, GetIv getIv, GetLog getLog) {
+    GLint length = 0;
+    getIv(object, GL_INFO_LOG_LENGTH, &length);
+    if (length <= 1)
+        return {};
+
+    std::string log(length, '\0');
+    getLog(object, length, &length, log.data());
+    log.resize(length);
+    return log;
+}
+
+// ============================================================================
+// INITIALIZATION
+// ============================================================================
+
+void CLiquidGlassShaderCache::init() {
+    m_driverId = std::format("{}|{}|{}", glString(GL_VENDOR), glString(GL_RENDERER), glString(GL_VERSION));
+
+    // Let the driver compile on its own threads; we poll for completion
+    m_parallelCompile = glString(GL_EXTENSIONS).contains("GL_KHR_parallel_shader_compile");
+    if (m_parallelCompile) {
+        auto maxThreads = reinterpret_cast<PFNGLMAXSHADERCOMPILERTHREADSKHRPROC>(eglGetProcAddress("glMaxShaderCompilerThreadsKHR"));
+        if (maxThreads)
+            maxThreads(0xFFFFFFFF);
+    }
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    m_binarySupported = formats > 0;
+
+    const char* xdgCache = std::getenv("XDG_CACHE_HOME");
+    const char* home     = std::getenv("HOME");
+    if (xdgCache && *xdgCache)
+        m_cacheDir = std::format("{}/hyprland/liquid-glass", xdgCache);
+    else if (home && *home)
+        m_cacheDir = std::format("{}/.cache/hyprland/liquid-glass", home);
+}
+
+std::string CLiquidGlassShaderCache::cachePath(uint64_t key) const {
+    return std::format("{}/{:016x}.bin", m_cacheDir, key);
+}
+
+// ============================================================================
+// REQUESTS
+// ============================================================================
+
+void CLiquidGlassShaderCache::request(const std::string& name, const std::string& vertSrc, const std::string& fragSrc, std::function<void(GLuint)> onReady,
+                                      std::function<void(const std::string&)> onFail, bool persist) {
+    start(SJob{.name    = name,
+               .stages  = {{GL_VERTEX_SHADER, vertSrc}, {GL_FRAGMENT_SHADER, fragSrc}},
+               .persist = persist,
+               .onReady = std::move(onReady),
+               .onFail  = std::move(onFail)});
+}
+
+void CLiquidGlassShaderCache::requestCompute(const std::string& name, const std::string& compSrc, std::function<void(GLuint)> onReady,
+                                             std::function<void(const std::string&)> onFail, bool persist) {
+    start(SJob{.name = name, .stages = {{GL_COMPUTE_SHADER, compSrc}}, .persist = persist, .onReady = std::move(onReady), .onFail = std::move(onFail)});
+}
+
+void CLiquidGlassShaderCache::start(SJob job) {
+    // Key: driver identity + every stage's source
+    job.key = fnv1a(FNV_OFFSET, m_driverId);
+    for (const auto& [type, src] : job.stages)
+        job.key = fnv1a(job.key ^ type, src);
+
+    if (!job.persist || !m_binarySupported || m_cacheDir.empty()) {
+        compile(std::move(job));
+        return;
+    }
+
+    // The cached binary is read on the I/O worker; compile straight away if its queue is full
+    const uint64_t ID   = ++m_nextJob;
+    const auto     PATH = cachePath(job.key);
+    job.id              = ID;
+    m_reading.emplace_back(std::move(job));
+
+    if (!g_pGlobalState->io.readFile(PATH, [this, ID](std::optional<std::string> binary) { onBinaryRead(ID, std::move(binary)); }))
+        onBinaryRead(ID, std::nullopt);
+}
+
+void CLiquidGlassShaderCache::onBinaryRead(uint64_t id, std::optional<std::string> binary) {
+    const auto IT = std::ranges::find(m_reading, id, &SJob::id);
+    if (IT == m_reading.end())
+        return; // Cancelled
+
+    SJob job = std::move(*IT);
+    m_reading.erase(IT);
+
+    // Runs from the event loop, outside any frame
+    g_pHyprOpenGL->makeEGLCurrent();
+
+    if (binary && loadBinary(job, *binary)) {
+        job.onReady(job.program);
+        return;
+    }
+
+    compile(std::move(job));
+
+    // Polled from preRender, which needs a frame to come
+    CLiquidGlassWindows::damageAll(g_pGlobalState->decorations);
+}
+
+void CLiquidGlassShaderCache::compile(SJob job) {
+    job.program = glCreateProgram();
+
+    // Compile and link without asking for the status: that's what would block
+    for (const auto& [type, src] : job.stages) {
+        GLuint      shader = glCreateShader(type);
+        const char* str    = src.c_str();
+        glShaderSource(shader, 1, &str, nullptr);
+        glCompileShader(shader);
+        glAttachShader(job.program, shader);
+        job.shaders.push_back(shader);
+    }
+
+    // The sources aren't needed past this point
+    job.stages.clear();
+
+    if (m_binarySupported && job.persist)
+        glProgramParameteri(job.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+    glLinkProgram(job.program);
+
+    m_pending.emplace_back(std::move(job));
+}
+
+// ============================================================================
+// POLLING
+// ============================================================================
+
+void CLiquidGlassShaderCache::poll() {
+    if (m_pending.empty())
+        return;
+
+    // Without the extension there is no asking whether the link is done without waiting for it. Drivers
+    // that compile on their own threads anyway get a few frames first; the status query that may still
+    // wait is then made from an idle callback, after the frame, one program at a time.
+    if (!m_parallelCompile) {
+        bool waited = false;
+        for (auto& job : m_pending)
+            waited |= ++job.polls >= BLIND_WAIT_POLLS;
+
+        if (waited && !m_idle)
+            m_idle = wl_event_loop_add_idle(g_pCompositor->m_wlEventLoop, onIdle, this);
+        return;
+    }
+
+    std::vector<SJob> done;
+    std::erase_if(m_pending, [&](SJob& job) {
+        GLint complete = GL_FALSE;
+        glGetProgramiv(job.program, GL_COMPLETION_STATUS_KHR, &complete);
+        if (complete != GL_TRUE)
+            return false;
+
+        done.emplace_back(std::move(job));
+        return true;
+    });
+
+    // Callbacks may queue new requests, so run them outside the loop above
+    for (auto& job : done)
+        finish(job);
+}
+
+void CLiquidGlassShaderCache::onIdle(void* data) {
+    auto* cache   = static_cast<CLiquidGlassShaderCache*>(data);
+    cache->m_idle = nullptr;
+
+    const auto IT = std::ranges::find_if(cache->m_pending, [](const SJob& job) { return job.polls >= BLIND_WAIT_POLLS; });
+    if (IT == cache->m_pending.end())
+        return;
+
+    SJob job = std::move(*IT);
+    cache->m_pending.erase(IT);
+
+    g_pHyprOpenGL->makeEGLCurrent();
+    cache->finish(job);
+
+    // The rest wait for later frames' polls
+    if (!cache->m_pending.empty())
+        CLiquidGlassWindows::damageAll(g_pGlobalState->decorations);
+}
+
+void CLiquidGlassShaderCache::finish(SJob& job) {
+    GLint linked = GL_FALSE;
+    glGetProgramiv(job.program, GL_LINK_STATUS, &linked);
+
+    // The compiler's messages, only gathered on failure: the first failing stage's, else the linker's
+    std::string log;
+    if (linked != GL_TRUE) {
+        for (auto shader : job.shaders) {
+            GLint compiled = GL_FALSE;
+            glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+            if (compiled == GL_TRUE)
+                continue;
+
+            log = infoLog(shader, glGetShaderiv, glGetShaderInfoLog);
+            break;
+        }
+
+        if (log.empty())
+            log = infoLog(job.program, glGetProgramiv, glGetProgramInfoLog);
+    }
+
+    for (auto shader : job.shaders) {
+        glDetachShader(job.program, shader);
+        glDeleteShader(shader);
+    }
+    job.shaders.clear();
+
+    if (linked != GL_TRUE) {
+        glDeleteProgram(job.program);
+        job.program = 0;
+        job.onFail(log);
+        return;
+    }
+
+    storeBinary(job);
+    job.onReady(job.program);
+}
+
+void CLiquidGlassShaderCache::cancelAll() {
+    if (m_idle)
+        wl_event_source_remove(m_idle);
+    m_idle = nullptr;
+
+    for (auto& job : m_pending) {
+        for (auto shader : job.shaders)
+            glDeleteShader(shader);
+        glDeleteProgram(job.program);
+    }
+
+    m_pending.clear();
+    m_reading.clear();
+}
+
+// ============================================================================
+// BINARY CACHE
+// ============================================================================
+
+bool CLiquidGlassShaderCache::loadBinary(SJob& job, const std::string& file) {
+    GLenum format = 0;
+    if (file.size() <= sizeof(CACHE_MAGIC) + sizeof(format) || std::memcmp(file.data(), CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+        return false;
+
+    std::memcpy(&format, file.data() + sizeof(CACHE_MAGIC), sizeof(format));
+
+    const size_t OFFSET = sizeof(CACHE_MAGIC) + sizeof(format);
+    GLuint       prog   = glCreateProgram();
+    glProgramBinary(prog, format, file.data() + OFFSET, static_cast<GLsizei>(file.size() - OFFSET));
+
+    // Drivers reject binaries from other versions; fall back to compiling
+    GLint linked = GL_FALSE;
+    glGetProgramiv(prog, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        glDeleteProgram(prog);
+        g_pGlobalState->io.removeFile(cachePath(job.key));
+        return false;
+    }
+
+    job.program = prog;
+    return true;
+}
+
+void CLiquidGlassShaderCache::storeBinary(const SJob& job) {
+    if (!job.persist || !m_binarySupported || m_cacheDir.empty())
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(job.program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    // Header + binary in one buffer; the I/O worker creates the directory and writes it atomically
+    GLenum       format = 0;
+    const size_t OFFSET = sizeof(CACHE_MAGIC) + sizeof(format);
+    std::string  file(OFFSET + length, '\0');
+    glGetProgramBinary(job.program, length, &length, &format, file.data() + OFFSET);
+    file.resize(OFFSET + length);
+
+    std::memcpy(file.data(), CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    std::memcpy(file.data() + sizeof(CACHE_MAGIC), &format, sizeof(format));
+
+    g_pGlobalState->io.writeFile(cachePath(job.key), std::move(file));
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+/*
+ * Liquid Glass Shader Cache
+ * Builds the plugin's GL programs without blocking the compositor thread:
+ * linked programs are cached on disk with glGetProgramBinary (keyed by
+ * driver, renderer and source hash) and reloaded on later starts; cache
+ * misses compile through KHR_parallel_shader_compile when available and
+ * are polled once per frame until ready. Drivers without the extension
+ * get a few frames before the link status is read; that read can still
+ * wait, so it happens from an idle callback outside the frame, one program
+ * per frame.
+ * Cache files are read, written and removed on the I/O worker.
+ */
+
+#include <GLES3/gl32.h>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct wl_event_source;
+
+class CLiquidGlassShaderCache {
+  public:
+    // Read driver strings and extension support (needs a current GL context)
+    void init();
+
+    // Build a vertex + fragment program. onReady runs once it has linked, onFail with the compiler's log if it doesn't.
+    // Without persist the on-disk cache is bypassed: shader_dev_dir edits would pile up a binary per save.
+    void request(const std::string& name, const std::string& vertSrc, const std::string& fragSrc, std::function<void(GLuint)> onReady,
+                 std::function<void(const std::string&)> onFail, bool persist = true);
+
+    // Same for a compute program
+    void requestCompute(const std::string& name, const std::string& compSrc, std::function<void(GLuint)> onReady,
+                        std::function<void(const std::string&)> onFail, bool persist = true);
+
+    // Finish programs whose compile has completed; call once per frame
+    void poll();
+
+    bool hasPending() const {
+        return !m_pending.empty() || !m_reading.empty();
+    }
+
+    // Drop pending compiles (plugin unload)
+    void cancelAll();
+
+  private:
+    struct SJob {
+        std::string                                  name;
+        uint64_t                                     id      = 0;
+        uint64_t                                     key     = 0;
+        std::vector<std::pair<GLenum, std::string>> stages;
+        GLuint                                       program = 0;
+        std::vector<GLuint>                          shaders;
+        int                                          polls   = 0; // Without the extension: frames it has been given
+        bool                                         persist = true;
+        std::function<void(GLuint)>                  onReady;
+        std::function<void(const std::string&)>      onFail;
+    };
+
+    std::string       m_driverId;
+    std::string       m_cacheDir;
+    bool              m_parallelCompile = false;
+    bool              m_binarySupported = false;
+    uint64_t          m_nextJob         = 0;
+    std::vector<SJob> m_reading; // Waiting on the I/O worker for their cached binary
+    std::vector<SJob> m_pending;
+    wl_event_source*  m_idle = nullptr; // Without the extension: the link status query to come
+
+    void              start(SJob job);
+    void              onBinaryRead(uint64_t id, std::optional<std::string> binary);
+    void              compile(SJob job);
+    bool              loadBinary(SJob& job, const std::string& file);
+    void              storeBinary(const SJob& job);
+    void              finish(SJob& job);
+    static void       onIdle(void* data);
+
+    std::string       cachePath(uint64_t key) const;
+};
@@ -0,0 +1,535 @@
+#include "LiquidGlassShaderDev.hpp"
+#include "LiquidGlassDecoration.hpp"
+#include "LiquidGlassJSON.hpp"
+#include "globals.hpp"
+#include "shaders.hpp"
+
+#include <GLES2/gl2ext.h>
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/helpers/Color.hpp>
+#include <hyprland/src/render/OpenGL.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <string_view>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <wayland-server-core.h>
+
+// Compiler logs run to many lines; notifications get the first
+static std::string firstLine(const std::string& str) {
+    return str.substr(0, str.find('\n'));
+}
+
+// Each #include "<file>" line becomes that embedded file: the prelude the glass shaders share. Dev dir
+// sources get it too, always the embedded copy; an unknown file is left for the compiler to reject.
+static std::string resolveIncludes(const std::string& src) {
+    constexpr std::string_view DIRECTIVE = "#include \"";
+
+    std::string                result;
+    size_t                     at = 0;
+    while (at < src.size()) {
+        size_t           end  = src.find('\n', at);
+        end                   = end == std::string::npos ? src.size() : end + 1;
+        std::string_view line = std::string_view(src).substr(at, end - at);
+        at                    = end;
+
+        const size_t CLOSE = line.starts_with(DIRECTIVE) ? line.find('"', DIRECTIVE.size()) : std::string_view::npos;
+        const auto   IT    = CLOSE == std::string_view::npos ? SHADERS.end() : SHADERS.find(std::string(line.substr(DIRECTIVE.size(), CLOSE - DIRECTIVE.size())));
+        if (IT == SHADERS.end())
+            result += line;
+        else
+            result += IT->second;
+    }
+
+    return result;
+}
+
+CLiquidGlassShaderDev::CLiquidGlassShaderDev() : m_candidate(std::make_unique<SRimShader>()) {
+    ;
+}
+
+CLiquidGlassShaderDev::~CLiquidGlassShaderDev() = default;
+
+// ============================================================================
+// PROGRAMS
+// ============================================================================
+
+void CLiquidGlassShaderDev::add(const std::string& file, const std::string& embeddedSrc, const std::string& vertSrc, std::function<void(GLuint)> install) {
+    // Every program is built through here, so a dev dir version can never be overtaken by a late embedded one
+    auto& entry = m_entries.emplace_back(SEntry{.file = file, .embeddedSrc = embeddedSrc, .vertSrc = vertSrc, .install = std::move(install)});
+    compile(entry, embeddedSrc, false);
+}
+
+void CLiquidGlassShaderDev::setRimSetup(const std::string& file, std::function<void(GLuint, SRimShader&)> setup) {
+    m_rimFile  = file;
+    m_rimSetup = std::move(setup);
+}
+
+CLiquidGlassShaderDev::SEntry* CLiquidGlassShaderDev::find(const std::string& file) {
+    const auto IT = std::ranges::find(m_entries, file, &SEntry::file);
+    return IT == m_entries.end() ? nullptr : &*IT;
+}
+
+void CLiquidGlassShaderDev::compile(SEntry& entry, const std::string& src, bool fromDir) {
+    const uint64_t    GENERATION = ++entry.generation;
+    const std::string FILE       = entry.file;
+
+    auto              onReady = [this, FILE, GENERATION, fromDir](GLuint prog) {
+        auto* entry = find(FILE);
+        if (!entry || entry->generation != GENERATION) {
+            glDeleteProgram(prog);
+            return;
+        }
+
+        entry->install(prog);
+        entry->fromDir = fromDir;
+        entry->error.clear();
+
+        // Timings of the old rim program say nothing about the new one
+        if (FILE == m_rimFile)
+            resetTimings();
+
+        damageAll();
+        if (active())
+            HyprlandAPI::addNotification(PHANDLE, std::format("[{}] Reloaded {}", PLUGIN_NAME, FILE), CHyprColor{0.2, 0.8, 0.2, 1.0}, 2000);
+    };
+
+    auto onFail = [this, FILE, GENERATION](const std::string& log) {
+        auto* entry = find(FILE);
+        if (!entry || entry->generation != GENERATION)
+            return;
+
+        entry->error = log.empty() ? "link failed" : log;
+
+        const std::string DETAIL = active() ? std::format(", keeping the last good program: {}", firstLine(entry->error)) : "";
+        HyprlandAPI::addNotification(PHANDLE, std::format("[{}] Failed to compile shader: {}{}", PLUGIN_NAME, FILE, DETAIL), CHyprColor{1.0, 0.2, 0.2, 1.0}, 5000);
+    };
+
+    // Only the embedded shaders go into the on-disk cache: every save of a dev dir file is a new binary
+    auto&             cache    = g_pGlobalState->shaderCache;
+    const std::string RESOLVED = resolveIncludes(src);
+    if (entry.vertSrc.empty())
+        cache.requestCompute(FILE, RESOLVED, onReady, onFail, !fromDir);
+    else
+        cache.request(FILE, entry.vertSrc, RESOLVED, onReady, onFail, !fromDir);
+
+    // The compile finishes in a later frame's preRender; make sure there is one
+    damageAll();
+}
+
+void CLiquidGlassShaderDev::reload(SEntry& entry, bool fallback) {
+    // A file the directory doesn't have keeps the running program, or with fallback goes back to the embedded one
+    read(entry.file, [this, FILE = entry.file, fallback](std::optional<std::string> src) {
+        auto* entry = find(FILE);
+        if (!entry)
+            return;
+
+        if (src)
+            compile(*entry, *src, true);
+        else if (fallback && entry->fromDir)
+            compile(*entry, entry->embeddedSrc, false);
+    });
+}
+
+void CLiquidGlassShaderDev::restoreEmbedded() {
+    for (auto& entry : m_entries) {
+        if (entry.fromDir)
+            compile(entry, entry.embeddedSrc, false);
+    }
+}
+
+std::string CLiquidGlassShaderDev::path(const std::string& file) const {
+    return std::format("{}/{}", m_dir, file);
+}
+
+void CLiquidGlassShaderDev::read(const std::string& file, std::function<void(std::optional<std::string>)> done) {
+    // Read on the I/O worker; the answer comes back on the event loop, and is dropped if shader_dev_dir has moved since
+    auto onRead = [this, DIR = m_dir, done = std::move(done)](std::optional<std::string> src) {
+        if (DIR != m_dir)
+            return;
+
+        // An editor may leave a file empty for a moment while saving
+        if (src && src->empty())
+            src.reset();
+
+        g_pHyprOpenGL->makeEGLCurrent();
+        done(std::move(src));
+    };
+
+    if (!g_pGlobalState->io.readFile(path(file), onRead))
+        onRead(std::nullopt);
+}
+
+void CLiquidGlassShaderDev::damageAll() {
+    for (auto& deco : g_pGlobalState->decorations) {
+        if (auto locked = deco.lock())
+            locked->damageEntire();
+    }
+}
+
+// ============================================================================
+// WATCHING
+// ============================================================================
+
+bool CLiquidGlassShaderDev::active() const {
+    return m_inotify >= 0;
+}
+
+void CLiquidGlassShaderDev::onConfigReloaded() {
+    static auto* const PDIR = (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:shader_dev_dir")->getDataStaticPtr();
+
+    std::string        dir = *PDIR ? *PDIR : "";
+    if (dir.starts_with("~/")) {
+        const char* home = std::getenv("HOME");
+        dir              = std::string(home ? home : "") + dir.substr(1);
+    }
+    while (dir.size() > 1 && dir.ends_with('/'))
+        dir.pop_back();
+
+    if (dir == m_dir)
+        return;
+
+    g_pHyprOpenGL->makeEGLCurrent();
+
+    unwatch();
+    command("ab", "off", eHyprCtlOutputFormat::FORMAT_NORMAL);
+    m_dir = dir;
+
+    // Off: back to what was built into the plugin
+    if (m_dir.empty())
+        return restoreEmbedded();
+
+    watch(m_dir);
+    if (!active())
+        return restoreEmbedded();
+
+    // Files the directory has replace the embedded ones once read; the rest stay (or go back to) embedded
+    for (auto& entry : m_entries)
+        reload(entry, true);
+
+    resetTimings();
+}
+
+void CLiquidGlassShaderDev::watch(const std::string& dir) {
+    // Editors save in place (close after write) or through a rename; both are a new version
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotify >= 0 && inotify_add_watch(m_inotify, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR) >= 0)
+        m_source = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_inotify, WL_EVENT_READABLE, onWatchEvent, this);
+
+    if (m_source)
+        return;
+
+    unwatch();
+    HyprlandAPI::addNotification(PHANDLE, std::format("[{}] Cannot watch shader_dev_dir {}", PLUGIN_NAME, dir), CHyprColor{1.0, 0.2, 0.2, 1.0}, 5000);
+}
+
+void CLiquidGlassShaderDev::unwatch() {
+    if (m_source)
+        wl_event_source_remove(m_source);
+    if (m_inotify >= 0)
+        close(m_inotify);
+
+    m_source  = nullptr;
+    m_inotify = -1;
+}
+
+int CLiquidGlassShaderDev::onWatchEvent(int fd, uint32_t mask, void* data) {
+    static_cast<CLiquidGlassShaderDev*>(data)->readEvents();
+    return 0;
+}
+
+void CLiquidGlassShaderDev::readEvents() {
+    alignas(inotify_event) char buffer[4096];
+    std::vector<std::string>    changed;
+
+    while (true) {
+        const ssize_t LENGTH = read(m_inotify, buffer, sizeof(buffer));
+        if (LENGTH <= 0)
+            break;
+
+        for (ssize_t at = 0; at < LENGTH;) {
+            const auto* EVENT = reinterpret_cast<const inotify_event*>(buffer + at);
+            at += sizeof(inotify_event) + EVENT->len;
+
+            if (EVENT->len > 0 && std::ranges::find(changed, EVENT->name) == changed.end())
+                changed.emplace_back(EVENT->name);
+        }
+    }
+
+    for (const auto& name : changed) {
+        if (m_ab && name == m_candidateFile)
+            compileCandidate();
+        else if (auto* entry = find(name))
+            reload(*entry, false);
+    }
+}
+
+// ============================================================================
+// A/B
+// ============================================================================
+
+void CLiquidGlassShaderDev::compileCandidate() {
+    // Taken before the read so a newer save, or ab off, also drops a read still in flight
+    const uint64_t GENERATION = ++m_candidateGeneration;
+    read(m_candidateFile, [this, GENERATION](std::optional<std::string> src) {
+        if (GENERATION == m_candidateGeneration)
+            requestCandidate(GENERATION, src);
+    });
+}
+
+void CLiquidGlassShaderDev::requestCandidate(uint64_t generation, const std::optional<std::string>& src) {
+    const auto* RIM = find(m_rimFile);
+    if (!RIM || !m_rimSetup || !src) {
+        m_candidateError = std::format("cannot read {}", path(m_candidateFile));
+        return;
+    }
+
+    g_pGlobalState->shaderCache.request(
+        m_candidateFile, RIM->vertSrc, resolveIncludes(*src),
+        [this, generation](GLuint prog) {
+            if (generation != m_candidateGeneration) {
+                glDeleteProgram(prog);
+                return;
+            }
+
+            m_candidate->shader.destroy();
+            m_rimSetup(prog, *m_candidate);
+            m_candidateError.clear();
+            resetTimings();
+            damageAll();
+            HyprlandAPI::addNotification(PHANDLE, std::format("[{}] A/B: {} against {}", PLUGIN_NAME, m_rimFile, m_candidateFile), CHyprColor{0.2, 0.8, 0.2, 1.0}, 2000);
+        },
+        [this, generation](const std::string& log) {
+            if (generation != m_candidateGeneration)
+                return;
+
+            m_candidateError = log.empty() ? "link failed" : log;
+            HyprlandAPI::addNotification(PHANDLE, std::format("[{}] Failed to compile shader: {}: {}", PLUGIN_NAME, m_candidateFile, firstLine(m_candidateError)),
+                                         CHyprColor{1.0, 0.2, 0.2, 1.0}, 5000);
+        },
+        false);
+
+    damageAll();
+}
+
+SRimShader& CLiquidGlassShaderDev::rimShader() {
+    return m_variant == VARIANT_B ? *m_candidate : g_pGlobalState->rim;
+}
+
+void CLiquidGlassShaderDev::beginFrame() {
+    // RENDER_PRE comes once per monitor; whole frames across every monitor alternate, so the two
+    // programs see the same windows at the same sizes whatever the monitor count
+    m_frame   = g_pGlobalState->frameClock.frame();
+    m_variant = m_ab && m_candidate->shader.program && (m_frame & 1) ? VARIANT_B : VARIANT_A;
+}
+
+void CLiquidGlassShaderDev::endFrame() {
+    // Nothing else would redraw unchanged glass; both programs need a steady stream of frames to compare
+    if (m_ab && m_candidate->shader.program)
+        damageAll();
+}
+
+// ============================================================================
+// GPU TIMING
+// ============================================================================
+
+void CLiquidGlassShaderDev::beginTiming() {
+    if (!active())
+        return;
+
+    if (!m_probed) {
+        m_probed = true;
+
+        const auto* EXTENSIONS = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+        m_timerQueries         = EXTENSIONS && std::string_view(EXTENSIONS).contains("GL_EXT_disjoint_timer_query");
+        if (m_timerQueries) {
+            for (auto& query : m_queries)
+                glGenQueries(1, &query.id);
+        }
+    }
+
+    if (!m_timerQueries)
+        return;
+
+    // Results are read frames later; if every query is still in flight this draw goes untimed
+    if (m_queries[m_next].pending) {
+        ++m_dropped;
+        return;
+    }
+
+    glBeginQuery(GL_TIME_ELAPSED_EXT, m_queries[m_next].id);
+    m_timing = true;
+}
+
+void CLiquidGlassShaderDev::endTiming(double pixels) {
+    if (!m_timing)
+        return;
+
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+    m_timing = false;
+
+    auto& query   = m_queries[m_next];
+    query.pending = true;
+    query.discard = false;
+    query.variant = m_variant;
+    query.frame   = m_frame;
+    query.pixels  = pixels;
+    m_next        = (m_next + 1) % QUERY_COUNT;
+}
+
+void CLiquidGlassShaderDev::poll() {
+    if (!m_timerQueries)
+        return;
+
+    // A disjoint event (clock change, GPU reset) makes the results still in flight meaningless
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    if (disjoint) {
+        for (auto& query : m_queries)
+            query.discard |= query.pending;
+    }
+
+    // Queries finish in the order they were issued: stop at the first that hasn't
+    while (m_queries[m_oldest].pending) {
+        auto&  query     = m_queries[m_oldest];
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+
+        // 32 bits of nanoseconds hold a 4 s draw
+        GLuint ns = 0;
+        glGetQueryObjectuiv(query.id, GL_QUERY_RESULT, &ns);
+        query.pending = false;
+        m_oldest      = (m_oldest + 1) % QUERY_COUNT;
+
+        if (query.discard)
+            continue;
+
+        auto& timings = m_timings[query.variant];
+        timings.gpuNs += ns;
+        timings.pixels += query.pixels;
+        ++timings.draws;
+        if (timings.lastFrame != query.frame) {
+            ++timings.frames;
+            timings.lastFrame = query.frame;
+        }
+    }
+}
+
+void CLiquidGlassShaderDev::resetTimings() {
+    m_timings = {};
+    m_dropped = 0;
+
+    for (auto& query : m_queries)
+        query.discard |= query.pending;
+}
+
+// ============================================================================
+// HYPRCTL
+// ============================================================================
+
+std::string CLiquidGlassShaderDev::command(const std::string& action, const std::string& argument, eHyprCtlOutputFormat format) {
+    const bool JSON = format == eHyprCtlOutputFormat::FORMAT_JSON;
+
+    if (action == "reset")
+        resetTimings();
+    else if (action == "ab" && argument == "off") {
+        // Dropping the generation also discards a candidate still compiling
+        ++m_candidateGeneration;
+        m_ab = false;
+        m_candidate->shader.destroy();
+        m_candidateFile.clear();
+        m_candidateError.clear();
+        resetTimings();
+    } else if (action == "ab") {
+        if (!active())
+            return JSON ? R"({"error":"shader_dev_dir is not set"})" : "shader_dev_dir is not set\n";
+
+        // Candidates live next to the shaders: liquidglass.frag is compared with liquidglass.b.frag by default
+        const size_t DOT = m_rimFile.rfind('.');
+        m_candidateFile  = argument.empty() ? m_rimFile.substr(0, DOT) + ".b" + m_rimFile.substr(DOT) : argument;
+        if (m_candidateFile.contains('/')) {
+            m_candidateFile.clear();
+            return JSON ? R"({"error":"the candidate must be a file in shader_dev_dir"})" : "the candidate must be a file in shader_dev_dir\n";
+        }
+
+        m_ab = true;
+        compileCandidate();
+    } else if (!action.empty())
+        return "usage: hyprctl liquidglass shader [ab [file|off]|reset]\n";
+
+    // Status: where each shader comes from, then the rim timings
+    struct SRow {
+        const char*        variant;
+        const std::string& file;
+        const STimings&    timings;
+        std::string        state;
+    };
+
+    std::vector<SRow> rows = {{"A", m_rimFile, m_timings[VARIANT_A], ""}};
+    if (m_ab)
+        rows.push_back({"B", m_candidateFile, m_timings[VARIANT_B], !m_candidateError.empty() ? "failed" : m_candidate->shader.program ? "" : "compiling"});
+
+    const auto MS_PER_FRAME = [](const STimings& t) { return t.frames ? t.gpuNs / 1e6 / t.frames : 0.0; };
+    const auto US_PER_DRAW  = [](const STimings& t) { return t.draws ? t.gpuNs / 1e3 / t.draws : 0.0; };
+    const auto US_PER_MPX   = [](const STimings& t) { return t.pixels > 0 ? t.gpuNs / 1e3 / (t.pixels / 1e6) : 0.0; };
+
+    if (JSON) {
+        std::string result = std::format(R"({{"dir":"{}","watching":{},"timerQueries":{},"ab":{},"dropped":{},"shaders":[)", escapeJSON(m_dir), active(), m_timerQueries, m_ab,
+                                         m_dropped);
+        for (const auto& entry : m_entries)
+            result += std::format(R"({}{{"file":"{}","source":"{}","error":"{}"}})", &entry == &m_entries.front() ? "" : ",", escapeJSON(entry.file),
+                                  entry.fromDir ? "dir" : "embedded", escapeJSON(entry.error));
+
+        result += R"(],"timings":[)";
+        for (const auto& row : rows)
+            result += std::format(R"({}{{"variant":"{}","file":"{}","state":"{}","frames":{},"draws":{},"gpuMsPerFrame":{:.4f},"gpuUsPerDraw":{:.3f},"gpuUsPerMegapixel":{:.3f}}})",
+                                  &row == &rows.front() ? "" : ",", row.variant, escapeJSON(row.file), row.state, row.timings.frames, row.timings.draws,
+                                  MS_PER_FRAME(row.timings), US_PER_DRAW(row.timings), US_PER_MPX(row.timings));
+
+        return result + std::format(R"(],"candidateError":"{}"}})", escapeJSON(m_candidateError));
+    }
+
+    if (!active())
+        return "shader dev mode is off (set plugin:liquid-glass:shader_dev_dir)\n";
+
+    std::string result = std::format("shader dev dir: {}\n", m_dir);
+    for (const auto& entry : m_entries) {
+        result += std::format("  {:<28}{}\n", entry.file, entry.fromDir ? "dev dir" : "embedded");
+        if (!entry.error.empty())
+            result += std::format("    last save failed, running the previous version: {}\n", firstLine(entry.error));
+    }
+
+    if (m_probed && !m_timerQueries)
+        return result + "rim gpu timings: unavailable (no GL_EXT_disjoint_timer_query)\n";
+
+    result += std::format("\n{:<4}{:<28}{:>8}{:>8}{:>14}{:>14}{:>14}\n", "", "rim program", "frames", "draws", "gpu ms/frame", "gpu us/draw", "gpu us/Mpx");
+    for (const auto& row : rows) {
+        result += std::format("{:<4}{:<28}{:>8}{:>8}{:>14.4f}{:>14.3f}{:>14.3f}{}\n", row.variant, row.file, row.timings.frames, row.timings.draws,
+                              MS_PER_FRAME(row.timings), US_PER_DRAW(row.timings), US_PER_MPX(row.timings), row.state.empty() ? "" : "  (" + row.state + ")");
+    }
+
+    if (!m_candidateError.empty())
+        result += std::format("B: {}\n", firstLine(m_candidateError));
+    if (m_dropped)
+        result += std::format("untimed draws (all queries in flight): {}\n", m_dropped);
+
+    return result;
+}
+
+void CLiquidGlassShaderDev::destroy() {
+    unwatch();
+
+    ++m_candidateGeneration;
+    m_candidate->shader.destroy();
+
+    if (m_timerQueries) {
+        for (auto& query : m_queries)
+            glDeleteQueries(1, &query.id);
+    }
+
+    m_timerQueries = false;
+    m_probed       = false;
+}
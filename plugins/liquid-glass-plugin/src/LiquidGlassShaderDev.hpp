@@ -0,0 +1,144 @@
+#pragma once
+
+/*
+ * Liquid Glass Shader Dev Mode
+ * With plugin:liquid-glass:shader_dev_dir set, shaders come from that
+ * directory instead of the copies embedded at build time. Each save is seen
+ * through inotify, read on the I/O worker, recompiled through the shader
+ * cache (on the driver's threads where it can) and replaces the running
+ * program once linked; a shader that fails keeps the last good program and
+ * reports the compiler log.
+ *
+ * While the mode is on, the rim draws are timed on the GPU
+ * (EXT_disjoint_timer_query). An A/B run alternates the live rim program with
+ * a candidate file frame by frame, redrawing all glass every frame so both
+ * time the same work, and reports the two side by side.
+ */
+
+#include <GLES3/gl32.h>
+#include <hyprland/src/SharedDefs.hpp>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct SRimShader;
+struct wl_event_source;
+
+class CLiquidGlassShaderDev {
+  public:
+    CLiquidGlassShaderDev();
+    ~CLiquidGlassShaderDev();
+
+    // A shader the mode may replace. install takes over a linked program and releases the
+    // one it replaces; without a vertex source the file is a compute shader.
+    void        add(const std::string& file, const std::string& embeddedSrc, const std::string& vertSrc, std::function<void(GLuint)> install);
+
+    // How the rim program's uniform locations are set up, for the A/B candidate
+    void        setRimSetup(const std::string& file, std::function<void(GLuint, SRimShader&)> setup);
+
+    // configReloaded: starts, moves or stops watching shader_dev_dir
+    void        onConfigReloaded();
+
+    // render: RENDER_PRE and RENDER_POST
+    void        beginFrame();
+    void        endFrame();
+
+    // preRender: collects finished GPU timings without waiting for any
+    void        poll();
+
+    // The rim program to draw with this frame: the A/B candidate on every other frame
+    SRimShader& rimShader();
+
+    // Around the rim draws of one surface; pixels is the area drawn
+    void        beginTiming();
+    void        endTiming(double pixels);
+
+    // hyprctl liquidglass shader [ab [file|off]|reset]
+    std::string command(const std::string& action, const std::string& argument, eHyprCtlOutputFormat format);
+
+    void        destroy();
+
+  private:
+    struct SEntry {
+        std::string                 file;
+        std::string                 embeddedSrc;
+        std::string                 vertSrc;
+        std::function<void(GLuint)> install;
+        uint64_t                    generation = 0; // Compiles finishing for an older one are dropped
+        bool                        fromDir    = false;
+        std::string                 error;
+    };
+
+    enum eVariant : uint8_t {
+        VARIANT_A = 0, // Live rim program
+        VARIANT_B,     // A/B candidate
+    };
+
+    struct STimings {
+        uint64_t gpuNs     = 0;
+        uint64_t draws     = 0;
+        uint64_t frames    = 0;
+        double   pixels    = 0;
+        uint64_t lastFrame = UINT64_MAX;
+    };
+
+    struct SQuery {
+        GLuint   id      = 0;
+        bool     pending = false;
+        bool     discard = false; // The GPU reported a disjoint event while it ran
+        eVariant variant = VARIANT_A;
+        uint64_t frame   = 0;
+        double   pixels  = 0;
+    };
+
+    static constexpr size_t                  QUERY_COUNT = 128;
+
+    std::vector<SEntry>                      m_entries;
+    std::string                              m_rimFile;
+    std::function<void(GLuint, SRimShader&)> m_rimSetup;
+
+    std::string                              m_dir;
+    int                                      m_inotify = -1;
+    wl_event_source*                         m_source  = nullptr;
+
+    // A/B run
+    std::unique_ptr<SRimShader>              m_candidate;
+    std::string                              m_candidateFile;
+    std::string                              m_candidateError;
+    uint64_t                                 m_candidateGeneration = 0;
+    bool                                     m_ab                  = false;
+
+    // GPU timing
+    bool                                     m_timerQueries = false;
+    bool                                     m_probed       = false;
+    std::array<SQuery, QUERY_COUNT>          m_queries;
+    size_t                                   m_next    = 0; // Next query to start
+    size_t                                   m_oldest  = 0; // Next query to collect
+    bool                                     m_timing  = false;
+    uint64_t                                 m_dropped = 0; // Draws not timed: every query still in flight
+    std::array<STimings, 2>                  m_timings;
+    uint64_t                                 m_frame   = 0; // g_pGlobalState->frameClock's frame the draws belong to
+    eVariant                                 m_variant = VARIANT_A;
+
+    bool                                     active() const;
+    void                                     watch(const std::string& dir);
+    void                                     unwatch();
+    static int                               onWatchEvent(int fd, uint32_t mask, void* data);
+    void                                     readEvents();
+
+    void                                     reload(SEntry& entry, bool fallback);
+    void                                     restoreEmbedded();
+    void                                     compile(SEntry& entry, const std::string& src, bool fromDir);
+    void                                     compileCandidate();
+    void                                     requestCandidate(uint64_t generation, const std::optional<std::string>& src);
+    void                                     resetTimings();
+    void                                     damageAll();
+
+    std::string                              path(const std::string& file) const;
+    void                                     read(const std::string& file, std::function<void(std::optional<std::string>)> done);
+    SEntry*                                  find(const std::string& file);
+};
@@ -0,0 +1,156 @@
+#include "LiquidGlassTrace.hpp"
+#include "LiquidGlassJSON.hpp"
+#include "globals.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <format>
+
+static constexpr const char* SPAN_NAMES[] = {
+    "frame", "draw", "renderPass", "sampleBlit", "luminance", "computeBlur", "shaderDraw", "mergeDraw", "publish", "alloc",
+};
+
+// Rate limit for automatic dumps
+constexpr uint64_t AUTODUMP_INTERVAL_NS = 10'000'000'000ULL;
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+uint64_t CLiquidGlassTrace::now() {
+    static const auto EPOCH = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - EPOCH).count();
+}
+
+void CLiquidGlassTrace::record(eTraceSpan span, uint64_t startNs, uint64_t endNs, const char* label, int width, int height) {
+    static auto* const PTRACE = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:trace")->getDataStaticPtr();
+    if (!**PTRACE)
+        return;
+
+    // Claim a slot; the oldest event is overwritten once the ring wraps
+    const uint64_t INDEX = m_head.fetch_add(1, std::memory_order_relaxed);
+    auto&          event = m_events[INDEX % CAPACITY];
+
+    // Never cut a multi-byte UTF-8 character in half: back up to the start of the one that doesn't fit
+    size_t len = label ? strnlen(label, LABEL_MAX - 1) : 0;
+    if (label && label[len] != '\0') {
+        while (len > 0 && (static_cast<unsigned char>(label[len]) & 0xC0) == 0x80)
+            --len;
+    }
+
+    char text[LABEL_MAX] = {};
+    if (len)
+        std::memcpy(text, label, len);
+
+    // Seqlock write: readers drop slots whose sequence doesn't match before and after copying.
+    // The fence keeps the payload stores from becoming visible ahead of the cleared sequence.
+    event.seq.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.durationNs.store(static_cast<uint32_t>(std::min<uint64_t>(endNs - startNs, UINT32_MAX)), std::memory_order_relaxed);
+    event.span.store(span, std::memory_order_relaxed);
+    event.width.store(static_cast<uint16_t>(std::clamp(width, 0, 0xFFFF)), std::memory_order_relaxed);
+    event.height.store(static_cast<uint16_t>(std::clamp(height, 0, 0xFFFF)), std::memory_order_relaxed);
+    for (size_t i = 0; i < event.label.size(); ++i) {
+        uint64_t word;
+        std::memcpy(&word, text + i * 8, 8);
+        event.label[i].store(word, std::memory_order_relaxed);
+    }
+
+    event.seq.store(INDEX + 1, std::memory_order_release);
+}
+
+void CLiquidGlassTrace::beginFrame() {
+    m_frameStart = now();
+}
+
+void CLiquidGlassTrace::endFrame() {
+    static auto* const PAUTODUMP = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:trace_autodump_ms")->getDataStaticPtr();
+
+    if (!m_frameStart)
+        return;
+
+    const uint64_t END = now();
+    record(TRACE_FRAME, m_frameStart, END, nullptr, 0, 0);
+
+    // 0 = never
+    const uint64_t THRESHOLD = static_cast<uint64_t>(**PAUTODUMP * 1'000'000.0);
+    if (THRESHOLD > 0 && END - m_frameStart > THRESHOLD && (!m_lastAutoDump || END - m_lastAutoDump > AUTODUMP_INTERVAL_NS)) {
+        m_lastAutoDump = END;
+
+        const std::string PATH = dumpToFile();
+        if (!PATH.empty())
+            HyprlandAPI::addNotification(PHANDLE, std::format("[{}] Slow frame ({:.1f} ms), trace saved to {}", PLUGIN_NAME, (END - m_frameStart) / 1e6, PATH),
+                                         CHyprColor{1.0, 0.8, 0.2, 1.0}, 5000);
+    }
+
+    m_frameStart = 0;
+}
+
+CLiquidGlassTraceScope::CLiquidGlassTraceScope(eTraceSpan span, const char* label, const CBox& box) :
+    m_span(span), m_label(label), m_width(static_cast<int>(box.width)), m_height(static_cast<int>(box.height)), m_start(CLiquidGlassTrace::now()) {
+    ;
+}
+
+CLiquidGlassTraceScope::~CLiquidGlassTraceScope() {
+    if (g_pGlobalState)
+        g_pGlobalState->trace.record(m_span, m_start, CLiquidGlassTrace::now(), m_label, m_width, m_height);
+}
+
+// ============================================================================
+// EXPORT
+// ============================================================================
+
+std::string CLiquidGlassTrace::dump() const {
+    const uint64_t HEAD  = m_head.load(std::memory_order_acquire);
+    const uint64_t FIRST = HEAD > CAPACITY ? HEAD - CAPACITY : 0;
+
+    std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+    bool        first = true;
+
+    for (uint64_t i = FIRST; i < HEAD; ++i) {
+        const auto& EVENT = m_events[i % CAPACITY];
+
+        // Copy, then make sure the slot wasn't rewritten meanwhile
+        if (EVENT.seq.load(std::memory_order_acquire) != i + 1)
+            continue;
+
+        const uint64_t START    = EVENT.startNs.load(std::memory_order_relaxed);
+        const uint32_t DURATION = EVENT.durationNs.load(std::memory_order_relaxed);
+        const auto     SPAN     = EVENT.span.load(std::memory_order_relaxed);
+        const int      WIDTH = EVENT.width.load(std::memory_order_relaxed), HEIGHT = EVENT.height.load(std::memory_order_relaxed);
+        char           label[LABEL_MAX];
+        for (size_t j = 0; j < EVENT.label.size(); ++j) {
+            const uint64_t WORD = EVENT.label[j].load(std::memory_order_relaxed);
+            std::memcpy(label + j * 8, &WORD, 8);
+        }
+        label[LABEL_MAX - 1] = '\0';
+
+        // Orders the payload loads before the second sequence check
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (EVENT.seq.load(std::memory_order_relaxed) != i + 1)
+            continue;
+
+        json += std::format(R"({}{{"name":"{}","cat":"liquidglass","ph":"X","pid":1,"tid":1,"ts":{:.3f},"dur":{:.3f},"args":{{"window":"{}","w":{},"h":{}}}}})",
+                            first ? "" : ",", SPAN_NAMES[SPAN], START / 1000.0, DURATION / 1000.0, escapeJSON(label), WIDTH, HEIGHT);
+        first = false;
+    }
+
+    json += "]}";
+    return json;
+}
+
+std::string CLiquidGlassTrace::dumpToFile() const {
+    const auto        STAMP = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::string PATH  = std::format("/tmp/liquid-glass-trace-{}.json", STAMP);
+
+    // Serializing and writing the ring takes milliseconds: never on the frame that was slow
+    if (!g_pGlobalState->io.dumpTrace(*this, PATH))
+        return "";
+
+    return PATH;
+}
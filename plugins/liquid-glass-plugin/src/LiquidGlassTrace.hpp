@@ -0,0 +1,88 @@
+#pragma once
+
+/*
+ * Liquid Glass Flight Recorder
+ * Always-on, fixed-size ring of timed spans (draw, renderPass, sample blit,
+ * luminance, shader draw, publish, allocations, frames). Recording is a few
+ * stores into a preallocated slot; nothing is formatted until the ring is
+ * dumped as Chrome/Perfetto trace JSON.
+ */
+
+#include <hyprutils/math/Box.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+using namespace Hyprutils::Math;
+
+enum eTraceSpan : uint8_t {
+    TRACE_FRAME = 0,
+    TRACE_DRAW,
+    TRACE_RENDER_PASS,
+    TRACE_SAMPLE,
+    TRACE_LUMINANCE,
+    TRACE_COMPUTE_BLUR,
+    TRACE_SHADER,
+    TRACE_MERGE,
+    TRACE_PUBLISH,
+    TRACE_ALLOC,
+};
+
+class CLiquidGlassTrace {
+  public:
+    static constexpr size_t CAPACITY  = 8192;
+    static constexpr size_t LABEL_MAX = 32;
+    static_assert(LABEL_MAX % 8 == 0);
+
+    // Nanoseconds on the recorder's clock
+    static uint64_t now();
+
+    // Record a finished span (label may be null; it is truncated to at most LABEL_MAX - 1 bytes of whole UTF-8 characters)
+    void            record(eTraceSpan span, uint64_t startNs, uint64_t endNs, const char* label, int width, int height);
+
+    // Frame boundaries on the render thread; ending a frame over trace_autodump_ms writes the ring to disk
+    void            beginFrame();
+    void            endFrame();
+
+    // Chrome/Perfetto trace JSON of everything still in the ring
+    std::string     dump() const;
+
+    // Have the I/O worker write dump() to /tmp; returns the path (empty if its queue was full)
+    std::string     dumpToFile() const;
+
+  private:
+    // A seqlock slot: the dump reads while the render thread may be rewriting it, so every
+    // field is a relaxed atomic and seq tells the reader whether its copy is whole
+    struct SEvent {
+        std::atomic<uint64_t>                             seq{0}; // Index + 1 once the slot is fully written
+        std::atomic<uint64_t>                             startNs{0};
+        std::atomic<uint32_t>                             durationNs{0};
+        std::atomic<eTraceSpan>                           span{TRACE_FRAME};
+        std::atomic<uint16_t>                             width{0};
+        std::atomic<uint16_t>                             height{0};
+        std::array<std::atomic<uint64_t>, LABEL_MAX / 8> label = {}; // NUL-terminated, packed eight bytes a word
+    };
+
+    std::array<SEvent, CAPACITY> m_events;
+    std::atomic<uint64_t>        m_head{0};
+    uint64_t                     m_frameStart   = 0;
+    uint64_t                     m_lastAutoDump = 0;
+};
+
+// Records the span from construction to destruction
+class CLiquidGlassTraceScope {
+  public:
+    CLiquidGlassTraceScope(eTraceSpan span, const char* label = nullptr, const CBox& box = {});
+    ~CLiquidGlassTraceScope();
+
+    CLiquidGlassTraceScope(const CLiquidGlassTraceScope&)            = delete;
+    CLiquidGlassTraceScope& operator=(const CLiquidGlassTraceScope&) = delete;
+
+  private:
+    eTraceSpan  m_span;
+    const char* m_label;
+    int         m_width;
+    int         m_height;
+    uint64_t    m_start;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+/*
+ * Liquid Glass Window Bookkeeping
+ * The CPU work that grows with the number of windows rather than with
+ * pixels: checking a window for our decoration when it opens, dropping it
+ * when it closes, damaging every glass surface on a workspace switch, and
+ * the box each pass element reports every frame. Written against whatever
+ * window and decoration types it is given, so bench/ times this same code
+ * on a mock of Hyprland's.
+ */
+
+#include <hyprutils/math/Box.hpp>
+#include <algorithm>
+#include <vector>
+
+using namespace Hyprutils::Math;
+
+class CLiquidGlassWindows {
+  public:
+    // openWindow can arrive for a window that already has one
+    template <typename TWindow>
+    static bool hasDecoration(const TWindow& window) {
+        return std::ranges::any_of(window->m_windowDecorations, [](const auto& d) { return d->getDisplayName() == "LiquidGlass"; });
+    }
+
+    // Stop tracking window's decoration, and any whose window is already gone
+    template <typename TDecorations, typename TWindow>
+    static void forget(TDecorations& decorations, const TWindow& window) {
+        std::erase_if(decorations, [&window](const auto& deco) {
+            auto locked = deco.lock();
+            return !locked || locked->getOwner() == window;
+        });
+    }
+
+    template <typename TDecorations>
+    static void damageAll(TDecorations& decorations) {
+        for (auto& deco : decorations) {
+            if (auto locked = deco.lock())
+                locked->damageEntire();
+        }
+    }
+
+    // Window's main surface where it is drawn this frame: moved along with a sliding
+    // workspace unless pinned, and by its floating offset
+    template <typename TWindow>
+    static CBox glassBox(const TWindow& window) {
+        const auto PWINDOWWORKSPACE = window->m_workspace;
+        auto       surfaceBox       = window->getWindowMainSurfaceBox();
+
+        if (PWINDOWWORKSPACE && PWINDOWWORKSPACE->m_renderOffset->isBeingAnimated() && !window->m_pinned)
+            surfaceBox.translate(PWINDOWWORKSPACE->m_renderOffset->value());
+        surfaceBox.translate(window->m_floatingOffset);
+
+        return surfaceBox;
+    }
+};
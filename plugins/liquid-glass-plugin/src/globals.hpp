@@ -7,6 +7,19 @@
 
 #include <hyprland/src/plugins/PluginAPI.hpp>
 #include <hyprland/src/render/Shader.hpp>
+#include "LiquidGlassBufferBudget.hpp"
+#include "LiquidGlassComputeBlur.hpp"
+#include "LiquidGlassShaderCache.hpp"
+#include "LiquidGlassProfiles.hpp"
+#include "LiquidGlassMerge.hpp"
+#include "LiquidGlassAnimator.hpp"
+#include "LiquidGlassTrace.hpp"
+#include "LiquidGlassGLState.hpp"
+#include "LiquidGlassShaderDev.hpp"
+#include "LiquidGlassIOWorker.hpp"
+#include "LiquidGlassOcclusion.hpp"
+#include "LiquidGlassScheduler.hpp"
+#include "LiquidGlassFrameClock.hpp"
 #include <memory>
 #include <vector>
 
@@ -25,21 +38,49 @@ enum eLiquidGlassUniforms {
     LG_UNIFORM_FULL_SIZE_UNTRANSFORMED,
 };
 
+// The refractive rim program with its uniform locations (glass parameters live in the GlassParams uniform block)
+struct SRimShader {
+    SShader shader;
+    GLint   locTime                  = -1;
+    GLint   locWindowAlpha           = -1;
+    GLint   locFullSizeUntransformed = -1;
+    GLint   locBlurTex               = -1;
+    GLint   locPreBlurred            = -1;
+    GLint   locLOD                   = -1;
+    GLint   locShimmer               = -1;
+};
+
 struct SGlobalState {
     std::vector<WP<CLiquidGlassDecoration>> decorations;
-    SShader                                  shader;
-    float                                    startTime = 0.0f;
-    
-    // Shader uniform locations
-    GLint locTime                  = -1;
-    GLint locBlurStrength          = -1;
-    GLint locRefractionStrength    = -1;
-    GLint locChromaticAberration   = -1;
-    GLint locFresnelStrength       = -1;
-    GLint locSpecularStrength      = -1;
-    GLint locGlassOpacity          = -1;
-    GLint locEdgeThickness         = -1;
-    GLint locFullSizeUntransformed = -1;
+    SRimShader                               rim;
+    SShader                                  interiorShader;
+    SShader                                  mergeShader;
+    SShader                                  sampleShader;
+    CLiquidGlassShaderCache                  shaderCache;
+    CLiquidGlassProfiles                     profiles;
+    CLiquidGlassBufferBudget                 bufferBudget;
+    CLiquidGlassComputeBlur                  computeBlur;
+    CLiquidGlassMerge                        merge;
+    CLiquidGlassAnimator                     animator;
+    CLiquidGlassTrace                        trace;
+    CLiquidGlassGLState                      glState;
+    CLiquidGlassShaderDev                    shaderDev;
+    CLiquidGlassIOWorker                     io;
+    CLiquidGlassOcclusion                    occlusion;
+    CLiquidGlassScheduler                    scheduler;
+    CLiquidGlassFrameClock                   frameClock;
+
+    // Interior shader uniform locations
+    GLint locInteriorWindowAlpha = -1;
+    GLint locInteriorBlurTex     = -1;
+    GLint locInteriorPreBlurred  = -1;
+    GLint locInteriorLOD         = -1;
+    GLint locInteriorTime        = -1;
+    GLint locInteriorShimmer     = -1;
+
+    // Sample copy shader uniform locations
+    GLint locSampleSrcRect    = -1;
+    GLint locSampleDitherStep = -1;
 };
 
 inline HANDLE                        PHANDLE = nullptr;
@@ -10,6 +10,9 @@
  */
 
 #include "LiquidGlassDecoration.hpp"
+#include "LiquidGlassAllocCounter.hpp"
+#include "LiquidGlassPassElement.hpp"
+#include "LiquidGlassWindows.hpp"
 #include "globals.hpp"
 #include "shaders.hpp"
 
@@ -20,8 +23,11 @@
 #include <hyprland/src/render/Renderer.hpp>
 #include <hyprland/src/render/Shader.hpp>
 #include <hyprland/src/helpers/Color.hpp>
+#include <hyprutils/string/VarList.hpp>
 #include <chrono>
 
+using namespace Hyprutils::String;
+
 // ============================================================================
 // SHADER MANAGEMENT
 // ============================================================================
@@ -36,53 +42,120 @@ static std::string loadShader(const char* fileName) {
     throw std::runtime_error(message);
 }
 
-static void initShader() {
-    const char* shaderFile = "liquidglass.frag";
-    
-    GLuint prog = g_pHyprOpenGL->createProgram(
-        g_pHyprOpenGL->m_shaders->TEXVERTSRC, 
-        loadShader(shaderFile), 
-        true
-    );
-
-    if (prog == 0) {
-        const std::string message = std::format("[{}] Failed to compile shader: {}", PLUGIN_NAME, shaderFile);
-        HyprlandAPI::addNotification(PHANDLE, message, CHyprColor{1.0, 0.2, 0.2, 1.0}, 5000);
-        throw std::runtime_error(message);
-    }
-
-    g_pGlobalState->shader.program = prog;
+static void setupShader(GLuint prog, SShader& shader) {
+    shader.program = prog;
     
     // Get standard uniform locations
-    g_pGlobalState->shader.uniformLocations[SHADER_PROJ]       = glGetUniformLocation(prog, "proj");
-    g_pGlobalState->shader.uniformLocations[SHADER_POS_ATTRIB] = glGetAttribLocation(prog, "pos");
-    g_pGlobalState->shader.uniformLocations[SHADER_TEX_ATTRIB] = glGetAttribLocation(prog, "texcoord");
-    g_pGlobalState->shader.uniformLocations[SHADER_TEX]        = glGetUniformLocation(prog, "tex");
-    g_pGlobalState->shader.uniformLocations[SHADER_TOP_LEFT]   = glGetUniformLocation(prog, "topLeft");
-    g_pGlobalState->shader.uniformLocations[SHADER_FULL_SIZE]  = glGetUniformLocation(prog, "fullSize");
-    g_pGlobalState->shader.uniformLocations[SHADER_RADIUS]     = glGetUniformLocation(prog, "radius");
+    shader.uniformLocations[SHADER_PROJ]       = glGetUniformLocation(prog, "proj");
+    shader.uniformLocations[SHADER_POS_ATTRIB] = glGetAttribLocation(prog, "pos");
+    shader.uniformLocations[SHADER_TEX_ATTRIB] = glGetAttribLocation(prog, "texcoord");
+    shader.uniformLocations[SHADER_TEX]        = glGetUniformLocation(prog, "tex");
+    shader.uniformLocations[SHADER_TOP_LEFT]   = glGetUniformLocation(prog, "topLeft");
+    shader.uniformLocations[SHADER_FULL_SIZE]  = glGetUniformLocation(prog, "fullSize");
+    shader.uniformLocations[SHADER_RADIUS]     = glGetUniformLocation(prog, "radius");
+
+    // Create VAO
+    shader.createVao();
+}
+
+static void setupRimShader(GLuint prog, SRimShader& rim) {
+    setupShader(prog, rim.shader);
 
     // Get liquid glass specific uniform locations
-    g_pGlobalState->locTime                  = glGetUniformLocation(prog, "time");
-    g_pGlobalState->locBlurStrength          = glGetUniformLocation(prog, "blurStrength");
-    g_pGlobalState->locRefractionStrength    = glGetUniformLocation(prog, "refractionStrength");
-    g_pGlobalState->locChromaticAberration   = glGetUniformLocation(prog, "chromaticAberration");
-    g_pGlobalState->locFresnelStrength       = glGetUniformLocation(prog, "fresnelStrength");
-    g_pGlobalState->locSpecularStrength      = glGetUniformLocation(prog, "specularStrength");
-    g_pGlobalState->locGlassOpacity          = glGetUniformLocation(prog, "glassOpacity");
-    g_pGlobalState->locEdgeThickness         = glGetUniformLocation(prog, "edgeThickness");
-    g_pGlobalState->locFullSizeUntransformed = glGetUniformLocation(prog, "fullSizeUntransformed");
+    rim.locTime                  = glGetUniformLocation(prog, "time");
+    rim.locWindowAlpha           = glGetUniformLocation(prog, "windowAlpha");
+    rim.locFullSizeUntransformed = glGetUniformLocation(prog, "fullSizeUntransformed");
+    rim.locBlurTex               = glGetUniformLocation(prog, "blurTex");
+    rim.locPreBlurred            = glGetUniformLocation(prog, "preBlurred");
+    rim.locLOD                   = glGetUniformLocation(prog, "lod");
+    rim.locShimmer               = glGetUniformLocation(prog, "shimmerStrength");
+    CLiquidGlassProfiles::bindBlock(prog);
+}
 
-    // Create VAO
-    g_pGlobalState->shader.createVao();
+// The ready handlers also run for programs reloaded in shader dev mode: each releases the program it replaces
+
+static void onMainShaderReady(GLuint prog) {
+    const bool FIRST = !g_pGlobalState->rim.shader.program;
+
+    g_pGlobalState->rim.shader.destroy();
+    setupRimShader(prog, g_pGlobalState->rim);
+
+    // Glass was disabled until now
+    for (auto& deco : g_pGlobalState->decorations) {
+        if (auto locked = deco.lock())
+            locked->damageEntire();
+    }
+    g_pGlobalState->animator.wake();
+
+    if (FIRST)
+        HyprlandAPI::addNotification(PHANDLE, 
+            std::format("[{}] Shader initialized successfully", PLUGIN_NAME),
+            CHyprColor{0.2, 0.8, 0.2, 1.0}, 3000);
+}
+
+static void onInteriorShaderReady(GLuint prog) {
+    g_pGlobalState->interiorShader.destroy();
+    setupShader(prog, g_pGlobalState->interiorShader);
+
+    g_pGlobalState->locInteriorWindowAlpha = glGetUniformLocation(prog, "windowAlpha");
+    g_pGlobalState->locInteriorBlurTex     = glGetUniformLocation(prog, "blurTex");
+    g_pGlobalState->locInteriorPreBlurred  = glGetUniformLocation(prog, "preBlurred");
+    g_pGlobalState->locInteriorLOD         = glGetUniformLocation(prog, "lod");
+    g_pGlobalState->locInteriorTime        = glGetUniformLocation(prog, "time");
+    g_pGlobalState->locInteriorShimmer     = glGetUniformLocation(prog, "shimmerStrength");
+    CLiquidGlassProfiles::bindBlock(prog);
+}
 
-    // Store start time for animation
-    auto now = std::chrono::steady_clock::now();
-    g_pGlobalState->startTime = std::chrono::duration<float>(now.time_since_epoch()).count();
+static void onMergeShaderReady(GLuint prog) {
+    g_pGlobalState->mergeShader.destroy();
+    g_pGlobalState->sampleShader.destroy();
+    setupShader(prog, g_pGlobalState->mergeShader);
+    g_pGlobalState->merge.setProgram(prog);
+    CLiquidGlassProfiles::bindBlock(prog);
+}
+
+static void onSampleShaderReady(GLuint prog) {
+    g_pGlobalState->sampleShader.destroy();
+    setupShader(prog, g_pGlobalState->sampleShader);
+
+    g_pGlobalState->locSampleSrcRect    = glGetUniformLocation(prog, "srcRect");
+    g_pGlobalState->locSampleDitherStep = glGetUniformLocation(prog, "ditherStep");
+}
 
-    HyprlandAPI::addNotification(PHANDLE, 
-        std::format("[{}] Shader initialized successfully", PLUGIN_NAME),
-        CHyprColor{0.2, 0.8, 0.2, 1.0}, 3000);
+static void onBlurShaderReady(GLuint prog) {
+    g_pGlobalState->computeBlur.destroy();
+    g_pGlobalState->computeBlur.setProgram(prog);
+}
+
+static void initShader() {
+    // Programs come from the on-disk binary cache or compile in the background;
+    // glass stays disabled until the main program is ready. All of them go through
+    // shader dev mode, which swaps in versions from shader_dev_dir when it is set.
+    g_pGlobalState->shaderCache.init();
+
+    auto&             dev     = g_pGlobalState->shaderDev;
+    const std::string VERTSRC = g_pHyprOpenGL->m_shaders->TEXVERTSRC;
+
+    // Full shader: used on the refractive rim
+    dev.setRimSetup("liquidglass.frag", setupRimShader);
+    dev.add("liquidglass.frag", loadShader("liquidglass.frag"), VERTSRC, onMainShaderReady);
+
+    // Interior shader: cheap blur-and-tint for everything inside the rim (the rim shader covers it until ready)
+    dev.add("liquidglass_interior.frag", loadShader("liquidglass_interior.frag"), VERTSRC, onInteriorShaderReady);
+
+    // Merge shader: one pass for groups of nearby surfaces (they render separately until ready)
+    dev.add("liquidglass_merge.frag", loadShader("liquidglass_merge.frag"), VERTSRC, onMergeShaderReady);
+
+    // Dithered sample copy: samples of wide outputs are blitted undithered until ready
+    dev.add("liquidglass_sample.frag", loadShader("liquidglass_sample.frag"), VERTSRC, onSampleShaderReady);
+
+    // Compute blur for large surfaces: optional, the fragment blur covers everything without it
+    if (CLiquidGlassComputeBlur::probe()) {
+        dev.add("liquidglass_blur.comp", loadShader("liquidglass_blur.comp"), "", onBlurShaderReady);
+    } else {
+        HyprlandAPI::addNotification(PHANDLE, std::format("[{}] GLES 3.1 compute unavailable, using fragment blur only", PLUGIN_NAME),
+                                     CHyprColor{1.0, 0.8, 0.2, 1.0}, 3000);
+    }
 }
 
 // ============================================================================
@@ -93,8 +166,7 @@ static void onNewWindow(void* self, std::any data) {
     const auto PWINDOW = std::any_cast<PHLWINDOW>(data);
 
     // Check if decoration already exists
-    if (std::ranges::any_of(PWINDOW->m_windowDecorations,
-                            [](const auto& d) { return d->getDisplayName() == "LiquidGlass"; }))
+    if (CLiquidGlassWindows::hasDecoration(PWINDOW))
         return;
 
     // Create and attach decoration
@@ -102,28 +174,142 @@ static void onNewWindow(void* self, std::any data) {
     g_pGlobalState->decorations.emplace_back(deco);
     deco->m_self = deco;
     HyprlandAPI::addWindowDecoration(PHANDLE, PWINDOW, std::move(deco));
+
+    // New glass may need animating
+    g_pGlobalState->animator.wake();
 }
 
 static void onCloseWindow(void* self, std::any data) {
     const auto PWINDOW = std::any_cast<PHLWINDOW>(data);
 
     // Remove decoration from our tracking list
-    std::erase_if(g_pGlobalState->decorations, [PWINDOW](const auto& deco) {
-        auto locked = deco.lock();
-        return !locked || locked->getOwner() == PWINDOW;
-    });
+    CLiquidGlassWindows::forget(g_pGlobalState->decorations, PWINDOW);
+
+    // Glass it covered shows again
+    g_pGlobalState->animator.wake();
 }
 
 static void onWorkspaceChange(void* self, std::any data) {
     // Damage all liquid glass decorations to force refresh
-    for (auto& deco : g_pGlobalState->decorations) {
-        auto locked = deco.lock();
-        if (locked) {
-            locked->damageEntire();
-        }
+    CLiquidGlassWindows::damageAll(g_pGlobalState->decorations);
+
+    // Glass may have come out of occlusion
+    g_pGlobalState->animator.wake();
+}
+
+static void onPreConfigReload(void* self, std::any data) {
+    // Profiles are redefined by the config being loaded
+    g_pGlobalState->profiles.onPreConfigReload();
+}
+
+static void onConfigReloaded(void* self, std::any data) {
+    // Global values may have changed; profile buffers re-upload on next draw
+    g_pGlobalState->profiles.onConfigReloaded();
+
+    // shader_dev_dir may have been set, moved or cleared
+    g_pGlobalState->shaderDev.onConfigReloaded();
+
+    // The animated mode may have been switched on
+    g_pGlobalState->animator.wake();
+}
+
+static void onInput(void* self, std::any data) {
+    // Only resets the idle clock (and restarts the animator if it had idled out)
+    g_pGlobalState->animator.onInput();
+}
+
+static void onPreRender(void* self, std::any data) {
+    // Finish any shader compiles that completed since last frame
+    g_pGlobalState->shaderCache.poll();
+    g_pGlobalState->shaderDev.poll();
+
+    const auto PMONITOR = std::any_cast<PHLMONITOR>(data);
+
+    // Advance the buffer budget's LRU clock once per frame, not per monitor (enforcing it is a scheduled task)
+    if (g_pGlobalState->frameClock.onPreRender(PMONITOR))
+        g_pGlobalState->bufferBudget.onFrame();
+
+    // Regroup nearby glass surfaces on the monitor about to render
+    if (PMONITOR)
+        g_pGlobalState->merge.update(PMONITOR);
+}
+
+// Scheduled once a second: with stats_file set, hand the counters to the I/O worker
+static void publishStats() {
+    static auto* const PSTATSFILE = (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:liquid-glass:stats_file")->getDataStaticPtr();
+
+    const std::string_view PATH = *PSTATSFILE;
+    if (PATH.empty())
+        return;
+
+    const auto& BUDGET = g_pGlobalState->bufferBudget;
+    const auto& GL     = g_pGlobalState->glState;
+    g_pGlobalState->io.writeStats({BUDGET.count(), BUDGET.usage(), BUDGET.peak(), BUDGET.evictions(), GL.lastChanges(), GL.lastSkipped()}, PATH);
+}
+
+static void onRender(void* self, std::any data) {
+    // Frame span for the flight recorder, frame tally for the allocation counter, periodic work within the frame budget
+    const auto STAGE = std::any_cast<eRenderStage>(data);
+
+    if (STAGE == RENDER_PRE) {
+        g_pGlobalState->trace.beginFrame();
+        g_pGlobalState->shaderDev.beginFrame();
+        g_pGlobalState->scheduler.beginFrame();
+    } else if (STAGE == RENDER_POST) {
+        g_pGlobalState->scheduler.endFrame();
+        g_pGlobalState->trace.endFrame();
+        g_pGlobalState->shaderDev.endFrame();
+        g_pGlobalState->glState.onFrame();
+        g_pGlobalState->occlusion.onFrame();
+        CLiquidGlassAllocCounter::onFrame();
     }
 }
 
+// ============================================================================
+// HYPRCTL
+// ============================================================================
+
+// hyprctl liquidglass <subcommand>
+static std::string onHyprCtl(eHyprCtlOutputFormat format, std::string request) {
+    CVarList args(request, 0, ' ');
+
+    // Buffer budget, GL state, occlusion, scheduler and I/O worker counters; with -j one object, each module's under its own key
+    if (args[1] == "stats") {
+        const std::string BUDGET    = g_pGlobalState->bufferBudget.getStats(format);
+        const std::string GL        = g_pGlobalState->glState.getStats(format);
+        const std::string OCCLUSION = g_pGlobalState->occlusion.getStats(format);
+        const std::string SCHEDULER = g_pGlobalState->scheduler.getStats(format);
+        const std::string IO        = g_pGlobalState->io.getStats(format);
+
+        if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+            return std::format(R"({{"budget":{},"gl":{},"occlusion":{},"scheduler":{},"io":{}}})", BUDGET, GL, OCCLUSION, SCHEDULER, IO);
+
+        return BUDGET + GL + OCCLUSION + SCHEDULER + IO;
+    }
+
+    // Fragment vs compute blur GPU timings ("bench run" starts a measurement)
+    if (args[1] == "bench")
+        return g_pGlobalState->computeBlur.benchmark(args[2], format);
+
+    // Chrome/Perfetto trace JSON (load in ui.perfetto.dev or chrome://tracing)
+    if (args[1] == "trace")
+        return g_pGlobalState->trace.dump();
+
+    // Render path heap allocations per frame ("allocs reset" restarts the tally)
+    if (args[1] == "allocs") {
+        if (args[2] == "reset")
+            CLiquidGlassAllocCounter::reset();
+
+        return CLiquidGlassAllocCounter::getStats(format);
+    }
+
+    // Shader dev mode: where each shader comes from, rim GPU timings, A/B runs
+    if (args[1] == "shader")
+        return g_pGlobalState->shaderDev.command(args[2], args[3], format);
+
+    return "usage: hyprctl liquidglass [stats|bench [run]|trace|allocs [reset]|shader [ab [file|off]|reset]]\n";
+}
+
 // ============================================================================
 // PLUGIN API
 // ============================================================================
@@ -150,6 +336,9 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     // Initialize global state
     g_pGlobalState = std::make_unique<SGlobalState>();
 
+    // All file I/O from here on goes through the I/O worker
+    g_pGlobalState->io.start();
+
     // Initialize shader
     initShader();
 
@@ -167,6 +356,45 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
         PHANDLE, "workspace",
         [&](void* self, SCallbackInfo& info, std::any data) { onWorkspaceChange(self, data); });
 
+    static auto P4 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "preRender",
+        [&](void* self, SCallbackInfo& info, std::any data) { onPreRender(self, data); });
+
+    static auto P5 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "preConfigReload",
+        [&](void* self, SCallbackInfo& info, std::any data) { onPreConfigReload(self, data); });
+
+    static auto P6 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "configReloaded",
+        [&](void* self, SCallbackInfo& info, std::any data) { onConfigReloaded(self, data); });
+
+    // Any input keeps the animated glass mode out of idle
+    static auto P7 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "mouseMove",
+        [&](void* self, SCallbackInfo& info, std::any data) { onInput(self, data); });
+
+    static auto P8 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "mouseButton",
+        [&](void* self, SCallbackInfo& info, std::any data) { onInput(self, data); });
+
+    static auto P9 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "mouseAxis",
+        [&](void* self, SCallbackInfo& info, std::any data) { onInput(self, data); });
+
+    static auto P10 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "keyPress",
+        [&](void* self, SCallbackInfo& info, std::any data) { onInput(self, data); });
+
+    static auto P11 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "touchDown",
+        [&](void* self, SCallbackInfo& info, std::any data) { onInput(self, data); });
+
+    static auto P12 = HyprlandAPI::registerCallbackDynamic(
+        PHANDLE, "render",
+        [&](void* self, SCallbackInfo& info, std::any data) { onRender(self, data); });
+
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{"liquidglass", false, onHyprCtl});
+
     // Register configuration values with Apple-tuned defaults
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:enabled", Hyprlang::INT{1});
     
@@ -191,6 +419,65 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     // Edge thickness: Thin crisp edges like Apple
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:edge_thickness", Hyprlang::FLOAT{0.10});
 
+    // VRAM budget for all glass buffers in MB (0 = unlimited), LRU-evicted when exceeded
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:vram_budget_mb", Hyprlang::INT{128});
+
+    // Named parameter profiles, assigned to windows tagged glass-<name>
+    HyprlandAPI::addConfigKeyword(PHANDLE, "plugin:liquid-glass:profile",
+        [](const char* key, const char* value) { return g_pGlobalState->profiles.onProfileKeyword(value); },
+        Hyprlang::SHandlerOptions{});
+
+    // Surfaces at least this many pixels blur through the compute path when available (0 = never)
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:compute_blur_min_area", Hyprlang::INT{1000000});
+
+    // Glass surfaces closer than this (logical px) render as one merged shape (0 = never). Off by
+    // default: every window has glass, so any distance over the gaps would fuse ordinary tiled windows.
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:merge_distance", Hyprlang::INT{0});
+
+    // Format of the background samples: auto (8 bits per channel on 10-bit and half-float outputs), source or 8888
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:sample_format", Hyprlang::STRING{"auto"});
+
+    // Reduced quality while workspace slides, moves and resizes animate
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:motion_lod", Hyprlang::INT{1});
+
+    // Background sample resolution while in motion (fraction of full size)
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:motion_lod_scale", Hyprlang::FLOAT{0.5});
+
+    // Crossfade back to full quality after the animation settles, in ms
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:motion_lod_fade_ms", Hyprlang::INT{200});
+
+    // Animated glass: subtle shimmer redrawn at its own frame cap (glass boxes only)
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:animate", Hyprlang::INT{0});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:animate_fps", Hyprlang::INT{30});
+
+    // Seconds without input before the animation pauses (0 = never)
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:animate_idle_timeout", Hyprlang::INT{10});
+
+    // Flight recorder: keep the last few thousand render spans for hyprctl liquidglass trace
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:trace", Hyprlang::INT{1});
+
+    // Frames slower than this (ms) dump the recorder to /tmp (0 = never)
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:trace_autodump_ms", Hyprlang::FLOAT{0});
+
+    // Shader dev mode: load shaders from this directory and reload them on save (empty = embedded shaders)
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:shader_dev_dir", Hyprlang::STRING{""});
+
+    // Don't sample or shade glass the window's opaque content covers
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:skip_opaque", Hyprlang::INT{1});
+
+    // Write buffer and GL state counters to this file once a second (empty = off)
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:stats_file", Hyprlang::STRING{""});
+
+    // Time per frame for periodic work (luminance readbacks, stats, buffer reclamation) in us (0 = unlimited)
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:liquid-glass:frame_budget_us", Hyprlang::INT{500});
+
+    // Global periodic work; each surface schedules its own luminance readback
+    auto& scheduler = g_pGlobalState->scheduler;
+    scheduler.add("reclaim", TASK_PRIORITY_HIGH, std::chrono::milliseconds(250), std::chrono::seconds(1), [] { g_pGlobalState->bufferBudget.reclaim(); });
+    scheduler.add("stats", TASK_PRIORITY_LOW, std::chrono::seconds(1), std::chrono::seconds(2), publishStats);
+
+    g_pGlobalState->animator.init();
+
     // Apply to existing windows
     for (auto& w : g_pCompositor->m_windows) {
         if (w->isHidden() || !w->m_isMapped)
@@ -221,9 +508,22 @@ APICALL EXPORT void PLUGIN_EXIT() {
 
     // Remove all our pass elements
     g_pHyprRenderer->m_renderPass.removeAllOfType("CLiquidGlassPassElement");
+    CLiquidGlassPassElement::releasePool();
     
-    // Destroy shader
-    g_pGlobalState->shader.destroy();
+    // Destroy shaders
+    g_pGlobalState->animator.destroy();
+    g_pGlobalState->shaderCache.cancelAll();
+    g_pGlobalState->shaderDev.destroy();
+    g_pGlobalState->rim.shader.destroy();
+    g_pGlobalState->interiorShader.destroy();
+    g_pGlobalState->mergeShader.destroy();
+    g_pGlobalState->sampleShader.destroy();
+    g_pGlobalState->merge.destroy();
+    g_pGlobalState->computeBlur.destroy();
+    g_pGlobalState->profiles.destroy();
+
+    // Write out anything still queued (the trace ring it may read is still alive)
+    g_pGlobalState->io.stop();
     
     // Reset global state
     g_pGlobalState.reset();
@@ -20,22 +20,21 @@ precision highp float;
  * 5. Subtle interior blur for glass thickness
  */
 
+#include "liquidglass_common.glsl"
+
 // Uniforms
 uniform sampler2D tex;
 uniform vec2 topLeft;
 uniform vec2 fullSize;
 uniform vec2 fullSizeUntransformed;
 uniform float radius;
-uniform float time;
 
-// Configurable parameters
-uniform float blurStrength;        // Interior blur amount (0.0 - 2.0)
-uniform float refractionStrength;  // Edge refraction intensity (0.0 - 0.15)
-uniform float chromaticAberration; // RGB separation amount (0.0 - 0.02)
-uniform float fresnelStrength;     // Edge glow intensity (0.0 - 1.0)
-uniform float specularStrength;    // Highlight brightness (0.0 - 1.0)
-uniform float glassOpacity;        // Overall glass opacity (0.0 - 1.0)
-uniform float edgeThickness;       // How thick the refractive edge is (0.0 - 0.3)
+// Pre-blurred background from the compute blur path (preBlurred == 1)
+uniform sampler2D blurTex;
+uniform int preBlurred;
+
+uniform float windowAlpha;         // Window opacity, applied on top of glassOpacity
+uniform float lod;                 // Motion level of detail: 0 = full quality, 1 = reduced (no chromatic, 3-tap blur)
 
 in vec2 v_texcoord;
 layout(location = 0) out vec4 fragColor;
@@ -284,6 +283,27 @@ vec3 fastBlur(vec2 uv, vec2 texelSize, float strength) {
     return result;
 }
 
+// 3-tap blur used while the surface is in motion
+vec3 cheapBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off = vec2(2.0) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.4;
+    result += texture(tex, clamp(uv + off, 0.0, 1.0)).rgb * 0.3;
+    result += texture(tex, clamp(uv - off, 0.0, 1.0)).rgb * 0.3;
+
+    return result;
+}
+
+// Crossfade between the full and reduced blur (lod is uniform, so the branches are coherent)
+vec3 lodBlur(vec2 uv, vec2 texelSize, float strength) {
+    if (lod <= 0.0)
+        return fastBlur(uv, texelSize, strength);
+    if (lod >= 1.0)
+        return cheapBlur(uv, texelSize, strength);
+
+    return mix(fastBlur(uv, texelSize, strength), cheapBlur(uv, texelSize, strength), lod);
+}
+
 // ============================================================================
 // COLOR SMOOTHING - Create water-like fluid appearance
 // ============================================================================
@@ -447,19 +467,26 @@ void main() {
     // ========================================
     // 2. CHROMATIC DISPERSION - Color separation
     // ========================================
-    vec2 edgeNormal = getEdgeNormal(uv);
-    float chromaStrength = length(borderRefract) * chromaticAberration * 2.0;
-    
-    float r = texture(tex, clamp(refractedUV - edgeNormal * chromaStrength * 0.8, 0.0, 1.0)).r;
-    float g = texture(tex, clamp(refractedUV, 0.0, 1.0)).g;
-    float b = texture(tex, clamp(refractedUV + edgeNormal * chromaStrength * 1.2, 0.0, 1.0)).b;
-    
-    vec3 refractedColor = vec3(r, g, b);
+    // Faded out with the motion LOD; skipped entirely while in motion
+    vec3 refractedColor;
+    if (lod >= 1.0) {
+        refractedColor = texture(tex, refractedUV).rgb;
+    } else {
+        vec2 edgeNormal = getEdgeNormal(uv);
+        float chromaStrength = length(borderRefract) * chromaticAberration * 2.0 * (1.0 - lod);
+
+        float r = texture(tex, clamp(refractedUV - edgeNormal * chromaStrength * 0.8, 0.0, 1.0)).r;
+        float g = texture(tex, clamp(refractedUV, 0.0, 1.0)).g;
+        float b = texture(tex, clamp(refractedUV + edgeNormal * chromaStrength * 1.2, 0.0, 1.0)).b;
+
+        refractedColor = vec3(r, g, b);
+    }
     
     // ========================================
     // 3. BLUR - Frosted glass effect
     // ========================================
-    vec3 blurredColor = fastBlur(refractedUV, texelSize, blurStrength);
+    vec3 blurredColor = preBlurred == 1 ? texture(blurTex, refractedUV).rgb
+                                        : lodBlur(refractedUV, texelSize, blurStrength);
     
     // Mix refracted and blurred
     vec3 glassColor = mix(blurredColor, refractedColor, 0.4);
@@ -474,6 +501,10 @@ void main() {
     float depthBrightness = mix(0.98, 1.02, depthFactor);
     glassColor *= depthBrightness;
     
+    // Animated shimmer (skipped entirely when off)
+    if (shimmerStrength > 0.0)
+        glassColor *= 1.0 + shimmerStrength * shimmer(uv * fullSize) * 0.04;
+
     // ========================================
     // 7. FINAL ADJUSTMENTS
     // ========================================
@@ -484,7 +515,459 @@ void main() {
     // Clamp to valid range
     finalColor = clamp(finalColor, 0.0, 1.0);
      
-    fragColor = vec4(finalColor, glassOpacity * cornerAlpha);
+    fragColor = vec4(finalColor, glassOpacity * windowAlpha * cornerAlpha);
+}
+)GLSL"},
+    {"liquidglass_interior.frag", R"GLSL(
+#version 300 es
+precision highp float;
+
+/*
+ * Liquid Glass Interior Fragment Shader
+ *
+ * Cheap blur-and-tint path for the part of the glass that lies deeper than
+ * the refractive border band. There, liquidglass.frag has no refraction,
+ * chromatic dispersion, corner masking or edge brightening, so this shader
+ * reproduces its output exactly with only the blur and tint steps.
+ */
+
+#include "liquidglass_common.glsl"
+
+// Uniforms
+uniform sampler2D tex;
+uniform vec2 fullSize;
+
+// Pre-blurred background from the compute blur path (preBlurred == 1)
+uniform sampler2D blurTex;
+uniform int preBlurred;
+
+uniform float windowAlpha;         // Window opacity, applied on top of glassOpacity
+uniform float lod;                 // Motion level of detail, as in liquidglass.frag
+
+in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+// Same 5-tap blur as liquidglass.frag
+vec3 fastBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off1 = vec2(1.3846153846) * texelSize * strength;
+    vec2 off2 = vec2(3.2307692308) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.2270270270;
+    result += texture(tex, clamp(uv + off1, 0.0, 1.0)).rgb * 0.3162162162;
+    result += texture(tex, clamp(uv - off1, 0.0, 1.0)).rgb * 0.3162162162;
+    result += texture(tex, clamp(uv + off2, 0.0, 1.0)).rgb * 0.0702702703;
+    result += texture(tex, clamp(uv - off2, 0.0, 1.0)).rgb * 0.0702702703;
+
+    return result;
+}
+
+// Same 3-tap motion blur and crossfade as liquidglass.frag
+vec3 cheapBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off = vec2(2.0) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.4;
+    result += texture(tex, clamp(uv + off, 0.0, 1.0)).rgb * 0.3;
+    result += texture(tex, clamp(uv - off, 0.0, 1.0)).rgb * 0.3;
+
+    return result;
+}
+
+vec3 lodBlur(vec2 uv, vec2 texelSize, float strength) {
+    if (lod <= 0.0)
+        return fastBlur(uv, texelSize, strength);
+    if (lod >= 1.0)
+        return cheapBlur(uv, texelSize, strength);
+
+    return mix(fastBlur(uv, texelSize, strength), cheapBlur(uv, texelSize, strength), lod);
+}
+
+void main() {
+    vec2 uv = clamp(v_texcoord, 0.001, 0.999);
+    vec2 texelSize = 1.0 / fullSize;
+
+    // Blur mixed with the unrefracted sample, as in the full shader
+    vec3 blurredColor = preBlurred == 1 ? texture(blurTex, uv).rgb : lodBlur(uv, texelSize, blurStrength);
+    vec3 glassColor = mix(blurredColor, texture(tex, uv).rgb, 0.4);
+
+    // Interior depth brightness and cool glass tint
+    glassColor *= 0.98;
+    if (shimmerStrength > 0.0)
+        glassColor *= 1.0 + shimmerStrength * shimmer(v_texcoord * fullSize) * 0.04;
+
+    vec3 finalColor = glassColor * vec3(0.99, 0.995, 1.0);
+    finalColor = clamp(finalColor, 0.0, 1.0);
+
+    fragColor = vec4(finalColor, glassOpacity * windowAlpha);
+}
+)GLSL"},
+    {"liquidglass_merge.frag", R"GLSL(
+#version 300 es
+precision highp float;
+
+/*
+ * Liquid Glass Merge Fragment Shader
+ *
+ * Renders a group of nearby glass surfaces as one shape: the smooth union
+ * of their rounded-rect SDFs, so neighbouring surfaces bridge into each
+ * other like liquid. Each member draws it scissored to its own box, from a
+ * sample of the group's box taken just before, then the part of the bridges
+ * closest to it.
+ *
+ * Same refraction, dispersion, blur and tint as liquidglass.frag, with the
+ * edge measured in pixels against the union shape.
+ */
+
+#define MAX_MEMBERS 4
+
+#include "liquidglass_common.glsl"
+
+// Uniforms
+uniform sampler2D tex;
+uniform vec2 fullSize;             // Group bounding box in pixels
+
+uniform int memberCount;
+uniform vec4 memberRects[MAX_MEMBERS];   // x, y, w, h in pixels, relative to the bounding box
+uniform float memberRadii[MAX_MEMBERS];  // Corner radius in pixels
+uniform float smoothness;          // Smooth-union radius in pixels
+uniform float refHeight;           // Pixel height that edgeThickness is relative to
+uniform int bridgeOwner;           // >= 0: only bridges closest to this member, outside every member's rect
+
+// Pre-blurred background from the compute blur path (preBlurred == 1)
+uniform sampler2D blurTex;
+uniform int preBlurred;
+
+uniform float windowAlpha;         // Window opacity, applied on top of glassOpacity
+uniform float lod;                 // Motion level of detail, as in liquidglass.frag
+
+in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+// ============================================================================
+// SHAPE
+// ============================================================================
+
+float roundedBoxSDF(vec2 p, vec2 halfSize, float r) {
+    vec2 q = abs(p) - halfSize + r;
+    return min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - r;
+}
+
+// Polynomial smooth minimum
+float smoothMin(float a, float b, float k) {
+    if (k <= 0.0)
+        return min(a, b);
+
+    float h = max(k - abs(a - b), 0.0) / k;
+    return min(a, b) - h * h * k * 0.25;
+}
+
+float sceneSDF(vec2 p) {
+    float d = 1e5;
+    for (int i = 0; i < MAX_MEMBERS; ++i) {
+        if (i >= memberCount)
+            break;
+
+        vec4 rect = memberRects[i];
+        vec2 halfSize = rect.zw * 0.5;
+        float r = min(memberRadii[i], min(halfSize.x, halfSize.y));
+        d = smoothMin(d, roundedBoxSDF(p - rect.xy - halfSize, halfSize, r), smoothness);
+    }
+
+    return d;
+}
+
+vec2 sceneNormal(vec2 p, float d) {
+    float dx = sceneSDF(p + vec2(1.0, 0.0)) - d;
+    float dy = sceneSDF(p + vec2(0.0, 1.0)) - d;
+    return normalize(vec2(dx, dy) + 0.0001);
+}
+
+// ============================================================================
+// BLUR (same kernels as liquidglass.frag)
+// ============================================================================
+
+vec3 fastBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off1 = vec2(1.3846153846) * texelSize * strength;
+    vec2 off2 = vec2(3.2307692308) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.2270270270;
+    result += texture(tex, clamp(uv + off1, 0.0, 1.0)).rgb * 0.3162162162;
+    result += texture(tex, clamp(uv - off1, 0.0, 1.0)).rgb * 0.3162162162;
+    result += texture(tex, clamp(uv + off2, 0.0, 1.0)).rgb * 0.0702702703;
+    result += texture(tex, clamp(uv - off2, 0.0, 1.0)).rgb * 0.0702702703;
+
+    return result;
+}
+
+vec3 cheapBlur(vec2 uv, vec2 texelSize, float strength) {
+    vec2 off = vec2(2.0) * texelSize * strength;
+
+    vec3 result = texture(tex, clamp(uv, 0.0, 1.0)).rgb * 0.4;
+    result += texture(tex, clamp(uv + off, 0.0, 1.0)).rgb * 0.3;
+    result += texture(tex, clamp(uv - off, 0.0, 1.0)).rgb * 0.3;
+
+    return result;
+}
+
+vec3 lodBlur(vec2 uv, vec2 texelSize, float strength) {
+    if (lod <= 0.0)
+        return fastBlur(uv, texelSize, strength);
+    if (lod >= 1.0)
+        return cheapBlur(uv, texelSize, strength);
+
+    return mix(fastBlur(uv, texelSize, strength), cheapBlur(uv, texelSize, strength), lod);
+}
+
+// ============================================================================
+// MAIN SHADER
+// ============================================================================
+
+void main() {
+    vec2 px = v_texcoord * fullSize;
+    vec2 texelSize = 1.0 / fullSize;
+
+    if (bridgeOwner >= 0) {
+        // Each bridge pixel belongs to the nearest member, so every member that renders draws its share once
+        int nearest = 0;
+        float nearestDist = 1e5;
+        for (int i = 0; i < MAX_MEMBERS; ++i) {
+            if (i >= memberCount)
+                break;
+
+            vec4 rect = memberRects[i];
+            if (all(greaterThanEqual(px, rect.xy)) && all(lessThan(px, rect.xy + rect.zw)))
+                discard;
+
+            vec2 halfSize = rect.zw * 0.5;
+            float d = roundedBoxSDF(px - rect.xy - halfSize, halfSize, min(memberRadii[i], min(halfSize.x, halfSize.y)));
+            if (d < nearestDist) {
+                nearestDist = d;
+                nearest = i;
+            }
+        }
+
+        if (nearest != bridgeOwner)
+            discard;
+    }
+
+    // Outside the merged shape (most of the gap between surfaces) costs one SDF
+    float dist = sceneSDF(px);
+    if (dist > 1.0)
+        discard;
+
+    float shapeAlpha = 1.0 - smoothstep(-1.0, 1.0, dist);
+
+    // Edge distance and border width in units of refHeight, as liquidglass.frag measures them
+    float edgeDist = dist / refHeight;
+    float borderWidth = edgeThickness * 1.5;
+    vec2 edgeNormal = sceneNormal(px, dist);
+
+    // ========================================
+    // 1. BORDER REFRACTION
+    // ========================================
+    float innerFalloff = smoothstep(-borderWidth * 1.5, -borderWidth * 0.7, edgeDist);
+    float outerFalloff = 1.0 - smoothstep(-borderWidth * 0.1, 0.0, edgeDist);
+    float borderPos = clamp((edgeDist + borderWidth) / borderWidth, 0.0, 1.0);
+
+    float refractionProfile = borderPos * (1.0 - borderPos) * 4.0 * mix(0.7, 1.6, borderPos);
+    float refractionDir = smoothstep(0.0, 1.0, borderPos) * 2.0 - 1.0;
+    float strength = refractionProfile * refractionDir * refractionStrength * 4.0 * innerFalloff * outerFalloff;
+
+    vec2 borderRefract = edgeNormal * strength * refHeight * texelSize;
+    vec2 refractedUV = clamp(v_texcoord + borderRefract, 0.001, 0.999);
+
+    // ========================================
+    // 2. CHROMATIC DISPERSION
+    // ========================================
+    vec3 refractedColor;
+    if (lod >= 1.0) {
+        refractedColor = texture(tex, refractedUV).rgb;
+    } else {
+        vec2 chroma = edgeNormal * length(borderRefract) * chromaticAberration * 2.0 * (1.0 - lod);
+
+        float r = texture(tex, clamp(refractedUV - chroma * 0.8, 0.0, 1.0)).r;
+        float g = texture(tex, refractedUV).g;
+        float b = texture(tex, clamp(refractedUV + chroma * 1.2, 0.0, 1.0)).b;
+
+        refractedColor = vec3(r, g, b);
+    }
+
+    // ========================================
+    // 3. BLUR, DEPTH AND TINT
+    // ========================================
+    vec3 blurredColor = preBlurred == 1 ? texture(blurTex, refractedUV).rgb
+                                        : lodBlur(refractedUV, texelSize, blurStrength);
+    vec3 glassColor = mix(blurredColor, refractedColor, 0.4);
+    glassColor *= mix(0.98, 1.02, smoothstep(-borderWidth, 0.0, edgeDist));
+    if (shimmerStrength > 0.0)
+        glassColor *= 1.0 + shimmerStrength * shimmer(px) * 0.04;
+
+    vec3 finalColor = glassColor * vec3(0.99, 0.995, 1.0);
+    finalColor = clamp(finalColor, 0.0, 1.0);
+
+    fragColor = vec4(finalColor, glassOpacity * windowAlpha * shapeAlpha);
+}
+)GLSL"},
+    {"liquidglass_sample.frag", R"GLSL(
+#version 300 es
+precision highp float;
+
+/*
+ * Liquid Glass Sample Fragment Shader
+ *
+ * Copies part of a 10-bit or half-float framebuffer into an 8-bit
+ * background sample. The copy is where precision is lost, so that is where
+ * it dithers, by one step of the sample: the glass blur then averages the
+ * pattern back into the gradients an 8-bit copy would band.
+ */
+
+#include "liquidglass_common.glsl"
+
+// Uniforms
+uniform sampler2D tex;
+uniform vec4 srcRect;              // Region of tex to copy, in texture coordinates: x, y, width, height
+uniform float ditherStep;          // One step of the sample format
+
+in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    vec3 color = texture(tex, srcRect.xy + v_texcoord * srcRect.zw).rgb;
+
+    // Opaque, so the copy replaces the sample whatever blending is enabled
+    fragColor = vec4(clamp(color + bayerDither(gl_FragCoord.xy) * ditherStep, 0.0, 1.0), 1.0);
+}
+)GLSL"},
+    {"liquidglass_blur.comp", R"GLSL(
+#version 310 es
+precision highp float;
+precision highp image2D;
+
+/*
+ * Liquid Glass Tiled Blur Compute Shader
+ *
+ * The same blur as fastBlur() in the fragment shaders, so glass looks the
+ * same on either side of compute_blur_min_area: five linear-sampled taps of
+ * a Gaussian along the down-right diagonal (offsets of equal x and y).
+ *
+ * Each workgroup takes a TILE-long strip of one diagonal plus a halo. A
+ * bilinear tap between two texels of a diagonal also reads the texels
+ * beside them on the two neighbouring diagonals, so those are loaded too;
+ * every tap then resolves from shared memory instead of the texture.
+ * Taps past HALO - 1 texels (blur strength above ~4.6) are clamped there.
+ */
+
+#define TILE 128
+#define HALO 16
+#define CACHE (TILE + 2 * HALO)
+
+layout(local_size_x = TILE) in;
+
+uniform sampler2D srcTex;
+layout(rgba8, binding = 0) writeonly uniform highp image2D dstImage;
+
+uniform ivec2 size;     // Image size in pixels
+uniform float strength; // Blur strength (texel multiplier)
+
+// Texels (x, x + d), (x, x + d - 1) and (x, x + d + 1) of diagonal d, by x
+shared vec4 diagonal[CACHE];
+shared vec4 below[CACHE];
+shared vec4 above[CACHE];
+
+// Clamped per axis, as the fragment path's CLAMP_TO_EDGE sampling is
+vec4 fetchClamped(int x, int y) {
+    return texelFetch(srcTex, clamp(ivec2(x, y), ivec2(0), size - 1), 0);
+}
+
+void load(int i, int x, int d) {
+    diagonal[i] = fetchClamped(x, x + d);
+    below[i] = fetchClamped(x, x + d - 1);
+    above[i] = fetchClamped(x, x + d + 1);
+}
+
+// What texture() returns pos texels down-right of a pixel centre: the four texels
+// around it lie on this diagonal and the two beside it
+vec4 tap(float pos) {
+    int i0 = int(floor(pos));
+    int i1 = i0 + 1;
+    float f = fract(pos);
+
+    vec4 top = mix(diagonal[i0], below[i1], f);
+    vec4 bottom = mix(above[i0], diagonal[i1], f);
+    return mix(top, bottom, f);
+}
+
+void main() {
+    // Diagonal d = y - x, from the bottom-left corner's to the top-right's
+    int d = int(gl_WorkGroupID.y) - (size.x - 1);
+    int xFirst = max(0, -d);
+    int xLast = min(size.x - 1, size.y - 1 - d);
+
+    int lid = int(gl_LocalInvocationID.x);
+    int tileStart = xFirst + int(gl_WorkGroupID.x) * TILE;
+    if (tileStart > xLast)
+        return;
+
+    // Load the tile and its halo once
+    load(lid + HALO, tileStart + lid, d);
+    if (lid < HALO) {
+        load(lid, tileStart - HALO + lid, d);
+        load(TILE + HALO + lid, tileStart + TILE + lid, d);
+    }
+
+    barrier();
+
+    int x = tileStart + lid;
+    if (x > xLast)
+        return;
+
+    float off1 = min(1.3846153846 * strength, float(HALO - 1));
+    float off2 = min(3.2307692308 * strength, float(HALO - 1));
+    float center = float(lid + HALO);
+
+    vec4 result = diagonal[lid + HALO] * 0.2270270270;
+    result += (tap(center + off1) + tap(center - off1)) * 0.3162162162;
+    result += (tap(center + off2) + tap(center - off2)) * 0.0702702703;
+
+    imageStore(dstImage, ivec2(x, x + d), result);
+}
+)GLSL"},
+    {"liquidglass_common.glsl", R"GLSL(
+/*
+ * Liquid Glass Shader Prelude
+ *
+ * Declarations every glass shader shares. Not a shader of its own: each
+ * '#include "liquidglass_common.glsl"' line in a fragment shader is replaced
+ * with this file when the shader is compiled (see LiquidGlassShaderDev.cpp),
+ * so it comes after the #version and precision lines.
+ */
+
+// Configurable parameters (per-profile uniform buffer, see LiquidGlassProfiles.hpp)
+layout(std140) uniform GlassParams {
+    float blurStrength;        // Interior blur amount (0.0 - 2.0)
+    float refractionStrength;  // Edge refraction intensity (0.0 - 0.15)
+    float chromaticAberration; // RGB separation amount (0.0 - 0.02)
+    float fresnelStrength;     // Edge glow intensity (0.0 - 1.0)
+    float specularStrength;    // Highlight brightness (0.0 - 1.0)
+    float glassOpacity;        // Overall glass opacity (0.0 - 1.0)
+    float edgeThickness;       // How thick the refractive edge is (0.0 - 0.3)
+};
+
+uniform float time;                // Animation clock
+uniform float shimmerStrength;     // Animated glass mode: 0 = off, 1 = on
+
+// Slow caustic shimmer for the animated glass mode, in pixel space so every glass shader agrees
+float shimmer(vec2 px) {
+    vec2 p = px / 90.0;
+    float a = sin(p.x * 1.7 + time * 0.9) * sin(p.y * 1.3 - time * 0.7);
+    float b = sin((p.x + p.y) * 0.9 + time * 1.3);
+    return a * 0.6 + b * 0.4;
+}
+
+// 4x4 ordered dither in [-0.5, 0.5)
+float bayerDither(vec2 fragCoord) {
+    const float BAYER[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0, 3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 p = ivec2(fragCoord) & 3;
+    return (BAYER[p.y * 4 + p.x] + 0.5) / 16.0 - 0.5;
 }
 )GLSL"},
 };
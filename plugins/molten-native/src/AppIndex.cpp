@@ -0,0 +1,193 @@
+#include "AppIndex.hpp"
+
+#include <QElapsedTimer>
+#include <QVariantMap>
+#include <algorithm>
+
+static QString qstr(std::string_view text) {
+    return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+// ============================================================================
+// SERVICE
+// ============================================================================
+
+CAppIndexService* CAppIndexService::instance() {
+    static auto* service = new CAppIndexService();
+    return service;
+}
+
+CAppIndexService::CAppIndexService() {
+    m_index.load();
+
+    m_debounce.setSingleShot(true);
+    m_debounce.setInterval(DEBOUNCE_MS);
+    connect(&m_debounce, &QTimer::timeout, this, [this]() {
+        m_index.applyChanges();
+        emit updated();
+    });
+
+    if (m_index.watchFd() < 0)
+        return;
+
+    m_notifier = new QSocketNotifier(m_index.watchFd(), QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, [this]() {
+        if (m_index.readEvents())
+            m_debounce.start();
+    });
+}
+
+const CDesktopIndex& CAppIndexService::index() const {
+    return m_index;
+}
+
+// ============================================================================
+// APP INDEX
+// ============================================================================
+
+CAppIndex::CAppIndex(QObject* parent) : QObject(parent) {
+    connect(CAppIndexService::instance(), &CAppIndexService::updated, this, &CAppIndex::updated);
+}
+
+int CAppIndex::count() const {
+    const auto& INDEX = CAppIndexService::instance()->index();
+
+    int         visible = 0;
+    for (uint32_t i = 0; i < INDEX.size(); ++i)
+        visible += !INDEX.isHidden(i);
+
+    return visible;
+}
+
+bool CAppIndex::fromCache() const {
+    return CAppIndexService::instance()->index().fromCache();
+}
+
+double CAppIndex::lastSearchMs() const {
+    return m_lastSearchMs;
+}
+
+QVariantList CAppIndex::search(const QString& query, int limit) {
+    const auto&      INDEX = CAppIndexService::instance()->index();
+    const QByteArray UTF8  = query.toUtf8();
+
+    QElapsedTimer    timer;
+    timer.start();
+    INDEX.search({UTF8.constData(), static_cast<size_t>(UTF8.size())}, m_matches, std::max(limit, 0));
+    m_lastSearchMs = timer.nsecsElapsed() / 1e6;
+    emit searched();
+
+    QVariantList result;
+    result.reserve(m_matches.size());
+    for (const auto& match : m_matches)
+        result.append(QVariantMap{{"id", qstr(INDEX.app(match.entry).id)}, {"score", match.score}});
+
+    return result;
+}
+
+QString CAppIndex::iconForClass(const QString& windowClass) const {
+    const QByteArray UTF8 = windowClass.toUtf8();
+    return qstr(CAppIndexService::instance()->index().iconForClass({UTF8.constData(), static_cast<size_t>(UTF8.size())}));
+}
+
+// ============================================================================
+// SEARCH MODEL
+// ============================================================================
+
+CAppSearchModel::CAppSearchModel(QObject* parent) : QAbstractListModel(parent) {
+    connect(CAppIndexService::instance(), &CAppIndexService::updated, this, &CAppSearchModel::refresh);
+    refresh();
+}
+
+QString CAppSearchModel::query() const {
+    return m_query;
+}
+
+void CAppSearchModel::setQuery(const QString& query) {
+    if (query == m_query)
+        return;
+
+    m_query = query;
+    emit queryChanged();
+    refresh();
+}
+
+int CAppSearchModel::limit() const {
+    return m_limit;
+}
+
+void CAppSearchModel::setLimit(int limit) {
+    if (limit == m_limit)
+        return;
+
+    m_limit = limit;
+    emit limitChanged();
+    refresh();
+}
+
+int CAppSearchModel::count() const {
+    return static_cast<int>(m_matches.size());
+}
+
+void CAppSearchModel::refresh() {
+    const auto& INDEX    = CAppIndexService::instance()->index();
+    const int   PREVIOUS = count();
+
+    beginResetModel();
+
+    if (m_query.isEmpty()) {
+        // Everything, already in name order
+        m_matches.clear();
+        for (uint32_t i = 0; i < INDEX.size() && (m_limit <= 0 || m_matches.size() < static_cast<size_t>(m_limit)); ++i) {
+            if (!INDEX.isHidden(i))
+                m_matches.push_back({i, 0});
+        }
+    } else {
+        const QByteArray UTF8 = m_query.toUtf8();
+        INDEX.search({UTF8.constData(), static_cast<size_t>(UTF8.size())}, m_matches, std::max(m_limit, 0));
+    }
+
+    endResetModel();
+
+    if (count() != PREVIOUS)
+        emit countChanged();
+}
+
+int CAppSearchModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant CAppSearchModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= count())
+        return {};
+
+    const auto& MATCH = m_matches[index.row()];
+    const auto  APP   = CAppIndexService::instance()->index().app(MATCH.entry);
+
+    switch (role) {
+        case ROLE_ID: return qstr(APP.id);
+        case ROLE_NAME: return qstr(APP.name);
+        case ROLE_GENERIC_NAME: return qstr(APP.genericName);
+        case ROLE_COMMENT: return qstr(APP.comment);
+        case ROLE_ICON: return APP.icon.empty() ? QStringLiteral("application-x-executable") : qstr(APP.icon);
+        case ROLE_EXEC_STRING: return qstr(APP.exec);
+        case ROLE_CATEGORIES: return qstr(APP.categories).split(';', Qt::SkipEmptyParts);
+        case ROLE_RUN_IN_TERMINAL: return APP.terminal;
+        case ROLE_SCORE: return MATCH.score;
+        default: return {};
+    }
+}
+
+QHash<int, QByteArray> CAppSearchModel::roleNames() const {
+    return {
+        {ROLE_ID, "id"},
+        {ROLE_NAME, "name"},
+        {ROLE_GENERIC_NAME, "genericName"},
+        {ROLE_COMMENT, "comment"},
+        {ROLE_ICON, "icon"},
+        {ROLE_EXEC_STRING, "execString"},
+        {ROLE_CATEGORIES, "categories"},
+        {ROLE_RUN_IN_TERMINAL, "runInTerminal"},
+        {ROLE_SCORE, "score"},
+    };
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+/*
+ * App Index QML Types
+ * AppIndex and AppSearchModel share one process-wide CDesktopIndex. Its
+ * inotify descriptor sits on the Qt event loop; changes are batched for
+ * DEBOUNCE_MS so a package upgrade touching hundreds of files costs a single
+ * rebuild. Queries run synchronously on the caller's thread.
+ */
+
+#include "DesktopIndex.hpp"
+
+#include <QAbstractListModel>
+#include <QObject>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QVariantList>
+#include <vector>
+
+// Owner of the shared index, created on first use and kept for the process lifetime
+class CAppIndexService : public QObject {
+    Q_OBJECT
+
+  public:
+    static CAppIndexService* instance();
+
+    const CDesktopIndex&     index() const;
+
+  signals:
+    void updated();
+
+  private:
+    CAppIndexService();
+
+    static constexpr int DEBOUNCE_MS = 250;
+
+    CDesktopIndex        m_index;
+    QSocketNotifier*     m_notifier = nullptr;
+    QTimer               m_debounce;
+};
+
+// AppIndex {}: lookups for code that keeps its own app objects
+class CAppIndex : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY updated)
+    Q_PROPERTY(bool fromCache READ fromCache NOTIFY updated)
+    Q_PROPERTY(double lastSearchMs READ lastSearchMs NOTIFY searched)
+
+  public:
+    explicit CAppIndex(QObject* parent = nullptr);
+
+    int                      count() const;
+    bool                     fromCache() const;
+    double                   lastSearchMs() const;
+
+    // [{ id, score }], best first; limit 0 returns every match
+    Q_INVOKABLE QVariantList search(const QString& query, int limit = 0);
+
+    // Icon name for a window class, "" when no app claims it
+    Q_INVOKABLE QString      iconForClass(const QString& windowClass) const;
+
+  signals:
+    void updated();
+    void searched();
+
+  private:
+    std::vector<CDesktopIndex::SMatch> m_matches; // Reused between keystrokes
+    double                             m_lastSearchMs = 0;
+};
+
+// AppSearchModel { query: ... }: the matches themselves, or every app by name when query is empty
+class CAppSearchModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
+    Q_PROPERTY(int limit READ limit WRITE setLimit NOTIFY limitChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  public:
+    enum eRoles {
+        ROLE_ID = Qt::UserRole + 1,
+        ROLE_NAME,
+        ROLE_GENERIC_NAME,
+        ROLE_COMMENT,
+        ROLE_ICON,
+        ROLE_EXEC_STRING,
+        ROLE_CATEGORIES,
+        ROLE_RUN_IN_TERMINAL,
+        ROLE_SCORE,
+    };
+
+    explicit CAppSearchModel(QObject* parent = nullptr);
+
+    QString                query() const;
+    void                   setQuery(const QString& query);
+    int                    limit() const;
+    void                   setLimit(int limit);
+    int                    count() const;
+
+    int                    rowCount(const QModelIndex& parent = {}) const override;
+    QVariant               data(const QModelIndex& index, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+  signals:
+    void queryChanged();
+    void limitChanged();
+    void countChanged();
+
+  private:
+    QString                            m_query;
+    int                                m_limit = 0;
+    std::vector<CDesktopIndex::SMatch> m_matches;
+
+    void                               refresh();
+};
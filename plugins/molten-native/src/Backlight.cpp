@@ -0,0 +1,325 @@
+#include "Backlight.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <string_view>
+#include <sys/inotify.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+static int typeRank(const std::string& type) {
+    if (type == "firmware")
+        return 0;
+    if (type == "platform")
+        return 1;
+    return 2;
+}
+
+int CBacklight::readInt(const std::string& path) {
+    const int FD = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD < 0)
+        return -1;
+
+    char          buffer[32];
+    const ssize_t LENGTH = read(FD, buffer, sizeof(buffer) - 1);
+    ::close(FD);
+    if (LENGTH <= 0)
+        return -1;
+
+    buffer[LENGTH] = '\0';
+    return std::atoi(buffer);
+}
+
+// ============================================================================
+// LIFETIME
+// ============================================================================
+
+CBacklight::CBacklight(std::string sysfsRoot) : m_root(std::move(sysfsRoot)) {
+    m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    // The class directory is only watched to notice devices in a fake root;
+    // real sysfs does not report them there, uevents do
+    if (m_inotify >= 0)
+        m_classWatch = inotify_add_watch(m_inotify, (m_root + "/class/backlight").c_str(), IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+
+    if (m_root == "/sys") {
+        m_uevent = socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+
+        // Group 1 is the kernel's own broadcast; receiving it needs no privileges
+        sockaddr_nl address = {};
+        address.nl_family   = AF_NETLINK;
+        address.nl_groups   = 1;
+        if (m_uevent >= 0 && bind(m_uevent, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(m_uevent);
+            m_uevent = -1;
+        }
+    }
+
+    m_writer = std::thread([this]() { writerLoop(); });
+}
+
+CBacklight::~CBacklight() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_writer.join();
+
+    close();
+
+    if (m_inotify >= 0)
+        ::close(m_inotify);
+    if (m_uevent >= 0)
+        ::close(m_uevent);
+}
+
+void CBacklight::close() {
+    {
+        // The writer may be mid-write on m_writeFd: let it finish first
+        std::unique_lock lock(m_mutex);
+        m_pending = -1;
+        m_wake.wait(lock, [this]() { return !m_writing; });
+
+        if (m_writeFd >= 0)
+            ::close(m_writeFd);
+        m_writeFd = -1;
+    }
+
+    for (const int WD : m_watches)
+        inotify_rm_watch(m_inotify, WD);
+    m_watches.clear();
+
+    if (m_valueFd >= 0)
+        ::close(m_valueFd);
+
+    m_valueFd = -1;
+    m_device  = {};
+    m_path.clear();
+    m_value = 0;
+}
+
+// ============================================================================
+// DEVICES
+// ============================================================================
+
+std::vector<CBacklight::SDevice> CBacklight::devices() const {
+    const std::string    CLASS = m_root + "/class/backlight";
+    std::vector<SDevice> result;
+
+    DIR*                 dir = opendir(CLASS.c_str());
+    if (!dir)
+        return result;
+
+    while (const dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        SDevice device;
+        device.name = entry->d_name;
+        device.max  = readInt(CLASS + "/" + device.name + "/max_brightness");
+        if (device.max <= 0)
+            continue;
+
+        char      type[32] = {};
+        const int FD       = ::open((CLASS + "/" + device.name + "/type").c_str(), O_RDONLY | O_CLOEXEC);
+        if (FD >= 0) {
+            const ssize_t LENGTH = read(FD, type, sizeof(type) - 1);
+            ::close(FD);
+            device.type = std::string(type, std::max<ssize_t>(LENGTH, 0));
+            while (!device.type.empty() && (device.type.back() == '\n' || device.type.back() == ' '))
+                device.type.pop_back();
+        }
+        if (device.type.empty())
+            device.type = "raw";
+
+        result.push_back(std::move(device));
+    }
+    closedir(dir);
+
+    std::sort(result.begin(), result.end(), [](const SDevice& a, const SDevice& b) {
+        const int RANK_A = typeRank(a.type), RANK_B = typeRank(b.type);
+        return RANK_A != RANK_B ? RANK_A < RANK_B : a.name < b.name;
+    });
+    return result;
+}
+
+bool CBacklight::open(const std::string& name) {
+    close();
+
+    const auto DEVICES = devices();
+    const auto IT      = name.empty() ? DEVICES.begin() : std::find_if(DEVICES.begin(), DEVICES.end(), [&](const SDevice& d) { return d.name == name; });
+    if (IT == DEVICES.end())
+        return false;
+
+    m_device  = *IT;
+    m_path    = m_root + "/class/backlight/" + m_device.name;
+    m_valueFd = ::open((m_path + "/brightness").c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_valueFd < 0) {
+        close();
+        return false;
+    }
+
+    {
+        // Usually root-only without a udev rule; logind is the fallback then
+        std::lock_guard lock(m_mutex);
+        m_writeFd = ::open((m_path + "/brightness").c_str(), O_WRONLY | O_CLOEXEC);
+    }
+
+    // Writes through sysfs report on brightness; hotkeys handled by firmware
+    // only notify actual_brightness
+    if (m_inotify >= 0) {
+        for (const char* attribute : {"/brightness", "/actual_brightness"}) {
+            if (const int WD = inotify_add_watch(m_inotify, (m_path + attribute).c_str(), IN_MODIFY | IN_CLOSE_WRITE); WD >= 0)
+                m_watches.push_back(WD);
+        }
+    }
+
+    return readValue();
+}
+
+bool CBacklight::isOpen() const {
+    return m_valueFd >= 0;
+}
+
+const CBacklight::SDevice& CBacklight::device() const {
+    return m_device;
+}
+
+int CBacklight::value() const {
+    return m_value;
+}
+
+bool CBacklight::readValue() {
+    if (m_valueFd < 0)
+        return false;
+
+    // sysfs attributes are re-read from offset 0 on an open descriptor
+    char          buffer[32];
+    const ssize_t LENGTH = pread(m_valueFd, buffer, sizeof(buffer) - 1, 0);
+    if (LENGTH <= 0)
+        return false;
+
+    buffer[LENGTH] = '\0';
+    m_value        = std::clamp(std::atoi(buffer), 0, m_device.max);
+    return true;
+}
+
+// ============================================================================
+// EVENTS
+// ============================================================================
+
+int CBacklight::watchFd() const {
+    return m_inotify;
+}
+
+int CBacklight::ueventFd() const {
+    return m_uevent;
+}
+
+uint8_t CBacklight::readEvents() {
+    alignas(inotify_event) char buffer[4096];
+    uint8_t                     events = 0;
+
+    while (true) {
+        const ssize_t LENGTH = read(m_inotify, buffer, sizeof(buffer));
+        if (LENGTH <= 0)
+            break;
+
+        for (ssize_t at = 0; at < LENGTH;) {
+            const auto* EVENT = reinterpret_cast<const inotify_event*>(buffer + at);
+            at += sizeof(inotify_event) + EVENT->len;
+
+            // Watches dropped by a re-open still report IN_IGNORED: match neither
+            if (EVENT->wd == m_classWatch)
+                events |= EVENT_DEVICES;
+            else if (std::find(m_watches.begin(), m_watches.end(), EVENT->wd) != m_watches.end())
+                events |= EVENT_VALUE;
+        }
+    }
+
+    return events;
+}
+
+uint8_t CBacklight::readUevents() {
+    char    buffer[8192];
+    uint8_t events = 0;
+
+    while (true) {
+        const ssize_t LENGTH = recv(m_uevent, buffer, sizeof(buffer) - 1, 0);
+        if (LENGTH <= 0)
+            break;
+        buffer[LENGTH] = '\0';
+
+        // "action@devpath\0KEY=value\0KEY=value\0..."
+        const std::string_view HEADER(buffer);
+        bool                   backlight = false;
+        for (size_t at = HEADER.size() + 1; at < static_cast<size_t>(LENGTH);) {
+            const std::string_view FIELD(buffer + at);
+            backlight |= FIELD == "SUBSYSTEM=backlight";
+            at += FIELD.size() + 1;
+        }
+
+        if (!backlight)
+            continue;
+
+        // change: a hotkey or another tool, add/remove: a driver (re)binding
+        events |= HEADER.starts_with("change@") ? EVENT_VALUE : EVENT_DEVICES;
+    }
+
+    return events;
+}
+
+// ============================================================================
+// WRITING
+// ============================================================================
+
+void CBacklight::submit(int value) {
+    {
+        std::lock_guard lock(m_mutex);
+        m_pending = std::clamp(value, 0, m_device.max);
+    }
+    m_wake.notify_all();
+}
+
+bool CBacklight::idle() const {
+    std::lock_guard lock(m_mutex);
+    return m_pending < 0 && !m_writing;
+}
+
+void CBacklight::writerLoop() {
+    std::unique_lock lock(m_mutex);
+
+    while (true) {
+        m_wake.wait(lock, [this]() { return m_stopping || m_pending >= 0; });
+        if (m_stopping)
+            return;
+
+        // Whatever was queued while the last write ran is superseded by this one
+        const int VALUE = m_pending;
+        const int FD    = m_writeFd;
+        m_pending       = -1;
+        m_writing       = true;
+        lock.unlock();
+
+        char      text[16];
+        const int LENGTH = snprintf(text, sizeof(text), "%d\n", VALUE);
+        const bool OK    = FD >= 0 && pwrite(FD, text, LENGTH, 0) == LENGTH;
+
+        lock.lock();
+        m_writing = false;
+        m_wake.notify_all();
+
+        if (onWritten) {
+            lock.unlock();
+            onWritten(OK);
+            lock.lock();
+        }
+    }
+}
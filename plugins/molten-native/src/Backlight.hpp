@@ -0,0 +1,99 @@
+#pragma once
+
+/*
+ * Backlight
+ * Reads and writes a /sys/class/backlight device directly. Changes made by
+ * anyone (hotkeys, other tools, our own writes) arrive through inotify on the
+ * brightness attributes, and devices coming and going through the kernel's
+ * uevent socket, so nothing polls. Writes go through one background thread
+ * that only ever writes the newest requested value: a slider drag produces
+ * as many writes as the driver can take, not one per step, and a slow driver
+ * never blocks the caller.
+ *
+ * Everything is relative to a sysfs root, "/sys" by default, so a plain
+ * directory tree can stand in for a machine's backlight (uevents are only
+ * read for the real one).
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class CBacklight {
+  public:
+    explicit CBacklight(std::string sysfsRoot = "/sys");
+    ~CBacklight();
+
+    CBacklight(const CBacklight&)            = delete;
+    CBacklight& operator=(const CBacklight&) = delete;
+
+    struct SDevice {
+        std::string name;
+        std::string type; // firmware, platform or raw
+        int         max = 0;
+    };
+
+    // Every device under class/backlight, preferred first: firmware, then
+    // platform, then raw interfaces, as systemd-backlight ranks them
+    std::vector<SDevice>   devices() const;
+
+    // Opens the named device, or the preferred one when name is empty
+    bool                   open(const std::string& name = "");
+    bool                   isOpen() const;
+    const SDevice&         device() const;
+
+    // Last value read, 0..device().max
+    int                    value() const;
+    bool                   readValue();
+
+    enum eEvents : uint8_t {
+        EVENT_VALUE   = 1 << 0, // The value may have changed: readValue()
+        EVENT_DEVICES = 1 << 1, // A device appeared or disappeared: open() again
+    };
+
+    // Descriptors for the host's event loop, -1 when unavailable
+    int                    watchFd() const;
+    int                    ueventFd() const;
+
+    // Drain their descriptor, returning eEvents bits
+    uint8_t                readEvents();
+    uint8_t                readUevents();
+
+    // Queues value for the writer thread, replacing any value not yet written
+    void                   submit(int value);
+
+    // No write queued or in progress
+    bool                   idle() const;
+
+    // Called on the writer thread after each write, with false when the
+    // device refused it (no write permission: use logind instead)
+    std::function<void(bool)> onWritten;
+
+  private:
+    std::string        m_root;
+    SDevice            m_device;
+    std::string        m_path; // Device directory
+    int                m_value      = 0;
+    int                m_valueFd    = -1; // brightness, read with pread
+    int                m_inotify    = -1;
+    int                m_uevent     = -1;
+    int                m_classWatch = -1;
+    std::vector<int>   m_watches; // Inotify watches on the device's attributes
+
+    // Writer thread state, guarded by m_mutex
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_wake;
+    std::thread             m_writer;
+    int                     m_writeFd  = -1;
+    int                     m_pending  = -1; // -1: nothing queued
+    bool                    m_writing  = false;
+    bool                    m_stopping = false;
+
+    void                    close();
+    void                    writerLoop();
+    static int              readInt(const std::string& path);
+};
@@ -0,0 +1,176 @@
+#include "BacklightControl.hpp"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+CBacklightControl::CBacklightControl(QObject* parent) : QObject(parent) {
+    m_root = qEnvironmentVariable("MOLTEN_SYSFS_ROOT", "/sys");
+    start();
+}
+
+// ============================================================================
+// DEVICE
+// ============================================================================
+
+void CBacklightControl::start() {
+    delete m_watchNotifier;
+    delete m_ueventNotifier;
+    m_watchNotifier  = nullptr;
+    m_ueventNotifier = nullptr;
+
+    m_backlight  = std::make_unique<CBacklight>(m_root.toStdString());
+    m_useLogind  = false;
+    m_logindSent = -1;
+
+    // The writer thread reports back here; dropped if this object is gone by then
+    m_backlight->onWritten = [this](bool ok) { QMetaObject::invokeMethod(this, [this, ok]() { onWritten(ok); }, Qt::QueuedConnection); };
+
+    if (m_backlight->watchFd() >= 0) {
+        m_watchNotifier = new QSocketNotifier(m_backlight->watchFd(), QSocketNotifier::Read, this);
+        connect(m_watchNotifier, &QSocketNotifier::activated, this, [this]() { onEvents(m_backlight->readEvents()); });
+    }
+
+    if (m_backlight->ueventFd() >= 0) {
+        m_ueventNotifier = new QSocketNotifier(m_backlight->ueventFd(), QSocketNotifier::Read, this);
+        connect(m_ueventNotifier, &QSocketNotifier::activated, this, [this]() { onEvents(m_backlight->readUevents()); });
+    }
+
+    reopen();
+}
+
+void CBacklightControl::reopen() {
+    const std::string PREVIOUS = m_backlight->device().name;
+
+    m_backlight->open(m_requestedDevice.toStdString());
+    if (m_backlight->device().name != PREVIOUS)
+        emit deviceChanged();
+
+    if (m_backlight->isOpen())
+        publish(static_cast<double>(m_backlight->value()) / m_backlight->device().max);
+}
+
+void CBacklightControl::onEvents(uint8_t events) {
+    if (events & CBacklight::EVENT_DEVICES)
+        return reopen();
+
+    // Our own writes report here too; the settled value is read once they finish
+    if ((events & CBacklight::EVENT_VALUE) && !busy())
+        refresh();
+}
+
+QString CBacklightControl::sysfsRoot() const {
+    return m_root;
+}
+
+void CBacklightControl::setSysfsRoot(const QString& root) {
+    if (root == m_root)
+        return;
+
+    m_root = root;
+    emit sysfsRootChanged();
+    start();
+}
+
+QString CBacklightControl::device() const {
+    return QString::fromStdString(m_backlight->device().name);
+}
+
+void CBacklightControl::setDevice(const QString& device) {
+    if (device == m_requestedDevice)
+        return;
+
+    m_requestedDevice = device;
+    reopen();
+}
+
+bool CBacklightControl::available() const {
+    return m_backlight->isOpen();
+}
+
+int CBacklightControl::maxBrightness() const {
+    return m_backlight->device().max;
+}
+
+// ============================================================================
+// BRIGHTNESS
+// ============================================================================
+
+double CBacklightControl::brightness() const {
+    return m_brightness;
+}
+
+void CBacklightControl::publish(double brightness) {
+    if (qFuzzyCompare(brightness + 1, m_brightness + 1))
+        return;
+
+    m_brightness = brightness;
+    emit brightnessChanged();
+}
+
+bool CBacklightControl::busy() const {
+    return m_logindBusy || !m_backlight->idle();
+}
+
+void CBacklightControl::refresh() {
+    if (m_backlight->readValue())
+        publish(static_cast<double>(m_backlight->value()) / m_backlight->device().max);
+}
+
+void CBacklightControl::setBrightness(double brightness) {
+    if (!m_backlight->isOpen())
+        return;
+
+    const int MAX = m_backlight->device().max;
+    m_target      = std::clamp(static_cast<int>(std::lround(brightness * MAX)), 0, MAX);
+    publish(static_cast<double>(m_target) / MAX);
+
+    if (m_useLogind)
+        sendLogind();
+    else
+        m_backlight->submit(m_target);
+}
+
+void CBacklightControl::onWritten(bool ok) {
+    if (!ok && !m_useLogind) {
+        m_useLogind = true;
+        sendLogind();
+        return;
+    }
+
+    if (!busy())
+        refresh();
+}
+
+void CBacklightControl::sendLogind() {
+    if (m_logindBusy || m_target == m_logindSent)
+        return;
+
+    auto message = QDBusMessage::createMethodCall("org.freedesktop.login1", "/org/freedesktop/login1/session/auto", "org.freedesktop.login1.Session", "SetBrightness");
+    message << QString("backlight") << device() << static_cast<uint>(m_target);
+
+    m_logindBusy = true;
+    m_logindSent = m_target;
+
+    auto* watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher* call) {
+        call->deleteLater();
+        m_logindBusy = false;
+
+        const QDBusPendingReply<> REPLY = *call;
+        if (REPLY.isError()) {
+            qWarning("Backlight: logind SetBrightness failed: %s", qPrintable(REPLY.error().message()));
+            return refresh();
+        }
+
+        // Values requested while this call ran collapse into one more call
+        if (m_target != m_logindSent)
+            sendLogind();
+        else
+            refresh();
+    });
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+/*
+ * Backlight QML Type
+ * Wraps CBacklight for QML: its descriptors sit on the Qt event loop and
+ * brightness follows the device as it changes. While writes are outstanding
+ * brightness holds the requested value, so a dragged slider does not jump
+ * back to values the driver has not caught up with. Without write access to
+ * sysfs, writes go to logind's Session.SetBrightness instead, one call in
+ * flight at a time with the newest value sent next.
+ */
+
+#include "Backlight.hpp"
+
+#include <QObject>
+#include <QSocketNotifier>
+#include <QString>
+#include <memory>
+
+// Backlight { sysfsRoot: ...; device: ... }
+class CBacklightControl : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QString sysfsRoot READ sysfsRoot WRITE setSysfsRoot NOTIFY sysfsRootChanged)
+    Q_PROPERTY(QString device READ device WRITE setDevice NOTIFY deviceChanged)
+    Q_PROPERTY(bool available READ available NOTIFY deviceChanged)
+    Q_PROPERTY(int maxBrightness READ maxBrightness NOTIFY deviceChanged)
+    Q_PROPERTY(double brightness READ brightness NOTIFY brightnessChanged)
+
+  public:
+    explicit CBacklightControl(QObject* parent = nullptr);
+
+    // "/sys" unless MOLTEN_SYSFS_ROOT points elsewhere
+    QString          sysfsRoot() const;
+    void             setSysfsRoot(const QString& root);
+
+    // Empty picks the preferred device; reads back the device in use
+    QString          device() const;
+    void             setDevice(const QString& device);
+
+    bool             available() const;
+    int              maxBrightness() const;
+
+    // 0-1
+    double           brightness() const;
+
+    Q_INVOKABLE void setBrightness(double brightness);
+
+    // Re-reads the device; changes arrive on their own, this is for callers that want certainty
+    Q_INVOKABLE void refresh();
+
+  signals:
+    void sysfsRootChanged();
+    void deviceChanged();
+    void brightnessChanged();
+
+  private:
+    QString                     m_root;
+    QString                     m_requestedDevice;
+    std::unique_ptr<CBacklight> m_backlight;
+    QSocketNotifier*            m_watchNotifier  = nullptr;
+    QSocketNotifier*            m_ueventNotifier = nullptr;
+    double                      m_brightness     = 0;
+
+    // logind fallback
+    bool                        m_useLogind = false;
+    bool                        m_logindBusy = false;
+    int                         m_target     = -1; // Newest requested raw value
+    int                         m_logindSent = -1;
+
+    void                        start();
+    void                        reopen();
+    void                        onEvents(uint8_t events);
+    void                        onWritten(bool ok);
+    void                        sendLogind();
+    bool                        busy() const;
+    void                        publish(double brightness);
+};
@@ -0,0 +1,175 @@
+#include "BluetoothState.hpp"
+
+constexpr const char* BLUEZ_SERVICE     = "org.bluez";
+constexpr const char* ADAPTER_INTERFACE = "org.bluez.Adapter1";
+constexpr const char* DEVICE_INTERFACE  = "org.bluez.Device1";
+
+// ============================================================================
+// DEVICES
+// ============================================================================
+
+CBluetoothDeviceModel::CBluetoothDeviceModel(CDBusObjects* objects, QObject* parent) : CDBusObjectModel(objects, DEVICE_INTERFACE, parent) {
+    ;
+}
+
+QVariant CBluetoothDeviceModel::value(const QString& path, const QVariantMap& properties, int role) const {
+    switch (role) {
+        case ROLE_PATH: return path;
+        case ROLE_ADDRESS: return properties.value("Address").toString();
+        case ROLE_NAME: {
+            const QString ALIAS = properties.value("Alias").toString();
+            return ALIAS.isEmpty() ? properties.value("Name", properties.value("Address")).toString() : ALIAS;
+        }
+        case ROLE_ICON: return properties.value("Icon").toString();
+        case ROLE_PAIRED: return properties.value("Paired").toBool();
+        case ROLE_CONNECTED: return properties.value("Connected").toBool();
+        case ROLE_RSSI: return properties.value("RSSI").toInt();
+        default: return {};
+    }
+}
+
+QHash<int, QByteArray> CBluetoothDeviceModel::roleNames() const {
+    return {
+        {ROLE_PATH, "path"},
+        {ROLE_ADDRESS, "address"},
+        {ROLE_NAME, "name"},
+        {ROLE_ICON, "icon"},
+        {ROLE_PAIRED, "paired"},
+        {ROLE_CONNECTED, "connected"},
+        {ROLE_RSSI, "rssi"},
+    };
+}
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+CBluetoothState::CBluetoothState(QObject* parent) : QObject(parent) {
+    m_objects = new CDBusObjects(CDBusObjects::defaultBus(), BLUEZ_SERVICE, this);
+    m_devices = new CBluetoothDeviceModel(m_objects, this);
+
+    connect(m_objects, &CDBusObjects::added, this, [this]() { update(); });
+    connect(m_objects, &CDBusObjects::removed, this, [this]() { update(); });
+    connect(m_objects, &CDBusObjects::registeredChanged, this, [this]() {
+        emit availableChanged();
+        update();
+    });
+    connect(m_objects, &CDBusObjects::changed, this, [this](const QString&, const QString& interface, const QStringList& names) {
+        // RSSI and the like move the device rows, not the summary
+        if (interface == ADAPTER_INTERFACE || names.contains("Connected"))
+            update();
+    });
+
+    // BlueZ roots its ObjectManager at /
+    m_objects->manage("/");
+}
+
+QString CBluetoothState::bus() const {
+    return m_objects->bus();
+}
+
+void CBluetoothState::setBus(const QString& bus) {
+    if (bus == m_objects->bus())
+        return;
+
+    m_objects->setBus(bus);
+    emit busChanged();
+}
+
+QString CBluetoothState::adapter() const {
+    const QStringList ADAPTERS = m_objects->objects(ADAPTER_INTERFACE);
+    return ADAPTERS.isEmpty() ? QString() : ADAPTERS.first();
+}
+
+QString CBluetoothState::device(const QString& address) const {
+    for (const auto& path : m_objects->objects(DEVICE_INTERFACE)) {
+        if (m_objects->value(path, DEVICE_INTERFACE, "Address").toString().compare(address, Qt::CaseInsensitive) == 0)
+            return path;
+    }
+
+    return {};
+}
+
+void CBluetoothState::update() {
+    SState        state;
+    const QString ADAPTER = adapter();
+
+    if (!ADAPTER.isEmpty()) {
+        state.enabled     = m_objects->value(ADAPTER, ADAPTER_INTERFACE, "Powered").toBool();
+        state.discovering = state.enabled && m_objects->value(ADAPTER, ADAPTER_INTERFACE, "Discovering").toBool();
+
+        // bluetoothctl devices Connected counted across adapters too
+        if (state.enabled) {
+            for (const auto& path : m_objects->objects(DEVICE_INTERFACE))
+                state.connectedDevices += m_objects->value(path, DEVICE_INTERFACE, "Connected").toBool() ? 1 : 0;
+        }
+    }
+
+    if (state == m_state)
+        return;
+
+    m_state = state;
+    emit stateChanged();
+}
+
+bool CBluetoothState::available() const {
+    return m_objects->isRegistered();
+}
+
+bool CBluetoothState::enabled() const {
+    return m_state.enabled;
+}
+
+bool CBluetoothState::discovering() const {
+    return m_state.discovering;
+}
+
+bool CBluetoothState::connected() const {
+    return m_state.connectedDevices > 0;
+}
+
+int CBluetoothState::connectedDevices() const {
+    return m_state.connectedDevices;
+}
+
+QObject* CBluetoothState::devices() {
+    return m_devices;
+}
+
+// ============================================================================
+// CONTROL
+// ============================================================================
+
+void CBluetoothState::setEnabled(bool enabled) {
+    const QString ADAPTER = adapter();
+    if (!ADAPTER.isEmpty())
+        m_objects->write(ADAPTER, ADAPTER_INTERFACE, "Powered", enabled);
+}
+
+void CBluetoothState::startDiscovery() {
+    const QString ADAPTER = adapter();
+    if (!ADAPTER.isEmpty() && m_state.enabled)
+        m_objects->call(ADAPTER, ADAPTER_INTERFACE, "StartDiscovery");
+}
+
+void CBluetoothState::stopDiscovery() {
+    const QString ADAPTER = adapter();
+    if (!ADAPTER.isEmpty() && m_state.discovering)
+        m_objects->call(ADAPTER, ADAPTER_INTERFACE, "StopDiscovery");
+}
+
+void CBluetoothState::connectDevice(const QString& address) {
+    const QString DEVICE = device(address);
+    if (DEVICE.isEmpty()) {
+        qWarning("BluetoothState: no device %s", qPrintable(address));
+        return;
+    }
+
+    m_objects->call(DEVICE, DEVICE_INTERFACE, "Connect");
+}
+
+void CBluetoothState::disconnectDevice(const QString& address) {
+    const QString DEVICE = device(address);
+    if (!DEVICE.isEmpty())
+        m_objects->call(DEVICE, DEVICE_INTERFACE, "Disconnect");
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+/*
+ * Bluetooth State QML Type
+ * Follows BlueZ over D-Bus instead of polling bluetoothctl: the adapters and
+ * devices its ObjectManager reports are read once and kept current from
+ * PropertiesChanged, InterfacesAdded and InterfacesRemoved. Powered,
+ * Discovering and Connected change the summary the moment BlueZ does;
+ * devices are a list model that changes a row at a time.
+ */
+
+#include "DBusObjects.hpp"
+
+#include <QObject>
+#include <QString>
+
+// Devices BlueZ knows of (paired, or seen while discovering), in the order they were found
+class CBluetoothDeviceModel : public CDBusObjectModel {
+    Q_OBJECT
+
+  public:
+    enum eRoles {
+        ROLE_PATH = Qt::UserRole + 1,
+        ROLE_ADDRESS,
+        ROLE_NAME, // Alias, which falls back to the name or address
+        ROLE_ICON, // freedesktop icon name, e.g. "audio-headset"
+        ROLE_PAIRED,
+        ROLE_CONNECTED,
+        ROLE_RSSI, // dBm while discovering, 0 otherwise
+    };
+
+    CBluetoothDeviceModel(CDBusObjects* objects, QObject* parent = nullptr);
+
+    QHash<int, QByteArray> roleNames() const override;
+
+  protected:
+    QVariant value(const QString& path, const QVariantMap& properties, int role) const override;
+};
+
+// BluetoothState { bus: "system" }
+class CBluetoothState : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QString bus READ bus WRITE setBus NOTIFY busChanged)
+    Q_PROPERTY(bool available READ available NOTIFY availableChanged)
+    Q_PROPERTY(bool enabled READ enabled NOTIFY stateChanged)
+    Q_PROPERTY(bool discovering READ discovering NOTIFY stateChanged)
+    Q_PROPERTY(bool connected READ connected NOTIFY stateChanged)
+    Q_PROPERTY(int connectedDevices READ connectedDevices NOTIFY stateChanged)
+    Q_PROPERTY(QObject* devices READ devices CONSTANT)
+
+  public:
+    explicit CBluetoothState(QObject* parent = nullptr);
+
+    // "system", or "session" for a mock BlueZ (MOLTEN_DBUS_BUS sets the default)
+    QString          bus() const;
+    void             setBus(const QString& bus);
+
+    // BlueZ is running; enabled stays false while it has no adapter
+    bool             available() const;
+
+    // The first adapter's Powered and Discovering
+    bool             enabled() const;
+    bool             discovering() const;
+
+    bool             connected() const;
+    int              connectedDevices() const;
+
+    QObject*         devices();
+
+    Q_INVOKABLE void setEnabled(bool enabled);
+    Q_INVOKABLE void startDiscovery();
+    Q_INVOKABLE void stopDiscovery();
+
+    // By address, as bluetoothctl takes them
+    Q_INVOKABLE void connectDevice(const QString& address);
+    Q_INVOKABLE void disconnectDevice(const QString& address);
+
+  signals:
+    void busChanged();
+    void availableChanged();
+    void stateChanged();
+
+  private:
+    struct SState {
+        bool enabled          = false;
+        bool discovering      = false;
+        int  connectedDevices = 0;
+
+        bool operator==(const SState&) const = default;
+    };
+
+    CDBusObjects*          m_objects;
+    CBluetoothDeviceModel* m_devices;
+    SState                 m_state;
+
+    QString                adapter() const;
+    QString                device(const QString& address) const;
+    void                   update();
+};
@@ -0,0 +1,325 @@
+#include "ClipboardHistory.hpp"
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QDir>
+#include <QImageReader>
+#include <algorithm>
+
+// Characters of a text entry read for previews and searches; the rest only counts
+static constexpr qsizetype PREVIEW_CHARS = 200;
+static constexpr size_t    SEARCH_BYTES  = 64 * 1024;
+
+static bool isImage(std::string_view mime) {
+    return mime.starts_with("image/");
+}
+
+static QString idOf(uint64_t hash) {
+    return QString::number(hash, 16);
+}
+
+// ============================================================================
+// SERVICE
+// ============================================================================
+
+CClipboardService* CClipboardService::instance() {
+    static auto* service = new CClipboardService();
+    return service;
+}
+
+CClipboardService::CClipboardService() {
+    QString stateDir = qEnvironmentVariable("XDG_STATE_HOME");
+    if (stateDir.isEmpty())
+        stateDir = QDir::homePath() + "/.local/state";
+
+    QDir().mkpath(stateDir + "/molten");
+    m_log.open((stateDir + "/molten/clipboard.log").toStdString());
+    trim();
+
+    connect(&m_wayland, &CWaylandClipboard::selectionReceived, this, &CClipboardService::add);
+}
+
+const CClipboardLog& CClipboardService::log() const {
+    return m_log;
+}
+
+bool CClipboardService::isMonitoring() const {
+    return m_wayland.isAvailable();
+}
+
+void CClipboardService::add(const QString& mime, const QByteArray& data) {
+    size_t       superseded = CClipboardLog::NPOS;
+    const size_t INDEX      = m_log.append(mime.toStdString(), {data.constData(), static_cast<size_t>(data.size())}, QDateTime::currentMSecsSinceEpoch(), superseded);
+    if (INDEX == CClipboardLog::NPOS)
+        return;
+
+    emit appended(INDEX, superseded);
+    trim();
+}
+
+void CClipboardService::paste(size_t index) {
+    // Copies: the source serves them long after the log may have remapped
+    const QString    MIME = QString::fromUtf8(m_log.mime(index).data(), m_log.mime(index).size());
+    const QByteArray DATA(m_log.data(index).data(), m_log.data(index).size());
+
+    m_wayland.setSelection(MIME, DATA);
+
+    // Our own selection is never read back, so bump it here
+    add(MIME, DATA);
+}
+
+void CClipboardService::remove(size_t index) {
+    if (!m_log.entries()[index].alive)
+        return;
+
+    m_log.remove(index);
+    emit removed(index);
+}
+
+void CClipboardService::clear() {
+    m_log.clear();
+    m_oldest = 0;
+    emit cleared();
+}
+
+void CClipboardService::trim() {
+    const auto& ENTRIES = m_log.entries();
+
+    while (m_log.liveCount() > MAX_ENTRIES) {
+        while (!ENTRIES[m_oldest].alive)
+            ++m_oldest;
+        remove(m_oldest);
+    }
+}
+
+// ============================================================================
+// MODEL
+// ============================================================================
+
+CClipboardHistory::CClipboardHistory(QObject* parent) : QAbstractListModel(parent) {
+    auto* service = CClipboardService::instance();
+
+    connect(service, &CClipboardService::appended, this, &CClipboardHistory::onAppended);
+    connect(service, &CClipboardService::removed, this, &CClipboardHistory::onRemoved);
+    connect(service, &CClipboardService::cleared, this, &CClipboardHistory::reload);
+    reload();
+}
+
+QString CClipboardHistory::query() const {
+    return m_query;
+}
+
+void CClipboardHistory::setQuery(const QString& query) {
+    if (query == m_query)
+        return;
+
+    m_query = query;
+    emit queryChanged();
+    reload();
+}
+
+int CClipboardHistory::count() const {
+    return static_cast<int>(m_rows.size());
+}
+
+bool CClipboardHistory::monitoring() const {
+    return CClipboardService::instance()->isMonitoring();
+}
+
+bool CClipboardHistory::matches(size_t index) const {
+    if (m_query.isEmpty())
+        return true;
+
+    const auto& LOG = CClipboardService::instance()->log();
+    if (isImage(LOG.mime(index)))
+        return false;
+
+    const auto DATA = LOG.data(index).substr(0, SEARCH_BYTES);
+    return QString::fromUtf8(DATA.data(), DATA.size()).contains(m_query, Qt::CaseInsensitive);
+}
+
+int CClipboardHistory::rowOf(size_t index) const {
+    // Recent entries, the usual targets, sit at the back
+    const auto IT = std::find(m_rows.rbegin(), m_rows.rend(), index);
+    return IT == m_rows.rend() ? -1 : static_cast<int>(IT - m_rows.rbegin());
+}
+
+size_t CClipboardHistory::indexOf(const QString& id) const {
+    bool           ok   = false;
+    const uint64_t HASH = id.toULongLong(&ok, 16);
+    return ok ? CClipboardService::instance()->log().find(HASH) : CClipboardLog::NPOS;
+}
+
+const CClipboardHistory::SText& CClipboardHistory::text(size_t index) const {
+    if (const auto IT = m_text.constFind(index); IT != m_text.constEnd())
+        return *IT;
+
+    const auto DATA = CClipboardService::instance()->log().data(index);
+
+    SText      text;
+    for (const unsigned char C : DATA)
+        text.length += (C & 0xC0) != 0x80; // UTF-8 lead bytes: one per character
+
+    // Enough bytes for PREVIEW_CHARS of any script, on one line
+    const auto HEAD = DATA.substr(0, PREVIEW_CHARS * 4);
+    text.preview    = QString::fromUtf8(HEAD.data(), HEAD.size()).left(PREVIEW_CHARS).simplified();
+
+    return *m_text.insert(index, std::move(text));
+}
+
+void CClipboardHistory::reload() {
+    const auto& ENTRIES  = CClipboardService::instance()->log().entries();
+    const int   PREVIOUS = count();
+
+    beginResetModel();
+
+    m_rows.clear();
+    for (size_t i = 0; i < ENTRIES.size(); ++i) {
+        if (ENTRIES[i].alive && matches(i))
+            m_rows.push_back(i);
+    }
+
+    if (ENTRIES.empty())
+        m_text.clear();
+
+    endResetModel();
+
+    if (count() != PREVIOUS)
+        emit countChanged();
+}
+
+void CClipboardHistory::onAppended(size_t index, size_t superseded) {
+    // Same content again: its row moves to the top and now stands for the new entry
+    if (const int ROW = superseded == CClipboardLog::NPOS ? -1 : rowOf(superseded); ROW >= 0) {
+        if (ROW > 0) {
+            beginMoveRows({}, ROW, ROW, {}, 0);
+            m_rows.erase(m_rows.end() - 1 - ROW);
+            m_rows.push_back(index);
+            endMoveRows();
+        } else
+            m_rows.back() = index;
+
+        if (const auto IT = m_text.constFind(superseded); IT != m_text.constEnd())
+            m_text.insert(index, m_text.take(superseded));
+
+        emit dataChanged(this->index(0), this->index(0), {ROLE_ID, ROLE_TIMESTAMP});
+        return;
+    }
+
+    if (!matches(index))
+        return;
+
+    beginInsertRows({}, 0, 0);
+    m_rows.push_back(index);
+    endInsertRows();
+    emit countChanged();
+}
+
+void CClipboardHistory::onRemoved(size_t index) {
+    m_text.remove(index);
+
+    const int ROW = rowOf(index);
+    if (ROW < 0)
+        return;
+
+    beginRemoveRows({}, ROW, ROW);
+    m_rows.erase(m_rows.end() - 1 - ROW);
+    endRemoveRows();
+    emit countChanged();
+}
+
+int CClipboardHistory::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant CClipboardHistory::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= count())
+        return {};
+
+    const size_t ENTRY = m_rows[m_rows.size() - 1 - index.row()];
+    const auto&  LOG   = CClipboardService::instance()->log();
+    const auto   MIME  = LOG.mime(ENTRY);
+    const bool   IMAGE = isImage(MIME);
+
+    switch (role) {
+        case ROLE_ID: return idOf(LOG.entries()[ENTRY].hash);
+        case ROLE_PREVIEW: return IMAGE ? QString() : text(ENTRY).preview;
+        case ROLE_IS_IMAGE: return IMAGE;
+        case ROLE_MIME_TYPE: return QString::fromUtf8(MIME.data(), MIME.size());
+        case ROLE_LENGTH: return IMAGE ? static_cast<int>(LOG.entries()[ENTRY].dataLength) : text(ENTRY).length;
+        case ROLE_TIMESTAMP: return QDateTime::fromMSecsSinceEpoch(LOG.entries()[ENTRY].timestamp);
+        case ROLE_THUMBNAIL: return IMAGE ? QStringLiteral("image://molten-clipboard/") + idOf(LOG.entries()[ENTRY].hash) : QString();
+        default: return {};
+    }
+}
+
+QHash<int, QByteArray> CClipboardHistory::roleNames() const {
+    return {
+        {ROLE_ID, "id"},
+        {ROLE_PREVIEW, "preview"},
+        {ROLE_IS_IMAGE, "isImage"},
+        {ROLE_MIME_TYPE, "mimeType"},
+        {ROLE_LENGTH, "length"},
+        {ROLE_TIMESTAMP, "timestamp"},
+        {ROLE_THUMBNAIL, "thumbnail"},
+    };
+}
+
+QVariantMap CClipboardHistory::get(int row) const {
+    QVariantMap result;
+    if (row < 0 || row >= count())
+        return result;
+
+    const QModelIndex INDEX = index(row);
+    for (const auto& [role, name] : roleNames().asKeyValueRange())
+        result.insert(QString::fromUtf8(name), data(INDEX, role));
+
+    return result;
+}
+
+void CClipboardHistory::paste(const QString& id) {
+    if (const size_t INDEX = indexOf(id); INDEX != CClipboardLog::NPOS)
+        CClipboardService::instance()->paste(INDEX);
+}
+
+void CClipboardHistory::remove(const QString& id) {
+    if (const size_t INDEX = indexOf(id); INDEX != CClipboardLog::NPOS)
+        CClipboardService::instance()->remove(INDEX);
+}
+
+void CClipboardHistory::clear() {
+    CClipboardService::instance()->clear();
+}
+
+// ============================================================================
+// THUMBNAILS
+// ============================================================================
+
+CClipboardImageProvider::CClipboardImageProvider() : QQuickImageProvider(QQuickImageProvider::Image, QQmlImageProviderBase::ForceAsynchronousImageLoading) {
+    ;
+}
+
+QImage CClipboardImageProvider::requestImage(const QString& id, QSize* size, const QSize& requestedSize) {
+    bool           ok   = false;
+    const uint64_t HASH = id.toULongLong(&ok, 16);
+
+    std::string    mime, data;
+    if (!ok || !CClipboardService::instance()->log().copy(HASH, mime, data))
+        return {};
+
+    QByteArray   bytes = QByteArray::fromRawData(data.data(), static_cast<qsizetype>(data.size()));
+    QBuffer      buffer(&bytes);
+    QImageReader reader(&buffer);
+
+    const QSize  FULL = reader.size();
+    if (size)
+        *size = FULL;
+
+    // Decoders that support it (JPEG) scale while decoding; the rest decode then scale
+    if (FULL.isValid() && (requestedSize.width() > 0 || requestedSize.height() > 0)) {
+        const QSize BOUND = {requestedSize.width() > 0 ? requestedSize.width() : FULL.width(), requestedSize.height() > 0 ? requestedSize.height() : FULL.height()};
+        reader.setScaledSize(FULL.scaled(BOUND, Qt::KeepAspectRatio).boundedTo(FULL));
+    }
+
+    return reader.read();
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+/*
+ * Clipboard History QML Types
+ * ClipboardHistory is a list model, newest first, over one process-wide
+ * CClipboardLog fed by CWaylandClipboard. A copy inserts one row, copying
+ * something already in the history moves its row to the top, and a removal
+ * removes one row, so views never reload. Previews are decoded from the
+ * mapped log only for rows a view asks about; image rows carry an
+ * image://molten-clipboard/<id> URL that CClipboardImageProvider decodes off
+ * the GUI thread, at the size the delegate requests.
+ */
+
+#include "ClipboardLog.hpp"
+#include "WaylandClipboard.hpp"
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QObject>
+#include <QQuickImageProvider>
+#include <QVariantMap>
+#include <vector>
+
+// Owner of the shared log, created on first use and kept for the process lifetime
+class CClipboardService : public QObject {
+    Q_OBJECT
+
+  public:
+    static CClipboardService* instance();
+
+    const CClipboardLog&      log() const;
+    bool                      isMonitoring() const;
+
+    // Makes an entry the clipboard again, which also makes it the newest
+    void                      paste(size_t index);
+    void                      remove(size_t index);
+    void                      clear();
+
+  signals:
+    // Indices into log().entries(); superseded is CClipboardLog::NPOS for new content
+    void appended(size_t index, size_t superseded);
+    void removed(size_t index);
+    void cleared();
+
+  private:
+    CClipboardService();
+
+    // Oldest entries are removed past this
+    static constexpr size_t MAX_ENTRIES = 1000;
+
+    CClipboardLog           m_log;
+    CWaylandClipboard       m_wayland;
+    size_t                  m_oldest = 0; // No live entry before this index
+
+    void                    add(const QString& mime, const QByteArray& data);
+    void                    trim();
+};
+
+// ClipboardHistory { query: ... }
+class CClipboardHistory : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(bool monitoring READ monitoring CONSTANT)
+
+  public:
+    enum eRoles {
+        ROLE_ID = Qt::UserRole + 1,
+        ROLE_PREVIEW,
+        ROLE_IS_IMAGE,
+        ROLE_MIME_TYPE,
+        ROLE_LENGTH, // Characters of text, bytes of anything else
+        ROLE_TIMESTAMP,
+        ROLE_THUMBNAIL,
+    };
+
+    explicit CClipboardHistory(QObject* parent = nullptr);
+
+    QString                  query() const;
+    void                     setQuery(const QString& query);
+    int                      count() const;
+    bool                     monitoring() const;
+
+    int                      rowCount(const QModelIndex& parent = {}) const override;
+    QVariant                 data(const QModelIndex& index, int role) const override;
+    QHash<int, QByteArray>   roleNames() const override;
+
+    // Row as an object with the role names as keys
+    Q_INVOKABLE QVariantMap  get(int row) const;
+
+    Q_INVOKABLE void         paste(const QString& id);
+    Q_INVOKABLE void         remove(const QString& id);
+    Q_INVOKABLE void         clear();
+
+  signals:
+    void queryChanged();
+    void countChanged();
+
+  private:
+    struct SText {
+        QString preview;
+        int     length = 0;
+    };
+
+    // Log indices of the rows, oldest first: row r is m_rows[size - 1 - r], so a
+    // new entry is a push_back
+    std::vector<size_t>          m_rows;
+    QString                      m_query;
+    mutable QHash<size_t, SText> m_text; // Decoded lazily, entries never change
+
+    bool                         matches(size_t index) const;
+    int                          rowOf(size_t index) const;
+    size_t                       indexOf(const QString& id) const;
+    const SText&                 text(size_t index) const;
+    void                         reload();
+    void                         onAppended(size_t index, size_t superseded);
+    void                         onRemoved(size_t index);
+};
+
+// image://molten-clipboard/<id>
+class CClipboardImageProvider : public QQuickImageProvider {
+  public:
+    CClipboardImageProvider();
+
+    QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
+};
@@ -0,0 +1,272 @@
+#include "ClipboardLog.hpp"
+#include "ContentHash.hpp"
+
+#include <array>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// ============================================================================
+// RECORD FORMAT
+// ============================================================================
+
+namespace {
+    constexpr uint32_t MAGIC         = 0x4C43544D; // "MTCL"
+    constexpr uint32_t RECORD_ENTRY  = 1;
+    constexpr uint32_t RECORD_REMOVE = 2;
+
+    // Mapping headroom: appends within it reach the map without a remap
+    constexpr size_t   MAP_STEP = 4 << 20;
+
+    // Followed by the mime type and data, padded to 8 bytes
+    struct SRecordHeader {
+        uint32_t magic;
+        uint32_t type;
+        uint64_t hash;
+        uint64_t timestamp;
+        uint32_t mimeLength;
+        uint32_t dataLength;
+    };
+}
+
+static size_t recordSize(uint32_t mimeLength, uint32_t dataLength) {
+    return (sizeof(SRecordHeader) + mimeLength + dataLength + 7) & ~size_t{7};
+}
+
+// ============================================================================
+// FILE
+// ============================================================================
+
+CClipboardLog::~CClipboardLog() {
+    close();
+}
+
+void CClipboardLog::close() {
+    if (m_map)
+        munmap(m_map, m_capacity);
+    if (m_fd >= 0)
+        ::close(m_fd);
+
+    m_map      = nullptr;
+    m_capacity = 0;
+    m_size     = 0;
+    m_fd       = -1;
+}
+
+bool CClipboardLog::map(size_t needed) {
+    if (m_map && needed <= m_capacity)
+        return true;
+
+    // Mapping past the end of the file is fine as long as nothing reads there
+    const size_t CAPACITY = (needed / MAP_STEP + 1) * MAP_STEP;
+    void*        mapping  = m_map ? mremap(m_map, m_capacity, CAPACITY, MREMAP_MAYMOVE) : mmap(nullptr, CAPACITY, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (mapping == MAP_FAILED)
+        return false;
+
+    m_map      = static_cast<char*>(mapping);
+    m_capacity = CAPACITY;
+    return true;
+}
+
+bool CClipboardLog::open(const std::string& path) {
+    {
+        std::lock_guard lock(m_mutex);
+        close();
+
+        m_path = path;
+        m_fd   = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (m_fd < 0)
+            return false;
+
+        struct stat st;
+        if (fstat(m_fd, &st) != 0 || !map(st.st_size)) {
+            close();
+            return false;
+        }
+
+        m_size = st.st_size;
+        replay();
+    }
+
+    return compact();
+}
+
+bool CClipboardLog::replay() {
+    m_entries.clear();
+    m_live.clear();
+
+    size_t at = 0;
+    while (at + sizeof(SRecordHeader) <= m_size) {
+        SRecordHeader header;
+        std::memcpy(&header, m_map + at, sizeof(header));
+
+        const size_t SIZE = recordSize(header.mimeLength, header.dataLength);
+        if (header.magic != MAGIC || at + SIZE > m_size)
+            break;
+
+        if (header.type == RECORD_ENTRY) {
+            if (const auto OLD = m_live.find(header.hash); OLD != m_live.end())
+                m_entries[OLD->second].alive = false;
+
+            m_live[header.hash] = m_entries.size();
+            m_entries.push_back({header.hash, header.timestamp, at, header.mimeLength, header.dataLength, true});
+        } else if (header.type == RECORD_REMOVE) {
+            if (const auto OLD = m_live.find(header.hash); OLD != m_live.end()) {
+                m_entries[OLD->second].alive = false;
+                m_live.erase(OLD);
+            }
+        } else
+            break;
+
+        at += SIZE;
+    }
+
+    // A write torn by a crash: drop it so appends continue from a record boundary
+    if (at != m_size) {
+        if (ftruncate(m_fd, at) != 0)
+            return false;
+        m_size = at;
+    }
+
+    return true;
+}
+
+bool CClipboardLog::compact() {
+    // Rewriting costs a full copy; only worth it once most records are dead
+    if (m_entries.size() < 64 || m_live.size() * 2 > m_entries.size())
+        return true;
+
+    const std::string TMP = m_path + ".tmp";
+    const int         FD  = ::open(TMP.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (FD < 0)
+        return true;
+
+    bool ok = true;
+    for (const auto& entry : m_entries) {
+        if (!entry.alive)
+            continue;
+
+        const size_t SIZE = recordSize(entry.mimeLength, entry.dataLength);
+        if (::write(FD, m_map + entry.offset, SIZE) != static_cast<ssize_t>(SIZE)) {
+            ok = false;
+            break;
+        }
+    }
+    ::close(FD);
+
+    if (!ok || rename(TMP.c_str(), m_path.c_str()) != 0) {
+        unlink(TMP.c_str());
+        return true;
+    }
+
+    return open(m_path);
+}
+
+bool CClipboardLog::write(uint32_t type, uint64_t hash, uint64_t timestamp, std::string_view mime, std::string_view data) {
+    const SRecordHeader       HEADER  = {MAGIC, type, hash, timestamp, static_cast<uint32_t>(mime.size()), static_cast<uint32_t>(data.size())};
+    const size_t              SIZE    = recordSize(HEADER.mimeLength, HEADER.dataLength);
+    static constexpr uint64_t PADDING = 0;
+
+    const std::array<iovec, 4> PARTS = {{
+        {const_cast<SRecordHeader*>(&HEADER), sizeof(HEADER)},
+        {const_cast<char*>(mime.data()), mime.size()},
+        {const_cast<char*>(data.data()), data.size()},
+        {const_cast<uint64_t*>(&PADDING), SIZE - sizeof(HEADER) - mime.size() - data.size()},
+    }};
+
+    // data may point into the map: write before anything can remap it
+    if (pwritev(m_fd, PARTS.data(), PARTS.size(), m_size) != static_cast<ssize_t>(SIZE)) {
+        // Leave no partial record behind; replay() would drop it anyway
+        [[maybe_unused]] const int TRUNCATED = ftruncate(m_fd, m_size);
+        return false;
+    }
+
+    m_size += SIZE;
+    return map(m_size);
+}
+
+// ============================================================================
+// ENTRIES
+// ============================================================================
+
+const std::vector<CClipboardLog::SEntry>& CClipboardLog::entries() const {
+    return m_entries;
+}
+
+size_t CClipboardLog::liveCount() const {
+    return m_live.size();
+}
+
+size_t CClipboardLog::find(uint64_t hash) const {
+    const auto IT = m_live.find(hash);
+    return IT == m_live.end() ? NPOS : IT->second;
+}
+
+size_t CClipboardLog::append(std::string_view mime, std::string_view data, uint64_t timestamp, size_t& superseded) {
+    std::lock_guard lock(m_mutex);
+
+    const uint64_t  HASH   = hash(mime, data);
+    const size_t    OFFSET = m_size;
+    superseded             = NPOS;
+    if (m_fd < 0 || !write(RECORD_ENTRY, HASH, timestamp, mime, data))
+        return NPOS;
+
+    if (const auto OLD = m_live.find(HASH); OLD != m_live.end()) {
+        m_entries[OLD->second].alive = false;
+        superseded                   = OLD->second;
+    }
+
+    m_live[HASH] = m_entries.size();
+    m_entries.push_back({HASH, timestamp, OFFSET, static_cast<uint32_t>(mime.size()), static_cast<uint32_t>(data.size()), true});
+    return m_entries.size() - 1;
+}
+
+void CClipboardLog::remove(size_t index) {
+    std::lock_guard lock(m_mutex);
+
+    auto&           entry = m_entries[index];
+    if (!entry.alive || !write(RECORD_REMOVE, entry.hash, 0, {}, {}))
+        return;
+
+    entry.alive = false;
+    m_live.erase(entry.hash);
+}
+
+void CClipboardLog::clear() {
+    std::lock_guard lock(m_mutex);
+
+    if (m_fd >= 0 && ftruncate(m_fd, 0) == 0)
+        m_size = 0;
+
+    m_entries.clear();
+    m_live.clear();
+}
+
+std::string_view CClipboardLog::mime(size_t index) const {
+    const auto& ENTRY = m_entries[index];
+    return {m_map + ENTRY.offset + sizeof(SRecordHeader), ENTRY.mimeLength};
+}
+
+std::string_view CClipboardLog::data(size_t index) const {
+    const auto& ENTRY = m_entries[index];
+    return {m_map + ENTRY.offset + sizeof(SRecordHeader) + ENTRY.mimeLength, ENTRY.dataLength};
+}
+
+bool CClipboardLog::copy(uint64_t hash, std::string& mimeOut, std::string& dataOut) const {
+    std::lock_guard lock(m_mutex);
+
+    const size_t    INDEX = find(hash);
+    if (INDEX == NPOS)
+        return false;
+
+    mimeOut = mime(INDEX);
+    dataOut = data(INDEX);
+    return true;
+}
+
+uint64_t CClipboardLog::hash(std::string_view mime, std::string_view data) {
+    return NHash::bytes(data, NHash::bytes(mime));
+}
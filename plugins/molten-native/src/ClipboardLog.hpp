@@ -0,0 +1,81 @@
+#pragma once
+
+/*
+ * Clipboard Log
+ * Append-only history file: each copy appends a record holding its mime type
+ * and bytes, each removal appends a tombstone. The file is mmap'd with room to
+ * grow, so appends rarely remap and entries are read in place. Entries are
+ * keyed by a content hash; copying something already in the history
+ * supersedes the old record instead of adding a second one. Dead records are
+ * compacted away when the log is opened.
+ *
+ * The owning thread does all mutation; copy() may be called from any thread.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class CClipboardLog {
+  public:
+    CClipboardLog() = default;
+    ~CClipboardLog();
+
+    CClipboardLog(const CClipboardLog&)            = delete;
+    CClipboardLog& operator=(const CClipboardLog&) = delete;
+
+    struct SEntry {
+        uint64_t hash       = 0;
+        uint64_t timestamp  = 0; // ms since the epoch
+        uint64_t offset     = 0; // Record start in the file
+        uint32_t mimeLength = 0;
+        uint32_t dataLength = 0;
+        bool     alive      = true;
+    };
+
+    static constexpr size_t NPOS = SIZE_MAX;
+
+    // Opens (creating if needed, mode 0600), replays and compacts the log
+    bool                       open(const std::string& path);
+
+    // Log order, oldest first; dead entries stay until the next open()
+    const std::vector<SEntry>& entries() const;
+    size_t                     liveCount() const;
+    size_t                     find(uint64_t hash) const;
+
+    // Index of the new entry; superseded is the live entry with the same content, or NPOS
+    size_t                     append(std::string_view mime, std::string_view data, uint64_t timestamp, size_t& superseded);
+
+    // Tombstones a live entry
+    void                       remove(size_t index);
+    void                       clear();
+
+    // In-place views, owning thread only: an append may remap
+    std::string_view           mime(size_t index) const;
+    std::string_view           data(size_t index) const;
+
+    // Copies out an entry's bytes, safe against concurrent appends
+    bool                       copy(uint64_t hash, std::string& mime, std::string& data) const;
+
+    static uint64_t            hash(std::string_view mime, std::string_view data);
+
+  private:
+    int                                  m_fd       = -1;
+    std::string                          m_path;
+    char*                                m_map      = nullptr;
+    size_t                               m_capacity = 0; // Mapped bytes, past the end of the file
+    size_t                               m_size     = 0; // File size
+    std::vector<SEntry>                  m_entries;
+    std::unordered_map<uint64_t, size_t> m_live; // hash -> index
+    mutable std::mutex                   m_mutex;
+
+    bool                                 map(size_t needed);
+    void                                 close();
+    bool                                 replay();
+    bool                                 compact();
+    bool                                 write(uint32_t type, uint64_t hash, uint64_t timestamp, std::string_view mime, std::string_view data);
+};
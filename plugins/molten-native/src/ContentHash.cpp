@@ -0,0 +1,29 @@
+#include "ContentHash.hpp"
+
+#include <cstring>
+
+static uint64_t mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64_t NHash::bytes(std::string_view bytes, uint64_t seed) {
+    uint64_t    h = seed ^ (bytes.size() * 0x9E3779B97F4A7C15ULL);
+    const char* P = bytes.data();
+    size_t      n = bytes.size();
+
+    for (; n >= 8; P += 8, n -= 8) {
+        uint64_t word;
+        std::memcpy(&word, P, 8);
+        h ^= mix(word);
+        h = (h << 27 | h >> 37) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    uint64_t tail = 0;
+    std::memcpy(&tail, P, n);
+    return mix(h ^ tail);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+/*
+ * Content Hash
+ * 64-bit non-cryptographic hash for deduplicating stored content (clipboard
+ * entries, cached images). Consumes 8 bytes per step, since inputs run to
+ * megabytes.
+ */
+
+#include <cstdint>
+#include <string_view>
+
+namespace NHash {
+    // Chain calls through seed to hash several fields as one
+    uint64_t bytes(std::string_view bytes, uint64_t seed = 0);
+}
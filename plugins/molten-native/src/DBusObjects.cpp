@@ -0,0 +1,470 @@
+#include "DBusObjects.hpp"
+
+#include <QDBusArgument>
+#include <QDBusConnectionInterface>
+#include <QDBusObjectPath>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+#include <QDBusVariant>
+#include <QtGlobal>
+#include <algorithm>
+#include <utility>
+
+constexpr const char* PROPERTIES_INTERFACE     = "org.freedesktop.DBus.Properties";
+constexpr const char* OBJECT_MANAGER_INTERFACE = "org.freedesktop.DBus.ObjectManager";
+
+static QString pendingKey(const QString& path, const QString& interface) {
+    return path + '\n' + interface;
+}
+
+// a{sa{sv}}: interface name -> properties
+static QHash<QString, QVariantMap> readInterfaces(const QDBusArgument& argument) {
+    QHash<QString, QVariantMap> interfaces;
+
+    argument.beginMap();
+    while (!argument.atEnd()) {
+        QString     name;
+        QVariantMap properties;
+        argument.beginMapEntry();
+        argument >> name >> properties;
+        argument.endMapEntry();
+        interfaces.insert(name, properties);
+    }
+    argument.endMap();
+
+    return interfaces;
+}
+
+CDBusObjects::CDBusObjects(const QString& bus, const QString& service, QObject* parent) : QObject(parent), m_bus(bus), m_service(service) {
+    attach();
+}
+
+QString CDBusObjects::defaultBus() {
+    return qEnvironmentVariable("MOLTEN_DBUS_BUS", "system");
+}
+
+// ============================================================================
+// BUS
+// ============================================================================
+
+QDBusConnection CDBusObjects::connection() const {
+    return m_bus == "session" ? QDBusConnection::sessionBus() : QDBusConnection::systemBus();
+}
+
+const QString& CDBusObjects::bus() const {
+    return m_bus;
+}
+
+void CDBusObjects::setBus(const QString& bus) {
+    if (bus == m_bus)
+        return;
+
+    detach();
+    clear();
+    m_bus = bus;
+    attach();
+
+    if (!m_managed.isEmpty())
+        fetchManaged();
+
+    emit registeredChanged();
+}
+
+const QString& CDBusObjects::service() const {
+    return m_service;
+}
+
+bool CDBusObjects::isRegistered() const {
+    return m_registered;
+}
+
+void CDBusObjects::attach() {
+    auto bus = connection();
+
+    m_watcher = new QDBusServiceWatcher(m_service, bus, QDBusServiceWatcher::WatchForRegistration | QDBusServiceWatcher::WatchForUnregistration, this);
+    connect(m_watcher, &QDBusServiceWatcher::serviceRegistered, this, [this]() {
+        m_registered = true;
+        if (!m_managed.isEmpty())
+            fetchManaged();
+        emit registeredChanged();
+    });
+    connect(m_watcher, &QDBusServiceWatcher::serviceUnregistered, this, [this]() {
+        clear();
+        m_registered = false;
+        emit registeredChanged();
+    });
+
+    // No path: one match rule covers every object of the service
+    bus.connect(m_service, QString(), PROPERTIES_INTERFACE, "PropertiesChanged", this, SLOT(onPropertiesChanged(QDBusMessage)));
+
+    if (!m_managed.isEmpty()) {
+        bus.connect(m_service, m_managed, OBJECT_MANAGER_INTERFACE, "InterfacesAdded", this, SLOT(onInterfacesAdded(QDBusMessage)));
+        bus.connect(m_service, m_managed, OBJECT_MANAGER_INTERFACE, "InterfacesRemoved", this, SLOT(onInterfacesRemoved(QDBusMessage)));
+    }
+
+    for (const auto& subscription : m_subscriptions)
+        bus.connect(m_service, QString(), subscription[0], subscription[1], this, SLOT(onSignal(QDBusMessage)));
+
+    m_registered = bus.isConnected() && bus.interface()->isServiceRegistered(m_service);
+}
+
+void CDBusObjects::detach() {
+    auto bus = connection();
+
+    delete m_watcher;
+    m_watcher = nullptr;
+
+    bus.disconnect(m_service, QString(), PROPERTIES_INTERFACE, "PropertiesChanged", this, SLOT(onPropertiesChanged(QDBusMessage)));
+
+    if (!m_managed.isEmpty()) {
+        bus.disconnect(m_service, m_managed, OBJECT_MANAGER_INTERFACE, "InterfacesAdded", this, SLOT(onInterfacesAdded(QDBusMessage)));
+        bus.disconnect(m_service, m_managed, OBJECT_MANAGER_INTERFACE, "InterfacesRemoved", this, SLOT(onInterfacesRemoved(QDBusMessage)));
+    }
+
+    for (const auto& subscription : m_subscriptions)
+        bus.disconnect(m_service, QString(), subscription[0], subscription[1], this, SLOT(onSignal(QDBusMessage)));
+}
+
+// ============================================================================
+// OBJECTS
+// ============================================================================
+
+void CDBusObjects::add(const QString& path, const QString& interface) {
+    const QString KEY = pendingKey(path, interface);
+    if (properties(path, interface) || m_pending.contains(KEY))
+        return;
+
+    m_pending.insert(KEY);
+
+    auto message = QDBusMessage::createMethodCall(m_service, path, PROPERTIES_INTERFACE, "GetAll");
+    message << interface;
+
+    auto* watcher = new QDBusPendingCallWatcher(connection().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path, interface, KEY](QDBusPendingCallWatcher* call) {
+        call->deleteLater();
+
+        // Removed, or the service left, while the call ran
+        if (!m_pending.remove(KEY))
+            return;
+
+        const QDBusPendingReply<QVariantMap> REPLY = *call;
+        if (REPLY.isError()) {
+            qWarning("%s: GetAll(%s) on %s failed: %s", qPrintable(m_service), qPrintable(interface), qPrintable(path), qPrintable(REPLY.error().message()));
+            return;
+        }
+
+        insert(path, interface, REPLY.value());
+    });
+}
+
+void CDBusObjects::manage(const QString& root) {
+    if (!m_managed.isEmpty())
+        return;
+
+    auto bus  = connection();
+    m_managed = root;
+    bus.connect(m_service, m_managed, OBJECT_MANAGER_INTERFACE, "InterfacesAdded", this, SLOT(onInterfacesAdded(QDBusMessage)));
+    bus.connect(m_service, m_managed, OBJECT_MANAGER_INTERFACE, "InterfacesRemoved", this, SLOT(onInterfacesRemoved(QDBusMessage)));
+
+    fetchManaged();
+}
+
+void CDBusObjects::fetchManaged() {
+    const auto MESSAGE = QDBusMessage::createMethodCall(m_service, m_managed, OBJECT_MANAGER_INTERFACE, "GetManagedObjects");
+
+    auto*      watcher = new QDBusPendingCallWatcher(connection().asyncCall(MESSAGE), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher* call) {
+        call->deleteLater();
+
+        // Not running is not an error: it is fetched again once it registers
+        if (call->isError()) {
+            if (m_registered)
+                qWarning("%s: GetManagedObjects failed: %s", qPrintable(m_service), qPrintable(call->error().message()));
+            return;
+        }
+
+        const auto ARGUMENTS = call->reply().arguments();
+        if (ARGUMENTS.isEmpty())
+            return;
+
+        // a{oa{sa{sv}}}
+        const QDBusArgument ARGUMENT = ARGUMENTS.first().value<QDBusArgument>();
+        ARGUMENT.beginMap();
+        while (!ARGUMENT.atEnd()) {
+            QDBusObjectPath path;
+            ARGUMENT.beginMapEntry();
+            ARGUMENT >> path;
+            const auto INTERFACES = readInterfaces(ARGUMENT);
+            ARGUMENT.endMapEntry();
+
+            for (const auto& [interface, properties] : INTERFACES.asKeyValueRange())
+                insert(path.path(), interface, properties);
+        }
+        ARGUMENT.endMap();
+    });
+}
+
+void CDBusObjects::insert(const QString& path, const QString& interface, const QVariantMap& properties) {
+    auto object = m_objects.find(path);
+    if (object == m_objects.end()) {
+        object = m_objects.insert(path, {});
+        m_order.push_back(path);
+    }
+
+    const bool KNOWN = object->interfaces.contains(interface);
+    object->interfaces.insert(interface, properties);
+
+    // Fetched again (service restart, repeated GetManagedObjects): everything may have changed
+    if (KNOWN)
+        emit changed(path, interface, properties.keys());
+    else
+        emit added(path, interface);
+}
+
+void CDBusObjects::remove(const QString& path, const QString& interface) {
+    if (interface.isEmpty()) {
+        const QString PREFIX = path + '\n';
+        m_pending.removeIf([&PREFIX](const QString& key) { return key.startsWith(PREFIX); });
+    } else
+        m_pending.remove(pendingKey(path, interface));
+
+    auto object = m_objects.find(path);
+    if (object == m_objects.end())
+        return;
+
+    QStringList gone;
+    if (interface.isEmpty())
+        gone = object->interfaces.keys();
+    else if (object->interfaces.contains(interface))
+        gone << interface;
+
+    for (const auto& name : gone)
+        object->interfaces.remove(name);
+
+    if (object->interfaces.isEmpty()) {
+        m_objects.erase(object);
+        m_order.erase(std::find(m_order.begin(), m_order.end(), path));
+    }
+
+    // Listeners see the object already gone
+    for (const auto& name : gone)
+        emit removed(path, name);
+}
+
+void CDBusObjects::clear() {
+    const auto OBJECTS = std::exchange(m_objects, {});
+    const auto ORDER   = std::exchange(m_order, {});
+    m_pending.clear();
+
+    for (const auto& path : ORDER) {
+        for (const auto& interface : OBJECTS.value(path).interfaces.keys())
+            emit removed(path, interface);
+    }
+}
+
+const QVariantMap* CDBusObjects::properties(const QString& path, const QString& interface) const {
+    const auto OBJECT = m_objects.constFind(path);
+    if (OBJECT == m_objects.cend())
+        return nullptr;
+
+    const auto PROPERTIES = OBJECT->interfaces.constFind(interface);
+    return PROPERTIES == OBJECT->interfaces.cend() ? nullptr : &*PROPERTIES;
+}
+
+QVariant CDBusObjects::value(const QString& path, const QString& interface, const QString& name) const {
+    const auto* PROPERTIES = properties(path, interface);
+    return PROPERTIES ? PROPERTIES->value(name) : QVariant();
+}
+
+QStringList CDBusObjects::objects(const QString& interface) const {
+    QStringList result;
+    for (const auto& path : m_order) {
+        const auto OBJECT = m_objects.constFind(path);
+        if (OBJECT != m_objects.cend() && OBJECT->interfaces.contains(interface))
+            result << path;
+    }
+
+    return result;
+}
+
+// ============================================================================
+// SIGNALS
+// ============================================================================
+
+void CDBusObjects::onPropertiesChanged(const QDBusMessage& message) {
+    const auto ARGUMENTS = message.arguments();
+    if (ARGUMENTS.size() < 2)
+        return;
+
+    // Only interfaces already fetched: GetAll replies carry everything up to then
+    const QString INTERFACE = ARGUMENTS[0].toString();
+    auto          object    = m_objects.find(message.path());
+    if (object == m_objects.end())
+        return;
+
+    auto properties = object->interfaces.find(INTERFACE);
+    if (properties == object->interfaces.end())
+        return;
+
+    QStringList       names;
+    const QVariantMap CHANGED = qdbus_cast<QVariantMap>(ARGUMENTS[1]);
+    for (const auto& [name, value] : CHANGED.asKeyValueRange()) {
+        properties->insert(name, value);
+        names << name;
+    }
+
+    // Invalidated properties come without a value; readers see them unset
+    if (ARGUMENTS.size() > 2) {
+        for (const auto& name : ARGUMENTS[2].toStringList()) {
+            properties->remove(name);
+            names << name;
+        }
+    }
+
+    if (!names.isEmpty())
+        emit changed(message.path(), INTERFACE, names);
+}
+
+void CDBusObjects::subscribe(const QString& interface, const QString& name) {
+    const QStringList SUBSCRIPTION = {interface, name};
+    if (m_subscriptions.contains(SUBSCRIPTION))
+        return;
+
+    m_subscriptions << SUBSCRIPTION;
+    connection().connect(m_service, QString(), interface, name, this, SLOT(onSignal(QDBusMessage)));
+}
+
+void CDBusObjects::onSignal(const QDBusMessage& message) {
+    emit signalled(message.path(), message.interface(), message.member(), message.arguments());
+}
+
+void CDBusObjects::onInterfacesAdded(const QDBusMessage& message) {
+    const auto ARGUMENTS = message.arguments();
+    if (ARGUMENTS.size() < 2)
+        return;
+
+    const QString PATH       = ARGUMENTS[0].value<QDBusObjectPath>().path();
+    const auto    INTERFACES = readInterfaces(ARGUMENTS[1].value<QDBusArgument>());
+    for (const auto& [interface, properties] : INTERFACES.asKeyValueRange())
+        insert(PATH, interface, properties);
+}
+
+void CDBusObjects::onInterfacesRemoved(const QDBusMessage& message) {
+    const auto ARGUMENTS = message.arguments();
+    if (ARGUMENTS.size() < 2)
+        return;
+
+    const QString PATH = ARGUMENTS[0].value<QDBusObjectPath>().path();
+    for (const auto& interface : ARGUMENTS[1].toStringList())
+        remove(PATH, interface);
+}
+
+// ============================================================================
+// CALLS
+// ============================================================================
+
+void CDBusObjects::call(const QString& path, const QString& interface, const QString& method, const QVariantList& arguments) {
+    auto message = QDBusMessage::createMethodCall(m_service, path, interface, method);
+    message.setArguments(arguments);
+
+    auto* watcher = new QDBusPendingCallWatcher(connection().asyncCall(message), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path, method](QDBusPendingCallWatcher* call) {
+        call->deleteLater();
+        if (call->isError())
+            qWarning("%s: %s on %s failed: %s", qPrintable(m_service), qPrintable(method), qPrintable(path), qPrintable(call->error().message()));
+    });
+}
+
+void CDBusObjects::write(const QString& path, const QString& interface, const QString& name, const QVariant& value) {
+    call(path, PROPERTIES_INTERFACE, "Set", {interface, name, QVariant::fromValue(QDBusVariant(value))});
+}
+
+// ============================================================================
+// MODEL
+// ============================================================================
+
+CDBusObjectModel::CDBusObjectModel(CDBusObjects* objects, const QString& interface, QObject* parent) :
+    QAbstractListModel(parent), m_objects(objects), m_interface(interface) {
+    for (const auto& path : objects->objects(interface))
+        m_rows.push_back(path);
+
+    connect(objects, &CDBusObjects::added, this, &CDBusObjectModel::onAdded);
+    connect(objects, &CDBusObjects::changed, this, [this](const QString& path, const QString& interface) { onChanged(path, interface); });
+    connect(objects, &CDBusObjects::removed, this, &CDBusObjectModel::onRemoved);
+}
+
+// A few dozen rows at most: a scan beats keeping an index in step
+int CDBusObjectModel::rowOf(const QString& path) const {
+    const auto IT = std::find(m_rows.begin(), m_rows.end(), path);
+    return IT == m_rows.end() ? -1 : static_cast<int>(IT - m_rows.begin());
+}
+
+void CDBusObjectModel::onAdded(const QString& path, const QString& interface) {
+    if (interface != m_interface || rowOf(path) >= 0)
+        return;
+
+    const int ROW = count();
+    beginInsertRows({}, ROW, ROW);
+    m_rows.push_back(path);
+    endInsertRows();
+    emit countChanged();
+}
+
+void CDBusObjectModel::onChanged(const QString& path, const QString& interface) {
+    if (interface == m_interface)
+        refresh(path);
+}
+
+void CDBusObjectModel::onRemoved(const QString& path, const QString& interface) {
+    if (interface != m_interface)
+        return;
+
+    const int ROW = rowOf(path);
+    if (ROW < 0)
+        return;
+
+    beginRemoveRows({}, ROW, ROW);
+    m_rows.erase(m_rows.begin() + ROW);
+    endRemoveRows();
+    emit countChanged();
+}
+
+void CDBusObjectModel::refresh(const QString& path) {
+    const int ROW = rowOf(path);
+    if (ROW >= 0)
+        emit dataChanged(index(ROW), index(ROW));
+}
+
+int CDBusObjectModel::count() const {
+    return static_cast<int>(m_rows.size());
+}
+
+int CDBusObjectModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : count();
+}
+
+QString CDBusObjectModel::pathAt(int row) const {
+    return row >= 0 && row < count() ? m_rows[row] : QString();
+}
+
+QVariant CDBusObjectModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= count())
+        return {};
+
+    const QString& PATH       = m_rows[index.row()];
+    const auto*    PROPERTIES = m_objects->properties(PATH, m_interface);
+    return PROPERTIES ? value(PATH, *PROPERTIES, role) : QVariant();
+}
+
+QVariantMap CDBusObjectModel::get(int row) const {
+    QVariantMap result;
+    if (row < 0 || row >= count())
+        return result;
+
+    const QModelIndex INDEX = index(row);
+    for (const auto& [role, name] : roleNames().asKeyValueRange())
+        result.insert(QString::fromUtf8(name), data(INDEX, role));
+
+    return result;
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+/*
+ * D-Bus Object Mirror
+ * A local copy of the properties of one service's objects, read once and
+ * then kept current from PropertiesChanged signals instead of polled.
+ * Objects come in either one interface at a time (GetAll) or, for services
+ * with an ObjectManager, all at once with InterfacesAdded/InterfacesRemoved
+ * following. Every change is reported per object, so a model built on top
+ * updates one row at a time. Other signals of the service's objects can be
+ * forwarded too.
+ *
+ * The bus is the system bus unless MOLTEN_DBUS_BUS=session, so the services
+ * can be stood in for by mocks on a private session bus.
+ */
+
+#include <QAbstractListModel>
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <vector>
+
+class QDBusServiceWatcher;
+
+class CDBusObjects : public QObject {
+    Q_OBJECT
+
+  public:
+    CDBusObjects(const QString& bus, const QString& service, QObject* parent = nullptr);
+
+    // "system" or "session": MOLTEN_DBUS_BUS, system if unset
+    static QString     defaultBus();
+
+    // Moving to another bus empties the mirror; managed objects are fetched again
+    const QString&     bus() const;
+    void               setBus(const QString& bus);
+
+    QDBusConnection    connection() const;
+    const QString&     service() const;
+
+    // Whether the service is on the bus; the mirror is emptied when it leaves
+    bool               isRegistered() const;
+
+    // Fetch an object's properties for one interface and follow their changes
+    void               add(const QString& path, const QString& interface);
+
+    // Mirror everything an ObjectManager at root reports, now and later
+    void               manage(const QString& root);
+
+    // Stop following one interface of an object, or all of them
+    void               remove(const QString& path, const QString& interface = {});
+
+    // Properties of path for interface, nullptr until they have arrived
+    const QVariantMap* properties(const QString& path, const QString& interface) const;
+    QVariant           value(const QString& path, const QString& interface, const QString& name) const;
+
+    // Objects that have interface, in the order they arrived
+    QStringList        objects(const QString& interface) const;
+
+    // Forward a signal of any of the service's objects as signalled()
+    void               subscribe(const QString& interface, const QString& name);
+
+    // Asynchronous; failures are logged
+    void               call(const QString& path, const QString& interface, const QString& method, const QVariantList& arguments = {});
+    void               write(const QString& path, const QString& interface, const QString& name, const QVariant& value);
+
+  signals:
+    void registeredChanged();
+    void added(const QString& path, const QString& interface);
+    void changed(const QString& path, const QString& interface, const QStringList& names);
+    void removed(const QString& path, const QString& interface);
+    void signalled(const QString& path, const QString& interface, const QString& name, const QVariantList& arguments);
+
+  private slots:
+    void onPropertiesChanged(const QDBusMessage& message);
+    void onSignal(const QDBusMessage& message);
+    void onInterfacesAdded(const QDBusMessage& message);
+    void onInterfacesRemoved(const QDBusMessage& message);
+
+  private:
+    struct SObject {
+        QHash<QString, QVariantMap> interfaces;
+    };
+
+    QString                  m_bus;
+    QString                  m_service;
+    QDBusServiceWatcher*     m_watcher    = nullptr;
+    bool                     m_registered = false;
+
+    QHash<QString, SObject>  m_objects;
+    std::vector<QString>     m_order;   // Paths in arrival order
+    QSet<QString>            m_pending; // path + '\n' + interface, awaiting GetAll
+    QString                  m_managed; // ObjectManager root, if any
+    QList<QStringList>       m_subscriptions; // {interface, name}
+
+    void                     attach();
+    void                     detach();
+    void                     insert(const QString& path, const QString& interface, const QVariantMap& properties);
+    void                     fetchManaged();
+    void                     clear();
+};
+
+// Rows for the objects of one interface in a CDBusObjects, in arrival order;
+// an object added, changed or removed touches only its own row
+class CDBusObjectModel : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  public:
+    CDBusObjectModel(CDBusObjects* objects, const QString& interface, QObject* parent = nullptr);
+
+    int                     count() const;
+    int                     rowCount(const QModelIndex& parent = {}) const override;
+    QVariant                data(const QModelIndex& index, int role) const override;
+
+    // Row as an object with the role names as keys
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+    // Tell views a row changed for reasons outside its own properties
+    void                    refresh(const QString& path);
+
+    QString                 pathAt(int row) const;
+
+  signals:
+    void countChanged();
+
+  protected:
+    CDBusObjects* m_objects;
+    QString       m_interface;
+
+    // A role's value for one object
+    virtual QVariant value(const QString& path, const QVariantMap& properties, int role) const = 0;
+
+  private:
+    std::vector<QString> m_rows;
+
+    int                  rowOf(const QString& path) const;
+    void                 onAdded(const QString& path, const QString& interface);
+    void                 onChanged(const QString& path, const QString& interface);
+    void                 onRemoved(const QString& path, const QString& interface);
+};
@@ -0,0 +1,861 @@
+#include "DesktopIndex.hpp"
+#include "FuzzyMatch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <tuple>
+#include <type_traits>
+#include <unistd.h>
+
+// ============================================================================
+// INDEX FORMAT
+// ============================================================================
+
+// [SHeader][SRecord x entries][SSlot x slots][blob]; every string is an
+// (offset, length) pair into the blob and is also NUL-terminated there
+namespace {
+    constexpr std::array<char, 8> MAGIC      = {'M', 'O', 'L', 'T', 'I', 'D', 'X', '1'};
+    constexpr uint32_t            VERSION    = 1;
+    constexpr uint32_t            EMPTY_SLOT = UINT32_MAX;
+    constexpr size_t              QUERY_MAX  = 256;
+
+    struct SString {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    struct SHeader {
+        std::array<char, 8> magic;
+        uint32_t            version;
+        uint32_t            entries;
+        uint32_t            slots; // Power of two
+        uint32_t            blobSize;
+        uint64_t            signature;
+    };
+
+    struct SRecord {
+        // Display strings
+        SString  id, name, genericName, comment, icon, exec, keywords, categories, wmClass;
+
+        // Lowercased match keys
+        SString  nameKey, execKey, genericKey, commentKey, keywordsKey;
+
+        uint16_t root;
+        uint16_t flags;
+        uint32_t padding;
+
+        // Prefilters, see NFuzzy
+        uint64_t nameChars; // charMask of the name key, for fuzzy matches
+        uint64_t chars;     // charMask of all keys
+        uint64_t pairs;     // pairMask of all keys, for substring matches
+    };
+
+    // Window class -> entry, open addressing with linear probing
+    struct SSlot {
+        uint64_t hash    = 0;
+        SString  key     = {};
+        uint32_t entry   = EMPTY_SLOT;
+        uint32_t padding = 0;
+    };
+
+    static_assert(std::is_trivially_copyable_v<SRecord> && std::is_trivially_copyable_v<SSlot>);
+}
+
+static const SHeader* header(const char* data) {
+    return reinterpret_cast<const SHeader*>(data);
+}
+
+static const SRecord* records(const char* data) {
+    return reinterpret_cast<const SRecord*>(data + sizeof(SHeader));
+}
+
+static const SSlot* slots(const char* data) {
+    return reinterpret_cast<const SSlot*>(data + sizeof(SHeader) + header(data)->entries * sizeof(SRecord));
+}
+
+static const char* blob(const char* data) {
+    return reinterpret_cast<const char*>(slots(data) + header(data)->slots);
+}
+
+static std::string_view view(const char* data, SString s) {
+    return {blob(data) + s.offset, s.length};
+}
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+static uint64_t fnv1a(const void* bytes, size_t length, uint64_t hash = 14695981039346656037ULL) {
+    const auto* P = static_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= P[i];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+static uint64_t fnv1a(std::string_view text, uint64_t hash = 14695981039346656037ULL) {
+    return fnv1a(text.data(), text.size(), hash);
+}
+
+static char lowerAscii(char c) {
+    return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+}
+
+static std::string lower(std::string_view text) {
+    std::string result(text);
+    std::ranges::transform(result, result.begin(), lowerAscii);
+    return result;
+}
+
+static std::string env(const char* name) {
+    const char* VALUE = std::getenv(name);
+    return VALUE ? VALUE : "";
+}
+
+// kde/org.kde.dolphin.desktop -> kde-org.kde.dolphin, as QuickShell names entries
+static std::string desktopId(const std::string& relative) {
+    std::string id = relative.substr(0, relative.size() - std::string_view(".desktop").size());
+    std::ranges::replace(id, '/', '-');
+    return id;
+}
+
+// Lowercased basename of the program Exec runs, past any env VAR=value prefix
+static std::string executable(std::string_view exec) {
+    size_t pos = 0;
+    while (pos < exec.size()) {
+        while (pos < exec.size() && exec[pos] == ' ')
+            ++pos;
+
+        std::string_view token;
+        if (pos < exec.size() && exec[pos] == '"') {
+            const size_t END = exec.find('"', pos + 1);
+            token            = exec.substr(pos + 1, END == std::string_view::npos ? std::string_view::npos : END - pos - 1);
+            pos              = END == std::string_view::npos ? exec.size() : END + 1;
+        } else {
+            const size_t END = exec.find(' ', pos);
+            token            = exec.substr(pos, END == std::string_view::npos ? std::string_view::npos : END - pos);
+            pos              = END == std::string_view::npos ? exec.size() : END;
+        }
+
+        if (token.empty() || token == "env" || token.find('=') != std::string_view::npos)
+            continue;
+
+        const size_t SLASH = token.rfind('/');
+        return lower(SLASH == std::string_view::npos ? token : token.substr(SLASH + 1));
+    }
+
+    return "";
+}
+
+// ============================================================================
+// SETUP
+// ============================================================================
+
+CDesktopIndex::CDesktopIndex() = default;
+
+CDesktopIndex::~CDesktopIndex() {
+    unmap();
+
+    if (m_inotify >= 0)
+        close(m_inotify);
+}
+
+void CDesktopIndex::findRoots() {
+    const std::string HOME     = env("HOME");
+    std::string       dataHome = env("XDG_DATA_HOME");
+    std::string       dataDirs = env("XDG_DATA_DIRS");
+    std::string       cacheDir = env("XDG_CACHE_HOME");
+
+    if (dataHome.empty())
+        dataHome = HOME + "/.local/share";
+    if (dataDirs.empty())
+        dataDirs = "/usr/local/share:/usr/share";
+    if (cacheDir.empty())
+        cacheDir = HOME + "/.cache";
+
+    m_roots = {dataHome + "/applications"};
+
+    size_t start = 0;
+    while (start <= dataDirs.size()) {
+        const size_t END  = std::min(dataDirs.find(':', start), dataDirs.size());
+        const auto   PATH = dataDirs.substr(start, END - start);
+        start             = END + 1;
+
+        if (PATH.empty())
+            continue;
+
+        std::string root = PATH + (PATH.back() == '/' ? "applications" : "/applications");
+        if (std::ranges::find(m_roots, root) == m_roots.end())
+            m_roots.emplace_back(std::move(root));
+    }
+
+    m_cachePath = cacheDir + "/molten/apps.idx";
+}
+
+void CDesktopIndex::findLocales() {
+    std::string locale = env("LC_ALL");
+    if (locale.empty())
+        locale = env("LC_MESSAGES");
+    if (locale.empty())
+        locale = env("LANG");
+
+    m_locales.clear();
+
+    // lang_COUNTRY.ENCODING@MODIFIER: the encoding never takes part in Name[...] keys
+    locale = locale.substr(0, locale.find_first_of(".@"));
+    if (locale.empty() || locale == "C" || locale == "POSIX")
+        return;
+
+    m_locales.push_back(locale);
+
+    const size_t UNDERSCORE = locale.find('_');
+    if (UNDERSCORE != std::string::npos)
+        m_locales.push_back(locale.substr(0, UNDERSCORE));
+}
+
+void CDesktopIndex::load() {
+    findRoots();
+    findLocales();
+
+    const uint64_t SIGNATURE = signature();
+    if (!mapCache(SIGNATURE)) {
+        parseAll();
+        rebuild(SIGNATURE);
+    }
+
+    if (m_inotify < 0)
+        m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+    if (m_inotify >= 0) {
+        for (size_t i = 0; i < m_roots.size(); ++i)
+            watch(i, "");
+    }
+}
+
+// ============================================================================
+// SCANNING
+// ============================================================================
+
+template <typename F>
+void CDesktopIndex::walk(uint16_t root, const std::string& relative, F&& onFile) const {
+    const std::string PATH = m_roots[root] + "/" + relative;
+
+    DIR* dir = opendir(PATH.c_str());
+    if (!dir)
+        return;
+
+    std::vector<std::string> names;
+    while (const dirent* entry = readdir(dir)) {
+        if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0)
+            names.emplace_back(entry->d_name);
+    }
+    closedir(dir);
+
+    // readdir order is whatever the filesystem likes; the signature needs a stable one
+    std::ranges::sort(names);
+
+    for (const auto& name : names) {
+        struct stat st;
+        if (stat((PATH + name).c_str(), &st) != 0)
+            continue;
+
+        if (S_ISDIR(st.st_mode))
+            walk(root, relative + name + "/", onFile);
+        else if (S_ISREG(st.st_mode) && name.ends_with(".desktop"))
+            onFile(relative + name, st);
+    }
+}
+
+uint64_t CDesktopIndex::signature() const {
+    uint64_t hash = fnv1a(&VERSION, sizeof(VERSION));
+
+    for (const auto& locale : m_locales)
+        hash = fnv1a(locale, hash);
+
+    for (size_t i = 0; i < m_roots.size(); ++i) {
+        hash = fnv1a(m_roots[i], hash);
+        walk(i, "", [&hash](const std::string& relative, const struct stat& st) {
+            const std::array<int64_t, 3> STAMP = {st.st_mtim.tv_sec, st.st_mtim.tv_nsec, st.st_size};
+            hash                               = fnv1a(relative, hash);
+            hash                               = fnv1a(STAMP.data(), sizeof(STAMP), hash);
+        });
+    }
+
+    return hash;
+}
+
+void CDesktopIndex::parseAll() {
+    m_entries.clear();
+
+    for (size_t i = 0; i < m_roots.size(); ++i) {
+        walk(i, "", [this, i](const std::string& relative, const struct stat&) {
+            const std::string ID = desktopId(relative);
+            if (m_entries.contains(ID))
+                return;
+
+            SEntry entry;
+            if (parseFile(m_roots[i] + "/" + relative, i, ID, entry))
+                m_entries.emplace(ID, std::move(entry));
+        });
+    }
+}
+
+bool CDesktopIndex::parseFile(const std::string& path, uint16_t root, const std::string& id, SEntry& out) const {
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    // Localised keys: lower rank wins, the plain key ranks after every locale
+    const size_t                UNLOCALISED = m_locales.size();
+    std::array<size_t, 4>       ranks;
+    std::array<std::string*, 4> localised = {&out.name, &out.genericName, &out.comment, &out.keywords};
+    constexpr std::array<std::string_view, 4> LOCALISED_KEYS = {"Name", "GenericName", "Comment", "Keywords"};
+    ranks.fill(SIZE_MAX);
+
+    bool        inGroup = false;
+    std::string type;
+    std::string line;
+
+    out       = SEntry{.root = root, .id = id};
+
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        if (line[0] == '[') {
+            if (inGroup)
+                break; // Only [Desktop Entry] matters, and it comes first
+            inGroup = line.starts_with("[Desktop Entry]");
+            continue;
+        }
+
+        if (!inGroup)
+            continue;
+
+        const size_t EQUALS = line.find('=');
+        if (EQUALS == std::string::npos)
+            continue;
+
+        std::string_view key   = std::string_view(line).substr(0, EQUALS);
+        std::string_view value = std::string_view(line).substr(EQUALS + 1);
+        while (!key.empty() && key.back() == ' ')
+            key.remove_suffix(1);
+        while (!value.empty() && value.front() == ' ')
+            value.remove_prefix(1);
+
+        std::string_view locale;
+        if (const size_t BRACKET = key.find('['); BRACKET != std::string_view::npos && key.back() == ']') {
+            locale = key.substr(BRACKET + 1, key.size() - BRACKET - 2);
+            key    = key.substr(0, BRACKET);
+        }
+
+        if (const auto IT = std::ranges::find(LOCALISED_KEYS, key); IT != LOCALISED_KEYS.end()) {
+            const size_t FIELD = IT - LOCALISED_KEYS.begin();
+            size_t       rank  = UNLOCALISED;
+            if (!locale.empty()) {
+                const auto LOCALE = std::ranges::find(m_locales, locale);
+                if (LOCALE == m_locales.end())
+                    continue;
+                rank = LOCALE - m_locales.begin();
+            }
+
+            if (rank < ranks[FIELD]) {
+                ranks[FIELD]      = rank;
+                *localised[FIELD] = value;
+            }
+            continue;
+        }
+
+        if (!locale.empty())
+            continue;
+
+        if (key == "Type")
+            type = value;
+        else if (key == "Icon")
+            out.icon = value;
+        else if (key == "Exec")
+            out.exec = value;
+        else if (key == "Categories")
+            out.categories = value;
+        else if (key == "StartupWMClass")
+            out.wmClass = value;
+        else if (key == "Terminal" && value == "true")
+            out.flags |= ENTRY_TERMINAL;
+        else if ((key == "NoDisplay" || key == "Hidden") && value == "true")
+            out.flags |= ENTRY_HIDDEN;
+    }
+
+    // Hidden=true files are often bare overrides without a Type
+    return type == "Application" || (out.flags & ENTRY_HIDDEN);
+}
+
+// ============================================================================
+// CACHE
+// ============================================================================
+
+bool CDesktopIndex::mapCache(uint64_t signature) {
+    const int FD = open(m_cachePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (FD < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(FD, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SHeader)) {
+        close(FD);
+        return false;
+    }
+
+    const size_t SIZE    = st.st_size;
+    void*        mapping = mmap(nullptr, SIZE, PROT_READ, MAP_PRIVATE, FD, 0);
+    close(FD);
+
+    if (mapping == MAP_FAILED)
+        return false;
+
+    const char* DATA  = static_cast<const char*>(mapping);
+    const auto* HDR   = header(DATA);
+    const bool  VALID = HDR->magic == MAGIC && HDR->version == VERSION && HDR->signature == signature && (HDR->slots & (HDR->slots - 1)) == 0 &&
+        sizeof(SHeader) + static_cast<size_t>(HDR->entries) * sizeof(SRecord) + static_cast<size_t>(HDR->slots) * sizeof(SSlot) + HDR->blobSize == SIZE;
+
+    if (!VALID) {
+        munmap(mapping, SIZE);
+        return false;
+    }
+
+    unmap();
+    m_mapping   = mapping;
+    m_data      = DATA;
+    m_size      = SIZE;
+    m_fromCache = true;
+    return true;
+}
+
+void CDesktopIndex::unmap() {
+    if (m_mapping)
+        munmap(m_mapping, m_size);
+
+    m_mapping = nullptr;
+    m_data    = nullptr;
+    m_size    = 0;
+    m_buffer  = {};
+}
+
+void CDesktopIndex::rebuild(uint64_t signature) {
+    std::vector<const SEntry*> order;
+    order.reserve(m_entries.size());
+    for (const auto& [id, entry] : m_entries)
+        order.push_back(&entry);
+
+    // Name order up front: equal scores then need no comparison beyond the entry index
+    std::vector<std::string> sortKeys;
+    sortKeys.reserve(order.size());
+    std::vector<uint32_t> byName(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        sortKeys.push_back(lower(order[i]->name));
+        byName[i] = i;
+    }
+    std::ranges::sort(byName, [&](uint32_t a, uint32_t b) { return std::tie(sortKeys[a], order[a]->id) < std::tie(sortKeys[b], order[b]->id); });
+
+    std::string blob;
+    auto        add = [&blob](std::string_view text) {
+        const SString STR = {static_cast<uint32_t>(blob.size()), static_cast<uint32_t>(text.size())};
+        blob.append(text);
+        blob.push_back('\0');
+        return STR;
+    };
+
+    std::vector<SRecord> recs(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        const SEntry& E   = *order[byName[i]];
+        SRecord&      rec = recs[i];
+
+        rec             = SRecord{};
+        rec.id          = add(E.id);
+        rec.name        = add(E.name);
+        rec.genericName = add(E.genericName);
+        rec.comment     = add(E.comment);
+        rec.icon        = add(E.icon);
+        rec.exec        = add(E.exec);
+        rec.keywords    = add(E.keywords);
+        rec.categories  = add(E.categories);
+        rec.wmClass     = add(E.wmClass);
+        rec.root        = E.root;
+        rec.flags       = E.flags;
+
+        const std::array<std::string, 5> KEYS = {sortKeys[byName[i]], executable(E.exec), lower(E.genericName), lower(E.comment), lower(E.keywords)};
+        rec.nameKey                           = add(KEYS[0]);
+        rec.execKey                           = add(KEYS[1]);
+        rec.genericKey                        = add(KEYS[2]);
+        rec.commentKey                        = add(KEYS[3]);
+        rec.keywordsKey                       = add(KEYS[4]);
+        rec.nameChars                         = NFuzzy::charMask(KEYS[0]);
+        for (const auto& key : KEYS) {
+            rec.chars |= NFuzzy::charMask(key);
+            rec.pairs |= NFuzzy::pairMask(key);
+        }
+    }
+
+    // Class keys, strongest first; the first entry to claim a key keeps it
+    std::vector<std::pair<std::string, uint32_t>> classKeys;
+    auto                                           claim = [&classKeys](std::string_view key, uint32_t entry) {
+        if (!key.empty())
+            classKeys.emplace_back(lower(key), entry);
+    };
+
+    for (uint32_t i = 0; i < recs.size(); ++i) {
+        const SEntry& E = *order[byName[i]];
+        if (E.flags & ENTRY_HIDDEN)
+            continue;
+        claim(E.wmClass, i);
+        claim(E.id, i);
+    }
+    for (uint32_t i = 0; i < recs.size(); ++i) {
+        if (!(order[byName[i]]->flags & ENTRY_HIDDEN))
+            claim(executable(order[byName[i]]->exec), i);
+    }
+    for (uint32_t i = 0; i < recs.size(); ++i) {
+        if (!(order[byName[i]]->flags & ENTRY_HIDDEN))
+            claim(order[byName[i]]->name, i);
+    }
+    for (uint32_t i = 0; i < recs.size(); ++i) {
+        const SEntry& E = *order[byName[i]];
+        if (E.flags & ENTRY_HIDDEN)
+            continue;
+        for (size_t start = 0; start < E.keywords.size();) {
+            const size_t END = std::min(E.keywords.find(';', start), E.keywords.size());
+            claim(std::string_view(E.keywords).substr(start, END - start), i);
+            start = END + 1;
+        }
+    }
+
+    uint32_t slotCount = 16;
+    while (slotCount < classKeys.size() * 2)
+        slotCount *= 2;
+
+    std::vector<SSlot> table(slotCount);
+    for (const auto& [key, entry] : classKeys) {
+        const uint64_t HASH = fnv1a(key);
+        uint32_t       at   = HASH & (slotCount - 1);
+        bool           seen = false;
+
+        while (table[at].entry != EMPTY_SLOT) {
+            if (table[at].hash == HASH && std::string_view(blob).substr(table[at].key.offset, table[at].key.length) == key) {
+                seen = true;
+                break;
+            }
+            at = (at + 1) & (slotCount - 1);
+        }
+
+        if (!seen)
+            table[at] = SSlot{.hash = HASH, .key = add(key), .entry = entry};
+    }
+
+    const SHeader HDR = {
+        .magic     = MAGIC,
+        .version   = VERSION,
+        .entries   = static_cast<uint32_t>(recs.size()),
+        .slots     = slotCount,
+        .blobSize  = static_cast<uint32_t>(blob.size()),
+        .signature = signature,
+    };
+
+    std::vector<char> buffer(sizeof(SHeader) + recs.size() * sizeof(SRecord) + table.size() * sizeof(SSlot) + blob.size());
+    char*             out = buffer.data();
+    std::memcpy(out, &HDR, sizeof(HDR));
+    out += sizeof(HDR);
+    std::memcpy(out, recs.data(), recs.size() * sizeof(SRecord));
+    out += recs.size() * sizeof(SRecord);
+    std::memcpy(out, table.data(), table.size() * sizeof(SSlot));
+    out += table.size() * sizeof(SSlot);
+    std::memcpy(out, blob.data(), blob.size());
+
+    // Best effort: without a writable cache the next start just parses again
+    const std::string CACHE_DIR = m_cachePath.substr(0, m_cachePath.rfind('/'));
+    const std::string TMP       = m_cachePath + ".tmp";
+    mkdir(CACHE_DIR.substr(0, CACHE_DIR.rfind('/')).c_str(), 0755);
+    mkdir(CACHE_DIR.c_str(), 0755);
+    if (std::ofstream file(TMP, std::ios::binary | std::ios::trunc); file.write(buffer.data(), buffer.size()) && file.flush())
+        rename(TMP.c_str(), m_cachePath.c_str());
+    else
+        unlink(TMP.c_str());
+
+    unmap();
+    m_buffer    = std::move(buffer);
+    m_data      = m_buffer.data();
+    m_size      = m_buffer.size();
+    m_fromCache = false;
+}
+
+// ============================================================================
+// WATCHING
+// ============================================================================
+
+void CDesktopIndex::watch(uint16_t root, const std::string& relative) {
+    const std::string PATH = m_roots[root] + "/" + relative;
+    const int         WD  = inotify_add_watch(m_inotify, PATH.c_str(), IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+    if (WD < 0)
+        return;
+
+    m_watches[WD] = {root, relative};
+
+    DIR* dir = opendir(PATH.c_str());
+    if (!dir)
+        return;
+
+    std::vector<std::string> subdirs;
+    while (const dirent* entry = readdir(dir)) {
+        if (entry->d_type == DT_DIR && std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0)
+            subdirs.emplace_back(entry->d_name);
+    }
+    closedir(dir);
+
+    for (const auto& name : subdirs)
+        watch(root, relative + name + "/");
+}
+
+int CDesktopIndex::watchFd() const {
+    return m_inotify;
+}
+
+bool CDesktopIndex::readEvents() {
+    alignas(inotify_event) char buffer[4096];
+    bool                        queued = false;
+
+    while (true) {
+        const ssize_t LENGTH = read(m_inotify, buffer, sizeof(buffer));
+        if (LENGTH <= 0)
+            break;
+
+        for (ssize_t at = 0; at < LENGTH;) {
+            const auto* EVENT = reinterpret_cast<const inotify_event*>(buffer + at);
+            at += sizeof(inotify_event) + EVENT->len;
+
+            const auto WATCH = m_watches.find(EVENT->wd);
+            if (WATCH == m_watches.end())
+                continue;
+
+            if (EVENT->mask & IN_IGNORED) {
+                m_watches.erase(WATCH);
+                continue;
+            }
+
+            if (!EVENT->len)
+                continue;
+
+            // Copies: watch() below may rehash m_watches
+            const uint16_t    ROOT     = WATCH->second.first;
+            const std::string RELATIVE = WATCH->second.second + EVENT->name;
+
+            if (EVENT->mask & IN_ISDIR) {
+                // A new subdirectory may arrive already populated (moved in, unpacked)
+                if (EVENT->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    watch(ROOT, RELATIVE + "/");
+                    walk(ROOT, RELATIVE + "/", [this, ROOT](const std::string& file, const struct stat&) { m_pending.push_back({ROOT, file}); });
+                    queued = true;
+                }
+                continue;
+            }
+
+            if (!RELATIVE.ends_with(".desktop"))
+                continue;
+
+            m_pending.push_back({ROOT, RELATIVE});
+            queued = true;
+        }
+    }
+
+    return queued;
+}
+
+void CDesktopIndex::hydrate() {
+    if (!m_entries.empty() || !m_data)
+        return;
+
+    const auto* HDR = header(m_data);
+    for (uint32_t i = 0; i < HDR->entries; ++i) {
+        const SRecord& R = records(m_data)[i];
+        SEntry         entry{
+                    .root        = R.root,
+                    .flags       = R.flags,
+                    .id          = std::string(view(m_data, R.id)),
+                    .name        = std::string(view(m_data, R.name)),
+                    .genericName = std::string(view(m_data, R.genericName)),
+                    .comment     = std::string(view(m_data, R.comment)),
+                    .icon        = std::string(view(m_data, R.icon)),
+                    .exec        = std::string(view(m_data, R.exec)),
+                    .keywords    = std::string(view(m_data, R.keywords)),
+                    .categories  = std::string(view(m_data, R.categories)),
+                    .wmClass     = std::string(view(m_data, R.wmClass)),
+        };
+        m_entries.emplace(entry.id, std::move(entry));
+    }
+}
+
+void CDesktopIndex::resolve(const SChange& change) {
+    const std::string ID       = desktopId(change.relative);
+    const auto        EXISTING = m_entries.find(ID);
+
+    // Shadowed by a file in a higher-priority dir
+    if (EXISTING != m_entries.end() && EXISTING->second.root < change.root)
+        return;
+
+    // The changed file, or whichever lower-priority one it was hiding
+    for (size_t root = change.root; root < m_roots.size(); ++root) {
+        SEntry entry;
+        if (parseFile(m_roots[root] + "/" + change.relative, root, ID, entry)) {
+            m_entries[ID] = std::move(entry);
+            return;
+        }
+    }
+
+    m_entries.erase(ID);
+}
+
+void CDesktopIndex::applyChanges() {
+    if (m_pending.empty())
+        return;
+
+    hydrate();
+
+    for (const auto& change : m_pending)
+        resolve(change);
+
+    m_pending.clear();
+    rebuild(signature());
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+size_t CDesktopIndex::size() const {
+    return m_data ? header(m_data)->entries : 0;
+}
+
+bool CDesktopIndex::isHidden(uint32_t entry) const {
+    return records(m_data)[entry].flags & ENTRY_HIDDEN;
+}
+
+CDesktopIndex::SApp CDesktopIndex::app(uint32_t entry) const {
+    const SRecord& R = records(m_data)[entry];
+    return SApp{
+        .id          = view(m_data, R.id),
+        .name        = view(m_data, R.name),
+        .genericName = view(m_data, R.genericName),
+        .comment     = view(m_data, R.comment),
+        .icon        = view(m_data, R.icon),
+        .exec        = view(m_data, R.exec),
+        .keywords    = view(m_data, R.keywords),
+        .categories  = view(m_data, R.categories),
+        .terminal    = (R.flags & ENTRY_TERMINAL) != 0,
+    };
+}
+
+bool CDesktopIndex::fromCache() const {
+    return m_fromCache;
+}
+
+void CDesktopIndex::search(std::string_view query, std::vector<SMatch>& out, size_t limit) const {
+    out.clear();
+    if (!m_data || query.empty())
+        return;
+
+    // Lowercase into a stack buffer: nothing here allocates once out has grown
+    std::array<char, QUERY_MAX> buffer;
+    const size_t                LENGTH = std::min(query.size(), buffer.size());
+    std::transform(query.begin(), query.begin() + LENGTH, buffer.begin(), lowerAscii);
+    const std::string_view Q = {buffer.data(), LENGTH};
+
+    const uint64_t         CHARS   = NFuzzy::charMask(Q);
+    const uint64_t         PAIRS   = NFuzzy::pairMask(Q);
+    const int              PERFECT = NFuzzy::MAX_PER_CHAR * static_cast<int>(Q.size());
+    const auto*            HDR     = header(m_data);
+    const SRecord*         RECS    = records(m_data);
+    const char*            BLOB    = blob(m_data);
+    const auto             key     = [BLOB](SString s) { return std::string_view{BLOB + s.offset, s.length}; };
+
+    for (uint32_t i = 0; i < HDR->entries; ++i) {
+        const SRecord& R = RECS[i];
+
+        // Most entries fail here: some query character appears in none of the keys
+        if ((R.flags & ENTRY_HIDDEN) || (CHARS & ~R.chars))
+            continue;
+
+        const std::string_view NAME  = key(R.nameKey);
+        int                    score = 0;
+
+        // No key has every pair of the query next to each other: only a fuzzy name match is left
+        if (PAIRS & ~R.pairs) {
+            if (CHARS & ~R.nameChars)
+                continue;
+
+            if (const int FUZZY = NFuzzy::subsequence(NAME, Q); FUZZY > 0)
+                out.push_back({i, 20 + 30 * FUZZY / PERFECT});
+            continue;
+        }
+
+        if (NAME == Q)
+            score += 100;
+        else if (NAME.starts_with(Q))
+            score += 80;
+        else if (NFuzzy::find(NAME, Q) != NFuzzy::NPOS)
+            score += 60;
+        else if (const int FUZZY = NFuzzy::subsequence(NAME, Q); FUZZY > 0)
+            score += 20 + 30 * FUZZY / PERFECT;
+
+        if (NFuzzy::find(key(R.execKey), Q) != NFuzzy::NPOS)
+            score += 40;
+        if (NFuzzy::find(key(R.genericKey), Q) != NFuzzy::NPOS)
+            score += 35;
+        if (NFuzzy::find(key(R.commentKey), Q) != NFuzzy::NPOS)
+            score += 30;
+        if (NFuzzy::find(key(R.keywordsKey), Q) != NFuzzy::NPOS)
+            score += 25;
+
+        if (score > 0)
+            out.push_back({i, score});
+    }
+
+    // Entries are stored in name order, so the index breaks ties alphabetically
+    const auto BETTER = [](const SMatch& a, const SMatch& b) { return a.score != b.score ? a.score > b.score : a.entry < b.entry; };
+    if (limit && out.size() > limit) {
+        std::partial_sort(out.begin(), out.begin() + limit, out.end(), BETTER);
+        out.resize(limit);
+    } else
+        std::ranges::sort(out, BETTER);
+}
+
+std::string_view CDesktopIndex::iconForClass(std::string_view windowClass) const {
+    if (!m_data || windowClass.empty() || windowClass.size() > QUERY_MAX)
+        return {};
+
+    std::array<char, QUERY_MAX> buffer;
+    std::ranges::transform(windowClass, buffer.begin(), lowerAscii);
+    const std::string_view KEY = {buffer.data(), windowClass.size()};
+
+    const auto*            HDR   = header(m_data);
+    const SSlot*           TABLE = slots(m_data);
+    const uint64_t         HASH  = fnv1a(KEY);
+
+    if (!HDR->slots)
+        return {};
+
+    for (uint32_t at = HASH & (HDR->slots - 1); TABLE[at].entry != EMPTY_SLOT; at = (at + 1) & (HDR->slots - 1)) {
+        if (TABLE[at].hash != HASH || view(m_data, TABLE[at].key) != KEY)
+            continue;
+
+        const std::string_view ICON = view(m_data, records(m_data)[TABLE[at].entry].icon);
+        return ICON.empty() ? "application-x-executable" : ICON;
+    }
+
+    return {};
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+/*
+ * Desktop Index
+ * Parses the .desktop files under every XDG applications dir into one flat,
+ * position-independent index (header, fixed-size entries, a class hash table
+ * and a string blob) cached at $XDG_CACHE_HOME/molten/apps.idx. A cache whose
+ * signature (paths, mtimes and sizes of every file) still matches is mmap'd
+ * as-is, so startup parses nothing. While running, inotify reports changed
+ * files; only those are re-parsed before the index is rebuilt from memory.
+ * Matching works on ASCII-lowercased copies of the searchable fields.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class CDesktopIndex {
+  public:
+    CDesktopIndex();
+    ~CDesktopIndex();
+
+    CDesktopIndex(const CDesktopIndex&)            = delete;
+    CDesktopIndex& operator=(const CDesktopIndex&) = delete;
+
+    enum eEntryFlags : uint16_t {
+        ENTRY_TERMINAL = 1 << 0,
+        ENTRY_HIDDEN   = 1 << 1, // NoDisplay/Hidden: kept so it still shadows lower-priority dirs
+    };
+
+    struct SMatch {
+        uint32_t entry = 0;
+        int      score = 0;
+    };
+
+    struct SApp {
+        std::string_view id, name, genericName, comment, icon, exec, keywords, categories;
+        bool             terminal = false;
+    };
+
+    // Maps the cache when it is current, otherwise parses everything and writes it
+    void        load();
+
+    // inotify descriptor for the host's event loop, -1 without inotify
+    int         watchFd() const;
+
+    // Drains the descriptor; true when changes are queued for applyChanges()
+    bool        readEvents();
+
+    // Re-parses the queued files and rebuilds the index
+    void        applyChanges();
+
+    // Entries in name order, hidden ones included
+    size_t      size() const;
+    bool        isHidden(uint32_t entry) const;
+    SApp        app(uint32_t entry) const;
+
+    // Visible entries matching query (any case), best first and then by name.
+    // Scores keep the launcher's scale: name exact 100 / prefix 80 / contains 60 /
+    // fuzzy 20-50, plus executable 40, generic name 35, comment 30, keywords 25.
+    void        search(std::string_view query, std::vector<SMatch>& out, size_t limit = 0) const;
+
+    // Icon of the app a window class belongs to (desktop id, StartupWMClass,
+    // executable, name or keyword, any case); empty if none
+    std::string_view iconForClass(std::string_view windowClass) const;
+
+    // How the current index was obtained, for diagnostics
+    bool        fromCache() const;
+
+  private:
+    struct SEntry {
+        uint16_t    root = 0; // Index into m_roots, lower wins
+        uint16_t    flags = 0;
+        std::string id, name, genericName, comment, icon, exec, keywords, categories, wmClass;
+    };
+
+    struct SChange {
+        uint16_t    root = 0;
+        std::string relative;
+    };
+
+    // XDG_DATA_HOME first, then XDG_DATA_DIRS, each with /applications
+    std::vector<std::string>      m_roots;
+    std::string                   m_cachePath;
+    std::vector<std::string>      m_locales; // Name[xx] suffixes in preference order
+
+    std::map<std::string, SEntry> m_entries; // By desktop id; empty until needed
+    std::vector<SChange>          m_pending;
+
+    int                           m_inotify = -1;
+    std::unordered_map<int, std::pair<uint16_t, std::string>> m_watches; // wd -> root, relative dir
+
+    // Current index: either the mapping or m_buffer
+    const char*                   m_data      = nullptr;
+    size_t                        m_size      = 0;
+    void*                         m_mapping   = nullptr;
+    std::vector<char>             m_buffer;
+    bool                          m_fromCache = false;
+
+    void                          findRoots();
+    void                          findLocales();
+    uint64_t                      signature() const;
+    bool                          mapCache(uint64_t signature);
+    void                          unmap();
+    void                          parseAll();
+    void                          hydrate();
+    bool                          parseFile(const std::string& path, uint16_t root, const std::string& id, SEntry& out) const;
+    void                          resolve(const SChange& change);
+    void                          rebuild(uint64_t signature);
+    void                          watch(uint16_t root, const std::string& relative);
+
+    // Calls onFile(relative path, stat) for every .desktop file below root/relative, in name order
+    template <typename F>
+    void                          walk(uint16_t root, const std::string& relative, F&& onFile) const;
+};
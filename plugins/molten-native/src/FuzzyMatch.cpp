@@ -0,0 +1,134 @@
+#include "FuzzyMatch.hpp"
+
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// ============================================================================
+// MASKS
+// ============================================================================
+
+uint64_t NFuzzy::charMask(std::string_view text) {
+    uint64_t mask = 0;
+
+    for (const unsigned char C : text) {
+        if (C >= 'a' && C <= 'z')
+            mask |= 1ULL << (C - 'a');
+        else if (C >= '0' && C <= '9')
+            mask |= 1ULL << (26 + C - '0');
+        else
+            mask |= 1ULL << (36 + C % 28);
+    }
+
+    return mask;
+}
+
+uint64_t NFuzzy::pairMask(std::string_view text) {
+    uint64_t mask = 0;
+
+    for (size_t i = 1; i < text.size(); ++i) {
+        const uint32_t PAIR = (static_cast<unsigned char>(text[i - 1]) << 8) | static_cast<unsigned char>(text[i]);
+        mask |= 1ULL << ((PAIR * 0x9E3779B1u) >> 26);
+    }
+
+    return mask;
+}
+
+// ============================================================================
+// SEARCH
+// ============================================================================
+
+size_t NFuzzy::find(std::string_view text, char c, size_t from) {
+    const char*  P = text.data();
+    const size_t N = text.size();
+    size_t       i = from;
+
+#ifdef __SSE2__
+    const __m128i NEEDLE = _mm_set1_epi8(c);
+    for (; i + 16 <= N; i += 16) {
+        const int MASK = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(P + i)), NEEDLE));
+        if (MASK)
+            return i + __builtin_ctz(MASK);
+    }
+#endif
+
+    for (; i < N; ++i) {
+        if (P[i] == c)
+            return i;
+    }
+
+    return NPOS;
+}
+
+size_t NFuzzy::find(std::string_view text, std::string_view needle) {
+    const size_t LEN = needle.size();
+    if (LEN == 0)
+        return 0;
+    if (LEN > text.size())
+        return NPOS;
+    if (LEN == 1)
+        return find(text, needle[0]);
+
+    const char*  P    = text.data();
+    const size_t LAST = text.size() - LEN; // Last possible start
+    size_t       i    = 0;
+
+#ifdef __SSE2__
+    // Candidates are starts where both the first and the last needle byte line
+    // up; only those reach memcmp
+    const __m128i FIRST = _mm_set1_epi8(needle.front());
+    const __m128i TAIL  = _mm_set1_epi8(needle.back());
+    for (; i + 16 <= LAST + 1; i += 16) {
+        const __m128i A    = _mm_cmpeq_epi8(FIRST, _mm_loadu_si128(reinterpret_cast<const __m128i*>(P + i)));
+        const __m128i B    = _mm_cmpeq_epi8(TAIL, _mm_loadu_si128(reinterpret_cast<const __m128i*>(P + i + LEN - 1)));
+        unsigned      mask = _mm_movemask_epi8(_mm_and_si128(A, B));
+
+        while (mask) {
+            const unsigned BIT = __builtin_ctz(mask);
+            if (std::memcmp(P + i + BIT + 1, needle.data() + 1, LEN - 2) == 0)
+                return i + BIT;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i <= LAST; ++i) {
+        if (P[i] == needle[0] && std::memcmp(P + i + 1, needle.data() + 1, LEN - 1) == 0)
+            return i;
+    }
+
+    return NPOS;
+}
+
+// ============================================================================
+// SCORING
+// ============================================================================
+
+static bool isWordBoundary(char c) {
+    return c == ' ' || c == '-' || c == '_' || c == '.' || c == '/';
+}
+
+int NFuzzy::subsequence(std::string_view text, std::string_view query) {
+    int    score = 0;
+    size_t from  = 0;
+    size_t prev  = NPOS;
+
+    for (const char C : query) {
+        const size_t AT = find(text, C, from);
+        if (AT == NPOS)
+            return 0;
+
+        score += 1;
+        if (AT == 0 || isWordBoundary(text[AT - 1]))
+            score += 3;
+        if (prev != NPOS && AT == prev + 1)
+            score += 2;
+
+        prev = AT;
+        from = AT + 1;
+    }
+
+    return score;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+/*
+ * Fuzzy Match
+ * Byte-level matching primitives for the app index. Text and queries are
+ * already ASCII-lowercased; SSE2 scans 16 bytes per step where available and
+ * falls back to scalar loops for the tail and other targets.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace NFuzzy {
+    inline constexpr size_t NPOS = std::string_view::npos;
+
+    // One bit per character class (a-z, 0-9, anything else folded into the
+    // remaining bits). A query can only match text whose mask covers its own.
+    uint64_t charMask(std::string_view text);
+
+    // Same idea for adjacent character pairs, hashed to 64 bits: text can only
+    // contain a query as a substring if its mask covers the query's
+    uint64_t pairMask(std::string_view text);
+
+    // First c in text at or after from
+    size_t   find(std::string_view text, char c, size_t from = 0);
+
+    // First occurrence of needle in text
+    size_t   find(std::string_view text, std::string_view needle);
+
+    // Query as an in-order subsequence of text, 0 if it isn't one. Each
+    // character scores 1, plus 3 at a word start and 2 when it follows the
+    // previous match; MAX_PER_CHAR * query.size() is a perfect score.
+    int      subsequence(std::string_view text, std::string_view query);
+
+    inline constexpr int MAX_PER_CHAR = 6;
+}
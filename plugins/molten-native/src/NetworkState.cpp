@@ -0,0 +1,306 @@
+#include "NetworkState.hpp"
+
+#include <QDBusArgument>
+#include <QDBusObjectPath>
+#include <QList>
+#include <algorithm>
+
+constexpr const char* NM_SERVICE         = "org.freedesktop.NetworkManager";
+constexpr const char* NM_PATH            = "/org/freedesktop/NetworkManager";
+constexpr const char* NM_INTERFACE       = "org.freedesktop.NetworkManager";
+constexpr const char* DEVICE_INTERFACE   = "org.freedesktop.NetworkManager.Device";
+constexpr const char* WIRELESS_INTERFACE = "org.freedesktop.NetworkManager.Device.Wireless";
+constexpr const char* AP_INTERFACE       = "org.freedesktop.NetworkManager.AccessPoint";
+constexpr const char* ACTIVE_INTERFACE   = "org.freedesktop.NetworkManager.Connection.Active";
+
+// NMDeviceType, NMDeviceState, NMConnectivityState
+constexpr uint DEVICE_ETHERNET      = 1;
+constexpr uint DEVICE_WIFI          = 2;
+constexpr uint STATE_UNAVAILABLE    = 20;
+constexpr uint STATE_PREPARE        = 40;
+constexpr uint STATE_ACTIVATED      = 100;
+constexpr uint CONNECTIVITY_LIMITED = 3;
+
+// NM80211ApFlags
+constexpr uint AP_FLAGS_PRIVACY = 0x1;
+
+// "o", with NetworkManager's "/" for none as empty
+static QString objectPath(const QVariant& value) {
+    const QString PATH = value.value<QDBusObjectPath>().path();
+    return PATH == "/" ? QString() : PATH;
+}
+
+// "ao"
+static QStringList objectPaths(const QVariant& value) {
+    QStringList result;
+    for (const auto& path : qdbus_cast<QList<QDBusObjectPath>>(value))
+        result << path.path();
+
+    return result;
+}
+
+// ============================================================================
+// ACCESS POINTS
+// ============================================================================
+
+CAccessPointModel::CAccessPointModel(CDBusObjects* objects, QObject* parent) : CDBusObjectModel(objects, AP_INTERFACE, parent) {
+    ;
+}
+
+QVariant CAccessPointModel::value(const QString& path, const QVariantMap& properties, int role) const {
+    switch (role) {
+        case ROLE_PATH: return path;
+        case ROLE_SSID: return QString::fromUtf8(properties.value("Ssid").toByteArray());
+        case ROLE_STRENGTH: return properties.value("Strength").toInt();
+        case ROLE_FREQUENCY: return properties.value("Frequency").toUInt();
+        case ROLE_SECURED:
+            return (properties.value("Flags").toUInt() & AP_FLAGS_PRIVACY) || properties.value("WpaFlags").toUInt() || properties.value("RsnFlags").toUInt();
+        case ROLE_ACTIVE: return m_active.contains(path);
+        default: return {};
+    }
+}
+
+QHash<int, QByteArray> CAccessPointModel::roleNames() const {
+    return {
+        {ROLE_PATH, "path"},
+        {ROLE_SSID, "ssid"},
+        {ROLE_STRENGTH, "strength"},
+        {ROLE_FREQUENCY, "frequency"},
+        {ROLE_SECURED, "secured"},
+        {ROLE_ACTIVE, "active"},
+    };
+}
+
+void CAccessPointModel::setActive(const QSet<QString>& active) {
+    if (active == m_active)
+        return;
+
+    const QSet<QString> FLIPPED = (active - m_active) + (m_active - active);
+    m_active                    = active;
+
+    for (const auto& path : FLIPPED)
+        refresh(path);
+}
+
+// ============================================================================
+// STATE
+// ============================================================================
+
+CNetworkState::CNetworkState(QObject* parent) : QObject(parent) {
+    m_objects      = new CDBusObjects(CDBusObjects::defaultBus(), NM_SERVICE, this);
+    m_accessPoints = new CAccessPointModel(m_objects, this);
+
+    m_objects->subscribe(NM_INTERFACE, "DeviceAdded");
+    m_objects->subscribe(NM_INTERFACE, "DeviceRemoved");
+    m_objects->subscribe(WIRELESS_INTERFACE, "AccessPointAdded");
+    m_objects->subscribe(WIRELESS_INTERFACE, "AccessPointRemoved");
+
+    connect(m_objects, &CDBusObjects::added, this, &CNetworkState::onAdded);
+    connect(m_objects, &CDBusObjects::changed, this, &CNetworkState::onChanged);
+    connect(m_objects, &CDBusObjects::removed, this, [this]() { update(); });
+    connect(m_objects, &CDBusObjects::signalled, this, &CNetworkState::onSignal);
+    connect(m_objects, &CDBusObjects::registeredChanged, this, [this]() {
+        emit availableChanged();
+        start();
+    });
+
+    start();
+}
+
+void CNetworkState::start() {
+    m_primary.clear();
+
+    // The rest follows from the manager's properties
+    if (m_objects->isRegistered())
+        m_objects->add(NM_PATH, NM_INTERFACE);
+
+    update();
+}
+
+QString CNetworkState::bus() const {
+    return m_objects->bus();
+}
+
+void CNetworkState::setBus(const QString& bus) {
+    if (bus == m_objects->bus())
+        return;
+
+    m_objects->setBus(bus);
+    emit busChanged();
+}
+
+bool CNetworkState::available() const {
+    return m_objects->isRegistered();
+}
+
+// ============================================================================
+// OBJECTS
+// ============================================================================
+
+void CNetworkState::onAdded(const QString& path, const QString& interface) {
+    if (interface == NM_INTERFACE) {
+        for (const auto& device : objectPaths(m_objects->value(path, NM_INTERFACE, "Devices")))
+            m_objects->add(device, DEVICE_INTERFACE);
+        followPrimary();
+    } else if (interface == DEVICE_INTERFACE) {
+        if (m_objects->value(path, DEVICE_INTERFACE, "DeviceType").toUInt() == DEVICE_WIFI)
+            m_objects->add(path, WIRELESS_INTERFACE);
+    } else if (interface == WIRELESS_INTERFACE) {
+        for (const auto& accessPoint : objectPaths(m_objects->value(path, WIRELESS_INTERFACE, "AccessPoints")))
+            m_objects->add(accessPoint, AP_INTERFACE);
+    }
+
+    update();
+}
+
+void CNetworkState::onChanged(const QString& path, const QString& interface, const QStringList& names) {
+    if (interface == NM_INTERFACE && names.contains("PrimaryConnection"))
+        followPrimary();
+
+    // An access point only changes the summary through its signal strength
+    if (interface == AP_INTERFACE && !names.contains("Strength"))
+        return;
+
+    update();
+}
+
+void CNetworkState::onSignal(const QString& path, const QString& interface, const QString& name, const QVariantList& arguments) {
+    if (arguments.isEmpty())
+        return;
+
+    const QString OBJECT = objectPath(arguments.first());
+    if (OBJECT.isEmpty())
+        return;
+
+    if (name == "DeviceAdded")
+        m_objects->add(OBJECT, DEVICE_INTERFACE);
+    else if (name == "DeviceRemoved")
+        dropDevice(OBJECT);
+    else if (name == "AccessPointAdded")
+        m_objects->add(OBJECT, AP_INTERFACE);
+    else if (name == "AccessPointRemoved")
+        m_objects->remove(OBJECT, AP_INTERFACE);
+}
+
+void CNetworkState::dropDevice(const QString& device) {
+    // Its access points go with it, whether or not each was announced as removed
+    for (const auto& accessPoint : objectPaths(m_objects->value(device, WIRELESS_INTERFACE, "AccessPoints")))
+        m_objects->remove(accessPoint);
+
+    m_objects->remove(device);
+}
+
+void CNetworkState::followPrimary() {
+    const QString PRIMARY = objectPath(m_objects->value(NM_PATH, NM_INTERFACE, "PrimaryConnection"));
+    if (PRIMARY == m_primary)
+        return;
+
+    if (!m_primary.isEmpty())
+        m_objects->remove(m_primary, ACTIVE_INTERFACE);
+
+    m_primary = PRIMARY;
+    if (!m_primary.isEmpty())
+        m_objects->add(m_primary, ACTIVE_INTERFACE);
+}
+
+// ============================================================================
+// SUMMARY
+// ============================================================================
+
+void CNetworkState::update() {
+    SState        state;
+    QSet<QString> active;
+
+    if (const auto* MANAGER = m_objects->properties(NM_PATH, NM_INTERFACE)) {
+        state.wifiEnabled = MANAGER->value("WirelessEnabled").toBool();
+
+        // The furthest along of the Wi-Fi devices stands for all of them
+        bool hasWifi   = false;
+        uint wifiState = 0;
+        for (const auto& device : m_objects->objects(DEVICE_INTERFACE)) {
+            const auto* DEVICE = m_objects->properties(device, DEVICE_INTERFACE);
+            const uint  TYPE   = DEVICE->value("DeviceType").toUInt();
+            const uint  STATE  = DEVICE->value("State").toUInt();
+
+            if (TYPE == DEVICE_ETHERNET && STATE == STATE_ACTIVATED)
+                state.ethernetConnected = true;
+
+            if (TYPE != DEVICE_WIFI)
+                continue;
+
+            hasWifi   = true;
+            wifiState = std::max(wifiState, STATE);
+
+            const QString ACCESSPOINT = objectPath(m_objects->value(device, WIRELESS_INTERFACE, "ActiveAccessPoint"));
+            if (ACCESSPOINT.isEmpty())
+                continue;
+
+            active << ACCESSPOINT;
+            if (STATE == STATE_ACTIVATED)
+                state.networkStrength = std::max(state.networkStrength, m_objects->value(ACCESSPOINT, AP_INTERFACE, "Strength").toInt());
+        }
+
+        if (!state.wifiEnabled || (hasWifi && wifiState <= STATE_UNAVAILABLE))
+            state.wifiStatus = "disabled";
+        else if (wifiState == STATE_ACTIVATED) {
+            state.wifiConnected = true;
+            state.wifiStatus    = MANAGER->value("Connectivity").toUInt() == CONNECTIVITY_LIMITED ? "limited" : "connected";
+        } else if (wifiState >= STATE_PREPARE)
+            state.wifiStatus = "connecting";
+        else
+            state.wifiStatus = "disconnected";
+
+        if (!m_primary.isEmpty())
+            state.networkName = m_objects->value(m_primary, ACTIVE_INTERFACE, "Id").toString();
+    }
+
+    m_accessPoints->setActive(active);
+
+    if (state == m_state)
+        return;
+
+    m_state = state;
+    emit stateChanged();
+}
+
+bool CNetworkState::wifiEnabled() const {
+    return m_state.wifiEnabled;
+}
+
+bool CNetworkState::wifiConnected() const {
+    return m_state.wifiConnected;
+}
+
+QString CNetworkState::wifiStatus() const {
+    return m_state.wifiStatus;
+}
+
+QString CNetworkState::networkName() const {
+    return m_state.networkName;
+}
+
+int CNetworkState::networkStrength() const {
+    return m_state.networkStrength;
+}
+
+bool CNetworkState::ethernetConnected() const {
+    return m_state.ethernetConnected;
+}
+
+QObject* CNetworkState::accessPoints() {
+    return m_accessPoints;
+}
+
+// ============================================================================
+// CONTROL
+// ============================================================================
+
+void CNetworkState::setWifiEnabled(bool enabled) {
+    // Same permission check (polkit) as nmcli radio wifi
+    m_objects->write(NM_PATH, NM_INTERFACE, "WirelessEnabled", enabled);
+}
+
+void CNetworkState::rescan() {
+    for (const auto& device : m_objects->objects(WIRELESS_INTERFACE))
+        m_objects->call(device, WIRELESS_INTERFACE, "RequestScan", {QVariant::fromValue(QVariantMap())});
+}
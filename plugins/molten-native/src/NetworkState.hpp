@@ -0,0 +1,121 @@
+#pragma once
+
+/*
+ * Network State QML Type
+ * Follows NetworkManager over D-Bus instead of running nmcli: the manager,
+ * its devices, the Wi-Fi devices' access points and the primary connection
+ * are read once and then kept current from PropertiesChanged, with devices
+ * and access points coming and going through DeviceAdded/DeviceRemoved and
+ * AccessPointAdded/AccessPointRemoved. The summary the status bar shows
+ * (radio, state, network name, signal) is derived again on each change;
+ * access points are a list model that changes a row at a time.
+ */
+
+#include "DBusObjects.hpp"
+
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+// Access points seen by every Wi-Fi device, in the order they were found
+class CAccessPointModel : public CDBusObjectModel {
+    Q_OBJECT
+
+  public:
+    enum eRoles {
+        ROLE_PATH = Qt::UserRole + 1,
+        ROLE_SSID,
+        ROLE_STRENGTH,  // 0-100
+        ROLE_FREQUENCY, // MHz
+        ROLE_SECURED,
+        ROLE_ACTIVE,    // The network a Wi-Fi device is connected through
+    };
+
+    CAccessPointModel(CDBusObjects* objects, QObject* parent = nullptr);
+
+    QHash<int, QByteArray> roleNames() const override;
+
+    // Access points devices are connected through; rows whose ROLE_ACTIVE flips are refreshed
+    void                   setActive(const QSet<QString>& active);
+
+  protected:
+    QVariant value(const QString& path, const QVariantMap& properties, int role) const override;
+
+  private:
+    QSet<QString> m_active;
+};
+
+// NetworkState { bus: "system" }
+class CNetworkState : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(QString bus READ bus WRITE setBus NOTIFY busChanged)
+    Q_PROPERTY(bool available READ available NOTIFY availableChanged)
+    Q_PROPERTY(bool wifiEnabled READ wifiEnabled NOTIFY stateChanged)
+    Q_PROPERTY(bool wifiConnected READ wifiConnected NOTIFY stateChanged)
+    Q_PROPERTY(QString wifiStatus READ wifiStatus NOTIFY stateChanged)
+    Q_PROPERTY(QString networkName READ networkName NOTIFY stateChanged)
+    Q_PROPERTY(int networkStrength READ networkStrength NOTIFY stateChanged)
+    Q_PROPERTY(bool ethernetConnected READ ethernetConnected NOTIFY stateChanged)
+    Q_PROPERTY(QObject* accessPoints READ accessPoints CONSTANT)
+
+  public:
+    explicit CNetworkState(QObject* parent = nullptr);
+
+    // "system", or "session" for a mock NetworkManager (MOLTEN_DBUS_BUS sets the default)
+    QString          bus() const;
+    void             setBus(const QString& bus);
+
+    // NetworkManager is running
+    bool             available() const;
+
+    bool             wifiEnabled() const;
+    bool             wifiConnected() const;
+
+    // "connected", "limited", "connecting", "disconnected" or "disabled", as Network.qml reported
+    QString          wifiStatus() const;
+
+    // Primary connection's name
+    QString          networkName() const;
+
+    // Active access point's signal, 0-100
+    int              networkStrength() const;
+
+    bool             ethernetConnected() const;
+
+    QObject*         accessPoints();
+
+    Q_INVOKABLE void setWifiEnabled(bool enabled);
+
+    // Ask every Wi-Fi device for a scan; new access points arrive on their own
+    Q_INVOKABLE void rescan();
+
+  signals:
+    void busChanged();
+    void availableChanged();
+    void stateChanged();
+
+  private:
+    struct SState {
+        bool    wifiEnabled       = false;
+        bool    wifiConnected     = false;
+        QString wifiStatus        = "disabled";
+        QString networkName;
+        int     networkStrength   = 0;
+        bool    ethernetConnected = false;
+
+        bool    operator==(const SState&) const = default;
+    };
+
+    CDBusObjects*      m_objects;
+    CAccessPointModel* m_accessPoints;
+    SState             m_state;
+    QString            m_primary; // Active connection mirrored for networkName
+
+    void               start();
+    void               onAdded(const QString& path, const QString& interface);
+    void               onChanged(const QString& path, const QString& interface, const QStringList& names);
+    void               onSignal(const QString& path, const QString& interface, const QString& name, const QVariantList& arguments);
+    void               dropDevice(const QString& device);
+    void               followPrimary();
+    void               update();
+};
@@ -0,0 +1,351 @@
+#include "NotificationHistory.hpp"
+
+#include <QDir>
+#include <QSet>
+#include <QVariantList>
+#include <algorithm>
+#include <array>
+
+static QString qstr(std::string_view text) {
+    return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+static std::string_view view(const QByteArray& bytes) {
+    return {bytes.constData(), static_cast<size_t>(bytes.size())};
+}
+
+static QString xdgDir(const char* variable, const char* fallback) {
+    const QString VALUE = qEnvironmentVariable(variable);
+    return VALUE.isEmpty() ? QDir::homePath() + fallback : VALUE;
+}
+
+// ============================================================================
+// SERVICE
+// ============================================================================
+
+CNotificationStore* CNotificationStore::instance() {
+    static auto* store = new CNotificationStore();
+    return store;
+}
+
+CNotificationStore::CNotificationStore() {
+    const QString STATE_DIR = xdgDir("XDG_STATE_HOME", "/.local/state") + "/molten";
+    QDir().mkpath(STATE_DIR);
+
+    m_journal.open((STATE_DIR + "/notifications.journal").toStdString());
+    m_sessionStart = m_journal.nextId();
+
+    m_images = new CNotificationImages(xdgDir("XDG_CACHE_HOME", "/.cache") + "/molten/notification-images", this);
+    connect(m_images, &CNotificationImages::cached, this, &CNotificationStore::onImageCached);
+    connect(m_images, &CNotificationImages::failed, this, [this](const QString& url) { m_waiting.remove(url); });
+
+    // open() compacted if it was worth it; either way the live set is final now
+    collectImages();
+}
+
+const CNotificationJournal& CNotificationStore::journal() const {
+    return m_journal;
+}
+
+uint32_t CNotificationStore::sessionStart() const {
+    return m_sessionStart;
+}
+
+void CNotificationStore::add(const QVariantMap& notification) {
+    using J = CNotificationJournal;
+
+    const uint32_t ID = notification.value("id").toUInt();
+
+    // UTF-8 copies the journal record is encoded from
+    std::array<QByteArray, J::FIELD_COUNT> fields;
+    fields[J::FIELD_APP_NAME] = notification.value("appName").toString().toUtf8();
+    fields[J::FIELD_APP_ICON] = notification.value("appIcon").toString().toUtf8();
+    fields[J::FIELD_SUMMARY]  = notification.value("summary").toString().toUtf8();
+    fields[J::FIELD_BODY]     = notification.value("body").toString().toUtf8();
+    fields[J::FIELD_IMAGE]    = notification.value("image").toString().toUtf8();
+
+    std::vector<QByteArray> actionText;
+    for (const auto& action : notification.value("actions").toList()) {
+        const QVariantMap MAP = action.toMap();
+        actionText.push_back(MAP.value("identifier").toString().toUtf8());
+        actionText.push_back(MAP.value("text").toString().toUtf8());
+    }
+
+    J::SNotification record;
+    record.id      = ID;
+    record.urgency = notification.value("urgency").toUInt();
+    record.time    = static_cast<uint64_t>(notification.value("time").toDouble());
+    for (size_t f = 0; f < J::FIELD_COUNT; ++f)
+        record.fields[f] = view(fields[f]);
+    for (size_t i = 0; i + 1 < actionText.size(); i += 2)
+        record.actions.emplace_back(view(actionText[i]), view(actionText[i + 1]));
+
+    if (const size_t OLD = m_journal.find(ID); OLD != J::NPOS)
+        removeIndex(OLD);
+
+    const size_t INDEX = m_journal.append(record);
+    if (INDEX == J::NPOS)
+        return;
+
+    emit appended(INDEX);
+
+    for (const auto FIELD : {J::FIELD_APP_ICON, J::FIELD_IMAGE}) {
+        const QString URL = QString::fromUtf8(fields[FIELD]);
+        if (!CNotificationImages::isRemote(URL))
+            continue;
+
+        m_waiting.insert(URL, ID);
+        m_images->fetch(URL);
+    }
+
+    trim(INDEX);
+    maybeCompact();
+}
+
+void CNotificationStore::remove(uint32_t id) {
+    if (const size_t INDEX = m_journal.find(id); INDEX != CNotificationJournal::NPOS) {
+        removeIndex(INDEX);
+        maybeCompact();
+    }
+}
+
+void CNotificationStore::clear() {
+    m_journal.clear();
+    m_oldest = 0;
+    collectImages();
+    emit reset();
+}
+
+void CNotificationStore::removeIndex(size_t index) {
+    if (!m_journal.entries()[index].alive)
+        return;
+
+    m_journal.remove(index);
+    emit removed(index);
+}
+
+void CNotificationStore::trim(size_t index) {
+    const auto& ENTRIES = m_journal.entries();
+
+    // Newest MAX_PER_GROUP of the new entry's app and summary survive
+    const uint64_t GROUP = ENTRIES[index].group;
+    size_t         seen  = 0;
+    for (size_t i = index + 1; i-- > m_oldest;) {
+        if (ENTRIES[i].alive && ENTRIES[i].group == GROUP && ++seen > MAX_PER_GROUP)
+            removeIndex(i);
+    }
+
+    while (m_journal.liveCount() > MAX_ENTRIES) {
+        while (!ENTRIES[m_oldest].alive)
+            ++m_oldest;
+        removeIndex(m_oldest);
+    }
+}
+
+void CNotificationStore::maybeCompact() {
+    if (!m_journal.needsCompaction())
+        return;
+
+    m_journal.compact();
+    m_oldest = 0;
+    collectImages();
+    emit reset();
+}
+
+void CNotificationStore::collectImages() const {
+    QSet<QString> referenced;
+
+    const auto&   ENTRIES = m_journal.entries();
+    for (size_t i = 0; i < ENTRIES.size(); ++i) {
+        if (!ENTRIES[i].alive)
+            continue;
+
+        for (const auto FIELD : {CNotificationJournal::FIELD_APP_ICON, CNotificationJournal::FIELD_IMAGE}) {
+            const QString URL = qstr(m_journal.field(i, FIELD));
+            if (m_images->owns(URL))
+                referenced.insert(URL);
+        }
+    }
+
+    m_images->collect(referenced);
+}
+
+void CNotificationStore::onImageCached(const QString& url, const QString& file) {
+    for (const uint32_t ID : m_waiting.values(url)) {
+        const size_t INDEX = m_journal.find(ID);
+        if (INDEX == CNotificationJournal::NPOS)
+            continue;
+
+        auto replaced = [&](CNotificationJournal::eField field) {
+            const QString CURRENT = qstr(m_journal.field(INDEX, field));
+            return (CURRENT == url ? file : CURRENT).toUtf8();
+        };
+
+        const QByteArray APP_ICON = replaced(CNotificationJournal::FIELD_APP_ICON);
+        const QByteArray IMAGE    = replaced(CNotificationJournal::FIELD_IMAGE);
+        if (m_journal.setImages(INDEX, view(APP_ICON), view(IMAGE)))
+            emit changed(INDEX);
+    }
+
+    m_waiting.remove(url);
+}
+
+// ============================================================================
+// MODEL
+// ============================================================================
+
+CNotificationHistory::CNotificationHistory(QObject* parent) : QAbstractListModel(parent) {
+    auto* store = CNotificationStore::instance();
+
+    connect(store, &CNotificationStore::appended, this, &CNotificationHistory::onAppended);
+    connect(store, &CNotificationStore::removed, this, &CNotificationHistory::onRemoved);
+    connect(store, &CNotificationStore::changed, this, &CNotificationHistory::onChanged);
+    connect(store, &CNotificationStore::reset, this, &CNotificationHistory::reload);
+    reload();
+}
+
+int CNotificationHistory::count() const {
+    return static_cast<int>(m_rows.size());
+}
+
+int CNotificationHistory::nextId() const {
+    return static_cast<int>(CNotificationStore::instance()->sessionStart());
+}
+
+int CNotificationHistory::rowOf(size_t index) const {
+    // Recent entries, the usual targets, sit at the back
+    const auto IT = std::find(m_rows.rbegin(), m_rows.rend(), index);
+    return IT == m_rows.rend() ? -1 : static_cast<int>(IT - m_rows.rbegin());
+}
+
+void CNotificationHistory::reload() {
+    const auto& ENTRIES  = CNotificationStore::instance()->journal().entries();
+    const int   PREVIOUS = count();
+
+    beginResetModel();
+
+    m_rows.clear();
+    for (size_t i = 0; i < ENTRIES.size(); ++i) {
+        if (ENTRIES[i].alive)
+            m_rows.push_back(i);
+    }
+
+    // Keep what the view had scrolled through
+    m_loaded = std::min(std::max(m_loaded, PAGE_SIZE), count());
+
+    endResetModel();
+
+    if (count() != PREVIOUS)
+        emit countChanged();
+}
+
+void CNotificationHistory::onAppended(size_t index) {
+    beginInsertRows({}, 0, 0);
+    m_rows.push_back(index);
+    ++m_loaded;
+    endInsertRows();
+    emit countChanged();
+}
+
+void CNotificationHistory::onRemoved(size_t index) {
+    const int ROW = rowOf(index);
+    if (ROW < 0)
+        return;
+
+    // Past the loaded page: no row to remove, only the count changes
+    if (ROW >= m_loaded)
+        m_rows.erase(m_rows.end() - 1 - ROW);
+    else {
+        beginRemoveRows({}, ROW, ROW);
+        m_rows.erase(m_rows.end() - 1 - ROW);
+        --m_loaded;
+        endRemoveRows();
+    }
+
+    emit countChanged();
+}
+
+void CNotificationHistory::onChanged(size_t index) {
+    if (const int ROW = rowOf(index); ROW >= 0 && ROW < m_loaded)
+        emit dataChanged(this->index(ROW), this->index(ROW), {ROLE_APP_ICON, ROLE_IMAGE});
+}
+
+int CNotificationHistory::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : m_loaded;
+}
+
+bool CNotificationHistory::canFetchMore(const QModelIndex& parent) const {
+    return !parent.isValid() && m_loaded < count();
+}
+
+void CNotificationHistory::fetchMore(const QModelIndex& parent) {
+    if (!canFetchMore(parent))
+        return;
+
+    const int MORE = std::min(PAGE_SIZE, count() - m_loaded);
+    beginInsertRows({}, m_loaded, m_loaded + MORE - 1);
+    m_loaded += MORE;
+    endInsertRows();
+}
+
+void CNotificationHistory::loadMore() {
+    fetchMore({});
+}
+
+QVariant CNotificationHistory::data(const QModelIndex& index, int role) const {
+    using J = CNotificationJournal;
+
+    if (!index.isValid() || index.row() >= m_loaded)
+        return {};
+
+    const auto*  store   = CNotificationStore::instance();
+    const auto&  JOURNAL = store->journal();
+    const size_t ENTRY   = m_rows[m_rows.size() - 1 - index.row()];
+    const auto&  INFO    = JOURNAL.entries()[ENTRY];
+
+    switch (role) {
+        case ROLE_ID: return INFO.id;
+        case ROLE_APP_NAME: return qstr(JOURNAL.field(ENTRY, J::FIELD_APP_NAME));
+        case ROLE_APP_ICON: return qstr(JOURNAL.field(ENTRY, J::FIELD_APP_ICON));
+        case ROLE_SUMMARY: return qstr(JOURNAL.field(ENTRY, J::FIELD_SUMMARY));
+        case ROLE_BODY: return qstr(JOURNAL.field(ENTRY, J::FIELD_BODY));
+        case ROLE_IMAGE: return qstr(JOURNAL.field(ENTRY, J::FIELD_IMAGE));
+        case ROLE_TIME: return static_cast<double>(INFO.time);
+        case ROLE_URGENCY: return INFO.urgency;
+        case ROLE_ACTIONS: {
+            QVariantList actions;
+            for (const auto& [identifier, text] : JOURNAL.actions(ENTRY))
+                actions.append(QVariantMap{{"identifier", qstr(identifier)}, {"text", qstr(text)}});
+            return actions;
+        }
+        case ROLE_IS_CACHED: return INFO.id < store->sessionStart();
+        default: return {};
+    }
+}
+
+QHash<int, QByteArray> CNotificationHistory::roleNames() const {
+    return {
+        {ROLE_ID, "id"},
+        {ROLE_APP_NAME, "appName"},
+        {ROLE_APP_ICON, "appIcon"},
+        {ROLE_SUMMARY, "summary"},
+        {ROLE_BODY, "body"},
+        {ROLE_IMAGE, "image"},
+        {ROLE_TIME, "time"},
+        {ROLE_URGENCY, "urgency"},
+        {ROLE_ACTIONS, "actions"},
+        {ROLE_IS_CACHED, "isCached"},
+    };
+}
+
+void CNotificationHistory::add(const QVariantMap& notification) {
+    CNotificationStore::instance()->add(notification);
+}
+
+void CNotificationHistory::remove(int id) {
+    CNotificationStore::instance()->remove(static_cast<uint32_t>(id));
+}
+
+void CNotificationHistory::clear() {
+    CNotificationStore::instance()->clear();
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+/*
+ * Notification History QML Types
+ * NotificationHistory is a list model, newest first, over one process-wide
+ * CNotificationJournal. Rows are exposed a page at a time as a view scrolls,
+ * and each row's text is read from the mapped journal only when asked for, so
+ * neither startup nor memory grows with the history. History is capped in
+ * total and per app and summary, as the JSON file was; dismissals are
+ * tombstones, and the journal is compacted once most of it is dead. Remote
+ * images are swapped for cached thumbnail files as CNotificationImages
+ * delivers them.
+ */
+
+#include "NotificationImages.hpp"
+#include "NotificationJournal.hpp"
+
+#include <QAbstractListModel>
+#include <QMultiHash>
+#include <QObject>
+#include <QVariantMap>
+#include <vector>
+
+// Owner of the shared journal, created on first use and kept for the process lifetime
+class CNotificationStore : public QObject {
+    Q_OBJECT
+
+  public:
+    static CNotificationStore*  instance();
+
+    const CNotificationJournal& journal() const;
+
+    // Ids below this were journaled by an earlier session
+    uint32_t                    sessionStart() const;
+
+    void                        add(const QVariantMap& notification);
+    void                        remove(uint32_t id);
+    void                        clear();
+
+  signals:
+    // Indices into journal().entries()
+    void appended(size_t index);
+    void removed(size_t index);
+    void changed(size_t index);
+
+    // Indices were renumbered by a compaction
+    void reset();
+
+  private:
+    CNotificationStore();
+
+    // Oldest entries are removed past these, matching the old JSON store's limits
+    static constexpr size_t MAX_ENTRIES   = 500;
+    static constexpr size_t MAX_PER_GROUP = 5;
+
+    CNotificationJournal          m_journal;
+    CNotificationImages*          m_images       = nullptr;
+    uint32_t                      m_sessionStart = 0;
+    size_t                        m_oldest       = 0; // No live entry before this index
+    QMultiHash<QString, uint32_t> m_waiting;          // Image URL -> ids showing it
+
+    void                          removeIndex(size_t index);
+    void                          trim(size_t index);
+    void                          maybeCompact();
+    void                          collectImages() const;
+    void                          onImageCached(const QString& url, const QString& file);
+};
+
+// NotificationHistory {}
+class CNotificationHistory : public QAbstractListModel {
+    Q_OBJECT
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int nextId READ nextId CONSTANT)
+
+  public:
+    enum eRoles {
+        ROLE_ID = Qt::UserRole + 1,
+        ROLE_APP_NAME,
+        ROLE_APP_ICON,
+        ROLE_SUMMARY,
+        ROLE_BODY,
+        ROLE_IMAGE,
+        ROLE_TIME,
+        ROLE_URGENCY,
+        ROLE_ACTIONS, // [{ identifier, text }]
+        ROLE_IS_CACHED, // From an earlier session: its actions can no longer be invoked
+    };
+
+    explicit CNotificationHistory(QObject* parent = nullptr);
+
+    // Every stored notification, loaded into rows or not
+    int                      count() const;
+
+    // First id free for this session's notifications
+    int                      nextId() const;
+
+    int                      rowCount(const QModelIndex& parent = {}) const override;
+    QVariant                 data(const QModelIndex& index, int role) const override;
+    QHash<int, QByteArray>   roleNames() const override;
+    bool                     canFetchMore(const QModelIndex& parent) const override;
+    void                     fetchMore(const QModelIndex& parent) override;
+
+    // fetchMore() for views that do not page on their own (Repeater)
+    Q_INVOKABLE void         loadMore();
+
+    // { id, appName, appIcon, summary, body, image, time, urgency, actions }
+    Q_INVOKABLE void         add(const QVariantMap& notification);
+    Q_INVOKABLE void         remove(int id);
+    Q_INVOKABLE void         clear();
+
+  signals:
+    void countChanged();
+
+  private:
+    static constexpr int PAGE_SIZE = 30;
+
+    // Journal indices of every live entry, oldest first: row r is
+    // m_rows[size - 1 - r]. Only the newest m_loaded are rows.
+    std::vector<size_t>  m_rows;
+    int                  m_loaded = 0;
+
+    int                  rowOf(size_t index) const;
+    void                 reload();
+    void                 onAppended(size_t index);
+    void                 onRemoved(size_t index);
+    void                 onChanged(size_t index);
+};
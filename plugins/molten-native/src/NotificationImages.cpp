@@ -0,0 +1,105 @@
+#include "NotificationImages.hpp"
+#include "ContentHash.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QNetworkReply>
+#include <QThreadPool>
+#include <QUrl>
+
+CNotificationImages::CNotificationImages(const QString& directory, QObject* parent) : QObject(parent), m_directory(directory) {
+    QDir().mkpath(m_directory);
+}
+
+bool CNotificationImages::isRemote(const QString& url) {
+    return url.startsWith("http://") || url.startsWith("https://");
+}
+
+bool CNotificationImages::owns(const QString& url) const {
+    return url.startsWith(QUrl::fromLocalFile(m_directory + "/").toString());
+}
+
+void CNotificationImages::fetch(const QString& url) {
+    if (m_pending.contains(url))
+        return;
+
+    m_pending.insert(url);
+    m_queue.enqueue(url);
+    startNext();
+}
+
+void CNotificationImages::startNext() {
+    // Queued rather than dropped: a burst of chat messages still gets its avatars
+    while (m_active < MAX_CONCURRENT && !m_queue.isEmpty()) {
+        const QString   URL = m_queue.dequeue();
+
+        QNetworkRequest request{QUrl(URL)};
+        request.setTransferTimeout(TIMEOUT_MS);
+
+        auto* reply = m_network.get(request);
+        ++m_active;
+
+        connect(reply, &QNetworkReply::downloadProgress, reply, [reply](qint64 received, qint64) {
+            if (received > MAX_BYTES)
+                reply->abort();
+        });
+
+        connect(reply, &QNetworkReply::finished, this, [this, reply, URL]() {
+            reply->deleteLater();
+            --m_active;
+
+            if (reply->error() == QNetworkReply::NoError)
+                store(URL, reply->readAll());
+            else
+                finish(URL, {});
+
+            startNext();
+        });
+    }
+}
+
+void CNotificationImages::store(const QString& url, const QByteArray& bytes) {
+    const QString DIRECTORY = m_directory;
+
+    QThreadPool::globalInstance()->start([this, url, bytes, DIRECTORY]() {
+        const uint64_t HASH = NHash::bytes({bytes.constData(), static_cast<size_t>(bytes.size())});
+        const QString  PATH = QString("%1/%2.png").arg(DIRECTORY).arg(HASH, 16, 16, QChar('0'));
+
+        QString        file;
+        if (QFile::exists(PATH))
+            file = PATH;
+        else if (QImage image = QImage::fromData(bytes); !image.isNull()) {
+            if (image.width() > MAX_EDGE || image.height() > MAX_EDGE)
+                image = image.scaled(MAX_EDGE, MAX_EDGE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+            // Written aside and renamed, so a reader never sees half a file
+            const QString TMP = PATH + ".tmp";
+            if (image.save(TMP, "PNG") && QFile::rename(TMP, PATH))
+                file = PATH;
+            else
+                QFile::remove(TMP);
+        }
+
+        const QString URL = file.isEmpty() ? QString() : QUrl::fromLocalFile(file).toString();
+        QMetaObject::invokeMethod(this, [this, url, URL]() { finish(url, URL); }, Qt::QueuedConnection);
+    });
+}
+
+void CNotificationImages::finish(const QString& url, const QString& file) {
+    m_pending.remove(url);
+
+    if (file.isEmpty())
+        emit failed(url);
+    else
+        emit cached(url, file);
+}
+
+void CNotificationImages::collect(const QSet<QString>& referenced) const {
+    const QDir FOLDER(m_directory);
+
+    for (const auto& name : FOLDER.entryList({"*.png"}, QDir::Files)) {
+        if (!referenced.contains(QUrl::fromLocalFile(FOLDER.filePath(name)).toString()))
+            QFile::remove(FOLDER.filePath(name));
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+/*
+ * Notification Images
+ * Remote notification images (chat avatars, album art) downloaded once and
+ * kept as thumbnail files named by a hash of the downloaded bytes, so the
+ * same avatar sent a hundred times is one file and the journal stores a short
+ * file:// URL instead of inline image data. Decoding, scaling and writing run
+ * on the global thread pool; downloads are capped in count, size and time.
+ */
+
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QObject>
+#include <QQueue>
+#include <QSet>
+#include <QString>
+
+class CNotificationImages : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit CNotificationImages(const QString& directory, QObject* parent = nullptr);
+
+    // Only http(s) URLs are fetched; anything else is already local or inline
+    static bool isRemote(const QString& url);
+
+    // Queues a download; cached() or failed() follows exactly once per URL
+    void        fetch(const QString& url);
+
+    // file:// URL if it points at a thumbnail in this cache
+    bool        owns(const QString& url) const;
+
+    // Deletes thumbnails no longer referenced by any of the given URLs
+    void        collect(const QSet<QString>& referenced) const;
+
+  signals:
+    void cached(const QString& url, const QString& file);
+    void failed(const QString& url);
+
+  private:
+    static constexpr int MAX_CONCURRENT = 3;
+    static constexpr int TIMEOUT_MS     = 5000;
+    static constexpr int MAX_BYTES      = 4 << 20;
+    static constexpr int MAX_EDGE       = 256; // Thumbnails are scaled down to fit this
+
+    QString               m_directory;
+    QNetworkAccessManager m_network;
+    QQueue<QString>       m_queue;
+    QSet<QString>         m_pending; // Queued or in flight
+    int                   m_active = 0;
+
+    void                  startNext();
+    void                  store(const QString& url, const QByteArray& bytes);
+    void                  finish(const QString& url, const QString& file);
+};
@@ -0,0 +1,341 @@
+#include "NotificationJournal.hpp"
+#include "ContentHash.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+// RECORD FORMAT
+// ============================================================================
+
+namespace {
+    constexpr uint32_t MAGIC          = 0x4E43544D; // "MTCN"
+    constexpr uint32_t RECORD_ARRIVAL = 1;
+    constexpr uint32_t RECORD_IMAGES  = 2;
+    constexpr uint32_t RECORD_REMOVE  = 3;
+
+    // Mapping headroom: appends within it reach the map without a remap
+    constexpr size_t   MAP_STEP = 1 << 20;
+
+    // Too few records to be worth a rewrite, however many are dead
+    constexpr size_t   MIN_COMPACT_RECORDS = 256;
+
+    // Followed by fieldCount fields, each a uint32_t length and its bytes,
+    // padded to 8 bytes. Arrivals carry FIELD_COUNT fields then action
+    // identifier/text pairs; image records carry the app icon and image.
+    struct SRecordHeader {
+        uint32_t magic;
+        uint32_t type;
+        uint32_t id;
+        uint32_t urgency;
+        uint64_t time;
+        uint32_t payloadLength;
+        uint32_t fieldCount;
+    };
+}
+
+static std::string encode(uint32_t type, uint32_t id, uint32_t urgency, uint64_t time, const std::vector<std::string_view>& fields) {
+    size_t payload = 0;
+    for (const auto& field : fields)
+        payload += sizeof(uint32_t) + field.size();
+
+    const SRecordHeader HEADER = {MAGIC, type, id, urgency, time, static_cast<uint32_t>(payload), static_cast<uint32_t>(fields.size())};
+
+    std::string         record;
+    record.reserve((sizeof(HEADER) + payload + 7) & ~size_t{7});
+    record.append(reinterpret_cast<const char*>(&HEADER), sizeof(HEADER));
+    for (const auto& field : fields) {
+        const uint32_t LENGTH = field.size();
+        record.append(reinterpret_cast<const char*>(&LENGTH), sizeof(LENGTH));
+        record.append(field);
+    }
+    record.resize((record.size() + 7) & ~size_t{7}, '\0');
+    return record;
+}
+
+static std::vector<std::string_view> arrivalFields(const CNotificationJournal::SNotification& notification) {
+    std::vector<std::string_view> fields(notification.fields.begin(), notification.fields.end());
+    for (const auto& [identifier, text] : notification.actions) {
+        fields.push_back(identifier);
+        fields.push_back(text);
+    }
+    return fields;
+}
+
+// ============================================================================
+// FILE
+// ============================================================================
+
+CNotificationJournal::~CNotificationJournal() {
+    close();
+}
+
+void CNotificationJournal::close() {
+    if (m_map)
+        munmap(m_map, m_capacity);
+    if (m_fd >= 0)
+        ::close(m_fd);
+
+    m_map      = nullptr;
+    m_capacity = 0;
+    m_size     = 0;
+    m_fd       = -1;
+}
+
+bool CNotificationJournal::map(size_t needed) {
+    if (m_map && needed <= m_capacity)
+        return true;
+
+    // Mapping past the end of the file is fine as long as nothing reads there
+    const size_t CAPACITY = (needed / MAP_STEP + 1) * MAP_STEP;
+    void*        mapping  = m_map ? mremap(m_map, m_capacity, CAPACITY, MREMAP_MAYMOVE) : mmap(nullptr, CAPACITY, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (mapping == MAP_FAILED)
+        return false;
+
+    m_map      = static_cast<char*>(mapping);
+    m_capacity = CAPACITY;
+    return true;
+}
+
+bool CNotificationJournal::open(const std::string& path) {
+    close();
+
+    m_path = path;
+    m_fd   = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (m_fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(m_fd, &st) != 0 || !map(st.st_size)) {
+        close();
+        return false;
+    }
+
+    m_size = st.st_size;
+    if (!replay())
+        return false;
+
+    return !needsCompaction() || compact();
+}
+
+bool CNotificationJournal::replay() {
+    m_entries.clear();
+    m_live.clear();
+    m_records = 0;
+
+    size_t at = 0;
+    while (at + sizeof(SRecordHeader) <= m_size) {
+        SRecordHeader header;
+        std::memcpy(&header, m_map + at, sizeof(header));
+
+        const size_t SIZE = (sizeof(SRecordHeader) + size_t{header.payloadLength} + 7) & ~size_t{7};
+        if (header.magic != MAGIC || at + SIZE > m_size)
+            break;
+
+        // Field lengths must stay inside the payload, so later reads need no checks
+        size_t cursor = at + sizeof(SRecordHeader);
+        size_t end    = cursor + header.payloadLength;
+        bool   valid  = true;
+        for (uint32_t i = 0; i < header.fieldCount && valid; ++i) {
+            uint32_t length = 0;
+            valid           = cursor + sizeof(length) <= end;
+            if (valid) {
+                std::memcpy(&length, m_map + cursor, sizeof(length));
+                cursor += sizeof(length) + length;
+                valid = cursor <= end;
+            }
+        }
+
+        const size_t OLD = find(header.id);
+        if (!valid)
+            break;
+        else if (header.type == RECORD_ARRIVAL && header.fieldCount >= FIELD_COUNT) {
+            if (OLD != NPOS)
+                m_entries[OLD].alive = false;
+
+            m_live[header.id] = m_entries.size();
+            m_entries.push_back({header.id, header.urgency, header.time, at, NO_IMAGES, 0, true});
+            m_entries.back().group = group(field(m_entries.size() - 1, FIELD_APP_NAME), field(m_entries.size() - 1, FIELD_SUMMARY));
+            m_nextId               = std::max(m_nextId, header.id + 1);
+        } else if (header.type == RECORD_IMAGES && header.fieldCount == 2) {
+            if (OLD != NPOS)
+                m_entries[OLD].images = at;
+        } else if (header.type == RECORD_REMOVE) {
+            if (OLD != NPOS) {
+                m_entries[OLD].alive = false;
+                m_live.erase(header.id);
+            }
+        } else
+            break;
+
+        ++m_records;
+        at += SIZE;
+    }
+
+    // A write torn by a crash: drop it so appends continue from a record boundary
+    if (at != m_size) {
+        if (ftruncate(m_fd, at) != 0)
+            return false;
+        m_size = at;
+    }
+
+    return true;
+}
+
+bool CNotificationJournal::needsCompaction() const {
+    return m_records >= MIN_COMPACT_RECORDS && m_live.size() * 2 <= m_records;
+}
+
+bool CNotificationJournal::compact() {
+    // Live entries are re-encoded with their image overrides folded in: one record each
+    std::string out;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        const auto& ENTRY = m_entries[i];
+        if (!ENTRY.alive)
+            continue;
+
+        SNotification notification = {ENTRY.id, ENTRY.urgency, ENTRY.time, {}, actions(i)};
+        for (uint8_t f = 0; f < FIELD_COUNT; ++f)
+            notification.fields[f] = field(i, static_cast<eField>(f));
+
+        out += encode(RECORD_ARRIVAL, ENTRY.id, ENTRY.urgency, ENTRY.time, arrivalFields(notification));
+    }
+
+    const std::string TMP = m_path + ".tmp";
+    const int         FD  = ::open(TMP.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (FD < 0)
+        return false;
+
+    const bool WRITTEN = ::write(FD, out.data(), out.size()) == static_cast<ssize_t>(out.size());
+    ::close(FD);
+
+    if (!WRITTEN || rename(TMP.c_str(), m_path.c_str()) != 0) {
+        unlink(TMP.c_str());
+        return false;
+    }
+
+    // The rewrite holds no dead records, so this cannot recurse
+    return open(m_path);
+}
+
+bool CNotificationJournal::write(const std::string& record) {
+    if (m_fd < 0)
+        return false;
+
+    if (pwrite(m_fd, record.data(), record.size(), m_size) != static_cast<ssize_t>(record.size())) {
+        // Leave no partial record behind; replay() would drop it anyway
+        [[maybe_unused]] const int TRUNCATED = ftruncate(m_fd, m_size);
+        return false;
+    }
+
+    m_size += record.size();
+    ++m_records;
+    return map(m_size);
+}
+
+// ============================================================================
+// ENTRIES
+// ============================================================================
+
+const std::vector<CNotificationJournal::SEntry>& CNotificationJournal::entries() const {
+    return m_entries;
+}
+
+size_t CNotificationJournal::liveCount() const {
+    return m_live.size();
+}
+
+size_t CNotificationJournal::find(uint32_t id) const {
+    const auto IT = m_live.find(id);
+    return IT == m_live.end() ? NPOS : IT->second;
+}
+
+uint32_t CNotificationJournal::nextId() const {
+    return m_nextId;
+}
+
+size_t CNotificationJournal::append(const SNotification& notification) {
+    const size_t OFFSET = m_size;
+    if (!write(encode(RECORD_ARRIVAL, notification.id, notification.urgency, notification.time, arrivalFields(notification))))
+        return NPOS;
+
+    if (const size_t OLD = find(notification.id); OLD != NPOS)
+        m_entries[OLD].alive = false;
+
+    m_live[notification.id] = m_entries.size();
+    m_entries.push_back({notification.id, notification.urgency, notification.time, OFFSET, NO_IMAGES,
+                         group(notification.fields[FIELD_APP_NAME], notification.fields[FIELD_SUMMARY]), true});
+    m_nextId = std::max(m_nextId, notification.id + 1);
+    return m_entries.size() - 1;
+}
+
+bool CNotificationJournal::setImages(size_t index, std::string_view appIcon, std::string_view image) {
+    auto&        entry  = m_entries[index];
+    const size_t OFFSET = m_size;
+    if (!entry.alive || !write(encode(RECORD_IMAGES, entry.id, 0, 0, {appIcon, image})))
+        return false;
+
+    entry.images = OFFSET;
+    return true;
+}
+
+void CNotificationJournal::remove(size_t index) {
+    auto& entry = m_entries[index];
+    if (!entry.alive || !write(encode(RECORD_REMOVE, entry.id, 0, 0, {})))
+        return;
+
+    entry.alive = false;
+    m_live.erase(entry.id);
+}
+
+void CNotificationJournal::clear() {
+    if (m_fd >= 0 && ftruncate(m_fd, 0) == 0)
+        m_size = 0;
+
+    m_entries.clear();
+    m_live.clear();
+    m_records = 0;
+}
+
+std::string_view CNotificationJournal::recordField(uint64_t offset, size_t n) const {
+    size_t at = offset + sizeof(SRecordHeader);
+    for (size_t i = 0;; ++i) {
+        uint32_t length = 0;
+        std::memcpy(&length, m_map + at, sizeof(length));
+        at += sizeof(length);
+
+        if (i == n)
+            return {m_map + at, length};
+        at += length;
+    }
+}
+
+std::string_view CNotificationJournal::field(size_t index, eField field) const {
+    const auto& ENTRY = m_entries[index];
+
+    if (ENTRY.images != NO_IMAGES && field == FIELD_APP_ICON)
+        return recordField(ENTRY.images, 0);
+    if (ENTRY.images != NO_IMAGES && field == FIELD_IMAGE)
+        return recordField(ENTRY.images, 1);
+
+    return recordField(ENTRY.offset, field);
+}
+
+std::vector<CNotificationJournal::SAction> CNotificationJournal::actions(size_t index) const {
+    SRecordHeader header;
+    std::memcpy(&header, m_map + m_entries[index].offset, sizeof(header));
+
+    std::vector<SAction> result;
+    for (uint32_t f = FIELD_COUNT; f + 1 < header.fieldCount; f += 2)
+        result.emplace_back(recordField(m_entries[index].offset, f), recordField(m_entries[index].offset, f + 1));
+    return result;
+}
+
+uint64_t CNotificationJournal::group(std::string_view appName, std::string_view summary) {
+    return NHash::bytes(summary, NHash::bytes(appName));
+}
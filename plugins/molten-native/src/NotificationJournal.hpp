@@ -0,0 +1,112 @@
+#pragma once
+
+/*
+ * Notification Journal
+ * Append-only notification history: an arrival appends one record with its
+ * text fields and actions, a dismissal appends a tombstone, and a cached image
+ * appends a small record that overrides the entry's image URLs. Nothing is
+ * rewritten per change. The file is mmap'd with room to grow and entries are
+ * read in place, so memory holds one fixed-size SEntry per live notification
+ * and replay only walks record headers.
+ *
+ * compact() rewrites the live entries into a fresh file; it renumbers entry
+ * indices. Single-threaded.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class CNotificationJournal {
+  public:
+    CNotificationJournal() = default;
+    ~CNotificationJournal();
+
+    CNotificationJournal(const CNotificationJournal&)            = delete;
+    CNotificationJournal& operator=(const CNotificationJournal&) = delete;
+
+    enum eField : uint8_t {
+        FIELD_APP_NAME = 0,
+        FIELD_APP_ICON,
+        FIELD_SUMMARY,
+        FIELD_BODY,
+        FIELD_IMAGE,
+        FIELD_COUNT,
+    };
+
+    using SAction = std::pair<std::string_view, std::string_view>; // identifier, text
+
+    struct SNotification {
+        uint32_t                                    id      = 0;
+        uint32_t                                    urgency = 0;
+        uint64_t                                    time    = 0; // ms since the epoch
+        std::array<std::string_view, FIELD_COUNT>   fields;
+        std::vector<SAction>                        actions;
+    };
+
+    struct SEntry {
+        uint32_t id      = 0;
+        uint32_t urgency = 0;
+        uint64_t time    = 0;
+        uint64_t offset  = 0;        // Arrival record
+        uint64_t images  = NO_IMAGES; // Latest image record, if any
+        uint64_t group   = 0;        // Hash of app name and summary
+        bool     alive   = true;
+    };
+
+    static constexpr size_t   NPOS      = SIZE_MAX;
+    static constexpr uint64_t NO_IMAGES = UINT64_MAX;
+
+    // Opens (creating if needed, mode 0600), replays and compacts the journal
+    bool                       open(const std::string& path);
+
+    // Journal order, oldest first; dead entries stay until the next compact()
+    const std::vector<SEntry>& entries() const;
+    size_t                     liveCount() const;
+    size_t                     find(uint32_t id) const;
+
+    // One past the highest id ever journaled
+    uint32_t                   nextId() const;
+
+    // Index of the new entry; an entry with the same id is replaced
+    size_t                     append(const SNotification& notification);
+
+    // Replaces a live entry's app icon and image URLs
+    bool                       setImages(size_t index, std::string_view appIcon, std::string_view image);
+
+    // Tombstones a live entry
+    void                       remove(size_t index);
+    void                       clear();
+
+    // Worth calling compact(): most records are dead
+    bool                       needsCompaction() const;
+    bool                       compact();
+
+    // In-place views: an append may remap
+    std::string_view           field(size_t index, eField field) const;
+    std::vector<SAction>       actions(size_t index) const;
+
+    static uint64_t            group(std::string_view appName, std::string_view summary);
+
+  private:
+    int                                  m_fd       = -1;
+    std::string                          m_path;
+    char*                                m_map      = nullptr;
+    size_t                               m_capacity = 0; // Mapped bytes, past the end of the file
+    size_t                               m_size     = 0; // File size
+    size_t                               m_records  = 0; // In the file, dead or alive
+    uint32_t                             m_nextId   = 0;
+    std::vector<SEntry>                  m_entries;
+    std::unordered_map<uint32_t, size_t> m_live; // id -> index
+
+    bool                                 map(size_t needed);
+    void                                 close();
+    bool                                 replay();
+    bool                                 write(const std::string& record);
+    std::string_view                     recordField(uint64_t offset, size_t n) const;
+};
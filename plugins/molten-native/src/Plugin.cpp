@@ -0,0 +1,36 @@
+#include "AppIndex.hpp"
+#include "BacklightControl.hpp"
+#include "BluetoothState.hpp"
+#include "ClipboardHistory.hpp"
+#include "NetworkState.hpp"
+#include "NotificationHistory.hpp"
+#include "WallpaperCache.hpp"
+
+#include <QQmlEngine>
+#include <QQmlExtensionPlugin>
+
+// import Molten.Native
+class CMoltenNativePlugin : public QQmlExtensionPlugin {
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID QQmlExtensionInterface_iid)
+
+  public:
+    void registerTypes(const char* uri) override {
+        qmlRegisterType<CAppIndex>(uri, 1, 0, "AppIndex");
+        qmlRegisterType<CAppSearchModel>(uri, 1, 0, "AppSearchModel");
+        qmlRegisterType<CClipboardHistory>(uri, 1, 0, "ClipboardHistory");
+        qmlRegisterType<CNotificationHistory>(uri, 1, 0, "NotificationHistory");
+        qmlRegisterType<CBacklightControl>(uri, 1, 0, "Backlight");
+        qmlRegisterType<CWallpaperCacheControl>(uri, 1, 0, "WallpaperCache");
+        qmlRegisterType<CNetworkState>(uri, 1, 0, "NetworkState");
+        qmlRegisterType<CBluetoothState>(uri, 1, 0, "BluetoothState");
+    }
+
+    void initializeEngine(QQmlEngine* engine, const char* uri) override {
+        Q_UNUSED(uri);
+        engine->addImageProvider("molten-clipboard", new CClipboardImageProvider());
+        engine->addImageProvider("molten-wallpaper", new CWallpaperImageProvider());
+    }
+};
+
+#include "Plugin.moc"
@@ -0,0 +1,328 @@
+#include "WallpaperCache.hpp"
+#include "ContentHash.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QImageReader>
+#include <QThreadPool>
+#include <QUrl>
+#include <QtGlobal>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// On-disk entry: this header, then height rows of stride bytes
+struct SWallpaperHeader {
+    char     magic[8];
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    uint32_t format;
+    uint8_t  reserved[40];
+};
+static_assert(sizeof(SWallpaperHeader) == 64);
+
+static constexpr char MAGIC[8] = {'M', 'O', 'L', 'T', 'W', 'P', 'R', '1'};
+
+struct SMapping {
+    void*  address;
+    size_t length;
+};
+
+static QString xdgDir(const char* variable, const char* fallback) {
+    const QString VALUE = qEnvironmentVariable(variable);
+    return VALUE.isEmpty() ? QDir::homePath() + fallback : VALUE;
+}
+
+// ============================================================================
+// CACHE
+// ============================================================================
+
+CWallpaperCache* CWallpaperCache::instance() {
+    static auto* cache = new CWallpaperCache();
+    return cache;
+}
+
+CWallpaperCache::CWallpaperCache() {
+    m_directory = xdgDir("XDG_CACHE_HOME", "/.cache") + "/molten/wallpapers";
+    QDir().mkpath(m_directory);
+}
+
+QString CWallpaperCache::entry(const QString& source, const QSize& size) const {
+    const QByteArray PATH = QFile::encodeName(source);
+
+    struct stat      info;
+    if (stat(PATH.constData(), &info) != 0 || !S_ISREG(info.st_mode))
+        return {};
+
+    const uint64_t KEYS[] = {static_cast<uint64_t>(info.st_ino), static_cast<uint64_t>(info.st_size), static_cast<uint64_t>(info.st_mtim.tv_sec),
+                             static_cast<uint64_t>(info.st_mtim.tv_nsec), static_cast<uint64_t>(size.width()), static_cast<uint64_t>(size.height())};
+    const uint64_t SEED   = NHash::bytes({reinterpret_cast<const char*>(KEYS), sizeof(KEYS)});
+    const uint64_t HASH   = NHash::bytes({PATH.constData(), static_cast<size_t>(PATH.size())}, SEED);
+
+    return QString("%1/%2").arg(m_directory).arg(HASH, 16, 16, QChar('0'));
+}
+
+QString CWallpaperCache::file(const QString& entry, eVariant variant) {
+    return entry + (variant == VARIANT_BLURRED ? "-blurred.raw" : "-sharp.raw");
+}
+
+QImage CWallpaperCache::image(const QString& source, const QSize& size, eVariant variant) {
+    if (size.isEmpty())
+        return {};
+
+    const QString ENTRY = entry(source, size);
+    if (ENTRY.isEmpty())
+        return {};
+
+    const QString FILE = file(ENTRY, variant);
+    if (QImage mapped = map(FILE); !mapped.isNull())
+        return mapped;
+
+    {
+        std::lock_guard lock(m_buildMutex);
+
+        // Another request may have built it while this one waited
+        if (QImage mapped = map(FILE); !mapped.isNull())
+            return mapped;
+
+        if (!build(source, size, ENTRY))
+            return {};
+    }
+
+    evict();
+    return map(FILE);
+}
+
+// ============================================================================
+// FILES
+// ============================================================================
+
+QImage CWallpaperCache::map(const QString& file) const {
+    const QByteArray PATH = QFile::encodeName(file);
+    const int        FD   = ::open(PATH.constData(), O_RDONLY | O_CLOEXEC);
+    if (FD < 0)
+        return {};
+
+    struct stat info;
+    void*       address = MAP_FAILED;
+    if (fstat(FD, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(SWallpaperHeader)))
+        address = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, FD, 0);
+    ::close(FD);
+
+    if (address == MAP_FAILED)
+        return {};
+
+    const size_t LENGTH = info.st_size;
+    const auto*  HEADER = static_cast<const SWallpaperHeader*>(address);
+    const bool   VALID  = std::memcmp(HEADER->magic, MAGIC, sizeof(MAGIC)) == 0 && HEADER->format == QImage::Format_RGB32 && HEADER->width > 0 && HEADER->height > 0 &&
+        HEADER->stride >= HEADER->width * 4 && sizeof(SWallpaperHeader) + static_cast<size_t>(HEADER->stride) * HEADER->height <= LENGTH;
+
+    if (!VALID) {
+        munmap(address, LENGTH);
+        return {};
+    }
+
+    // Marks the entry as used for eviction
+    utimensat(AT_FDCWD, PATH.constData(), nullptr, 0);
+
+    // Read-only pixels straight from the page cache; unmapped with the last copy of the image
+    const auto* PIXELS = static_cast<const uchar*>(address) + sizeof(SWallpaperHeader);
+    return QImage(
+        PIXELS, HEADER->width, HEADER->height, HEADER->stride, QImage::Format_RGB32,
+        [](void* data) {
+            const auto* MAPPING = static_cast<SMapping*>(data);
+            munmap(MAPPING->address, MAPPING->length);
+            delete MAPPING;
+        },
+        new SMapping{address, LENGTH});
+}
+
+bool CWallpaperCache::store(const QImage& image, const QString& file) const {
+    SWallpaperHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.width  = image.width();
+    header.height = image.height();
+    header.stride = image.bytesPerLine();
+    header.format = QImage::Format_RGB32;
+
+    // Written aside and renamed, so a reader never maps half a file
+    const QString TMP = file + ".tmp";
+    QFile         out(TMP);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    bool ok = out.write(reinterpret_cast<const char*>(&header), sizeof(header)) == sizeof(header);
+    ok      = ok && out.write(reinterpret_cast<const char*>(image.constBits()), image.sizeInBytes()) == image.sizeInBytes();
+    out.close();
+
+    if (ok && ::rename(QFile::encodeName(TMP).constData(), QFile::encodeName(file).constData()) == 0)
+        return true;
+
+    QFile::remove(TMP);
+    return false;
+}
+
+void CWallpaperCache::evict() const {
+    const QDir FOLDER(m_directory);
+    qint64     total = 0;
+
+    // Newest first: everything past the budget is the least recently used
+    for (const auto& info : FOLDER.entryInfoList({"*.raw"}, QDir::Files, QDir::Time)) {
+        total += info.size();
+        if (total > MAX_BYTES)
+            QFile::remove(info.filePath());
+    }
+}
+
+// ============================================================================
+// BUILDING
+// ============================================================================
+
+bool CWallpaperCache::build(const QString& source, const QSize& size, const QString& entry) const {
+    const QImage SHARP = decode(source, size);
+    if (SHARP.isNull()) {
+        qWarning("WallpaperCache: cannot decode %s", qPrintable(source));
+        return false;
+    }
+
+    if (!store(SHARP, file(entry, VARIANT_SHARP)))
+        return false;
+
+    // Blurred at a quarter size: the blur removes the detail that would have been lost anyway
+    QImage blurred = SHARP.scaled((size / BLUR_DIVISOR).expandedTo({1, 1}), Qt::IgnoreAspectRatio, Qt::SmoothTransformation).convertToFormat(QImage::Format_RGB32);
+    blur(blurred, BLUR_RADIUS);
+
+    return store(blurred, file(entry, VARIANT_BLURRED));
+}
+
+QImage CWallpaperCache::decode(const QString& source, const QSize& size) {
+    QImageReader reader(source);
+    reader.setAutoTransform(true);
+
+    // The clip and scale apply before EXIF rotation, so rotated images take the slow path
+    const QSize FULL = reader.size();
+    if (FULL.isValid() && reader.transformation() == QImageIOHandler::TransformationNone) {
+        // The centered region PreserveAspectCrop would show, decoded straight to the output size
+        const QSize CROP = size.scaled(FULL, Qt::KeepAspectRatio);
+        reader.setClipRect({QPoint((FULL.width() - CROP.width()) / 2, (FULL.height() - CROP.height()) / 2), CROP});
+        reader.setScaledSize(size);
+    }
+
+    const QImage IMAGE = reader.read();
+    if (IMAGE.isNull())
+        return {};
+
+    return cover(IMAGE, size).convertToFormat(QImage::Format_RGB32);
+}
+
+QImage CWallpaperCache::cover(const QImage& image, const QSize& size) {
+    if (image.size() == size)
+        return image;
+
+    const QImage SCALED = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+    return SCALED.copy((SCALED.width() - size.width()) / 2, (SCALED.height() - size.height()) / 2, size.width(), size.height());
+}
+
+// One box pass over count pixels step apart, edges clamped
+static void boxPass(uint32_t* pixels, int count, int step, int radius, std::vector<uint32_t>& line) {
+    line.resize(count);
+    for (int i = 0; i < count; ++i)
+        line[i] = pixels[static_cast<size_t>(i) * step];
+
+    const int WINDOW = radius * 2 + 1;
+    const auto AT    = [&](int i) { return line[std::clamp(i, 0, count - 1)]; };
+
+    int        red = 0, green = 0, blue = 0;
+    for (int i = -radius; i <= radius; ++i) {
+        red += (AT(i) >> 16) & 0xff;
+        green += (AT(i) >> 8) & 0xff;
+        blue += AT(i) & 0xff;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        pixels[static_cast<size_t>(i) * step] = 0xff000000u | (red / WINDOW) << 16 | (green / WINDOW) << 8 | (blue / WINDOW);
+
+        const uint32_t OUT = AT(i - radius), IN = AT(i + radius + 1);
+        red += static_cast<int>((IN >> 16) & 0xff) - static_cast<int>((OUT >> 16) & 0xff);
+        green += static_cast<int>((IN >> 8) & 0xff) - static_cast<int>((OUT >> 8) & 0xff);
+        blue += static_cast<int>(IN & 0xff) - static_cast<int>(OUT & 0xff);
+    }
+}
+
+void CWallpaperCache::blur(QImage& image, int radius) {
+    // Three box passes each way come within a few percent of a gaussian
+    auto*                 pixels = reinterpret_cast<uint32_t*>(image.bits());
+    const int             STEP   = image.bytesPerLine() / 4;
+    std::vector<uint32_t> line;
+
+    for (int pass = 0; pass < 3; ++pass) {
+        for (int y = 0; y < image.height(); ++y)
+            boxPass(pixels + static_cast<size_t>(y) * STEP, image.width(), 1, radius, line);
+        for (int x = 0; x < image.width(); ++x)
+            boxPass(pixels + x, image.height(), STEP, radius, line);
+    }
+}
+
+// ============================================================================
+// QML
+// ============================================================================
+
+CWallpaperImageProvider::CWallpaperImageProvider() : QQuickImageProvider(QQuickImageProvider::Image, QQmlImageProviderBase::ForceAsynchronousImageLoading) {
+    ;
+}
+
+QImage CWallpaperImageProvider::requestImage(const QString& id, QSize* size, const QSize& requestedSize) {
+    Q_UNUSED(requestedSize);
+
+    // <sharp|blurred>/<width>x<height>/<percent-encoded path>
+    const int VARIANT_END = id.indexOf('/');
+    const int SIZE_END    = id.indexOf('/', VARIANT_END + 1);
+    if (VARIANT_END < 0 || SIZE_END < 0)
+        return {};
+
+    const QString     VARIANT    = id.left(VARIANT_END);
+    const QStringList DIMENSIONS = id.mid(VARIANT_END + 1, SIZE_END - VARIANT_END - 1).split('x');
+    const QString     PATH       = QUrl::fromPercentEncoding(id.mid(SIZE_END + 1).toUtf8());
+    if (DIMENSIONS.size() != 2)
+        return {};
+
+    const QSize  OUTPUT = {DIMENSIONS[0].toInt(), DIMENSIONS[1].toInt()};
+    const QImage IMAGE  = CWallpaperCache::instance()->image(PATH, OUTPUT, VARIANT == "blurred" ? CWallpaperCache::VARIANT_BLURRED : CWallpaperCache::VARIANT_SHARP);
+
+    if (size)
+        *size = IMAGE.size();
+    return IMAGE;
+}
+
+CWallpaperCacheControl::CWallpaperCacheControl(QObject* parent) : QObject(parent) {
+    ;
+}
+
+static QString providerUrl(const char* variant, const QString& path, int width, int height) {
+    // Without a known size there is nothing to scale to: load the file as it is
+    if (width <= 0 || height <= 0 || path.isEmpty())
+        return path.isEmpty() ? QString() : QUrl::fromLocalFile(path).toString();
+
+    return QString("image://molten-wallpaper/%1/%2x%3/%4").arg(variant).arg(width).arg(height).arg(QString::fromLatin1(QUrl::toPercentEncoding(path)));
+}
+
+QString CWallpaperCacheControl::source(const QString& path, int width, int height) const {
+    return providerUrl("sharp", path, width, height);
+}
+
+QString CWallpaperCacheControl::blurredSource(const QString& path, int width, int height) const {
+    return providerUrl("blurred", path, width, height);
+}
+
+void CWallpaperCacheControl::prefetch(const QString& path, int width, int height) const {
+    if (width <= 0 || height <= 0 || path.isEmpty())
+        return;
+
+    // Building either variant builds both
+    QThreadPool::globalInstance()->start([path, width, height]() { CWallpaperCache::instance()->image(path, {width, height}, CWallpaperCache::VARIANT_SHARP); });
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/*
+ * Wallpaper Cache
+ * Wallpapers decoded once per output size and kept in
+ * $XDG_CACHE_HOME/molten/wallpapers as raw XRGB pixels behind a small header,
+ * so showing one again is an mmap instead of a decode. Sources are decoded
+ * straight to the cropped output size (JPEG scales while decoding), never at
+ * full resolution. Each entry also has a blurred variant at a quarter of the
+ * size, for glass and other static blurred backgrounds.
+ *
+ * Entries are keyed by a hash of the source's path, inode, size and mtime
+ * plus the output size, so an edited file gets a new entry without the source
+ * ever being read to hash it; the least recently used files are evicted past
+ * MAX_BYTES.
+ */
+
+#include <QImage>
+#include <QObject>
+#include <QQuickImageProvider>
+#include <QSize>
+#include <QString>
+#include <mutex>
+
+class CWallpaperCache {
+  public:
+    enum eVariant : uint8_t {
+        VARIANT_SHARP = 0, // Cropped and scaled to the output
+        VARIANT_BLURRED,   // Quarter size, blurred
+    };
+
+    static CWallpaperCache* instance();
+
+    // Maps the cached image, building it first if needed; null if the source
+    // cannot be decoded. Safe from any thread.
+    QImage                  image(const QString& source, const QSize& size, eVariant variant);
+
+  private:
+    CWallpaperCache();
+
+    static constexpr qint64 MAX_BYTES    = 1024LL << 20;
+    static constexpr int    BLUR_RADIUS  = 12; // At quarter size: about 48 px on the output
+    static constexpr int    BLUR_DIVISOR = 4;
+
+    QString                 m_directory;
+
+    // Builds run one at a time: every screen asking for the same wallpaper
+    // waits for the first decode instead of starting its own
+    std::mutex              m_buildMutex;
+
+    // Path of the entry without its variant suffix, empty if source is missing
+    QString                 entry(const QString& source, const QSize& size) const;
+    QImage                  map(const QString& file) const;
+    bool                    build(const QString& source, const QSize& size, const QString& entry) const;
+    bool                    store(const QImage& image, const QString& file) const;
+    void                    evict() const;
+
+    static QString          file(const QString& entry, eVariant variant);
+    static QImage           decode(const QString& source, const QSize& size);
+    static QImage           cover(const QImage& image, const QSize& size);
+    static void             blur(QImage& image, int radius);
+};
+
+// image://molten-wallpaper/<sharp|blurred>/<width>x<height>/<absolute path>
+class CWallpaperImageProvider : public QQuickImageProvider {
+  public:
+    CWallpaperImageProvider();
+
+    QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
+};
+
+// WallpaperCache {}: image URLs for the provider, and warming the cache ahead of use
+class CWallpaperCacheControl : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit CWallpaperCacheControl(QObject* parent = nullptr);
+
+    // Sizes are in physical pixels
+    Q_INVOKABLE QString source(const QString& path, int width, int height) const;
+    Q_INVOKABLE QString blurredSource(const QString& path, int width, int height) const;
+
+    // Builds both variants on the thread pool, so a later switch maps instead of decodes
+    Q_INVOKABLE void    prefetch(const QString& path, int width, int height) const;
+};
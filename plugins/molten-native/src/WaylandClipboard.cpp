@@ -0,0 +1,374 @@
+#include "WaylandClipboard.hpp"
+
+#include "wlr-data-control-unstable-v1-client-protocol.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <wayland-client.h>
+
+// Offered alongside our own selection so its echo is recognised and not read back
+static constexpr auto OWN_MIME = "application/x-molten-clipboard";
+
+// Password managers flag their copies with this; those never enter the history
+static constexpr auto SECRET_MIME = "x-kde-passwordManagerHint";
+
+static const QStringList TEXT_MIMES = {CWaylandClipboard::TEXT_MIME, "text/plain", "UTF8_STRING", "TEXT", "STRING"};
+
+// ============================================================================
+// LISTENERS
+// ============================================================================
+
+static const wl_registry_listener REGISTRY_LISTENER = {
+    .global        = CWaylandClipboard::onGlobal,
+    .global_remove = CWaylandClipboard::onGlobalRemove,
+};
+
+static const zwlr_data_control_device_v1_listener DEVICE_LISTENER = {
+    .data_offer        = CWaylandClipboard::onDataOffer,
+    .selection         = CWaylandClipboard::onDeviceSelection,
+    .finished          = CWaylandClipboard::onDeviceFinished,
+    .primary_selection = CWaylandClipboard::onPrimarySelection,
+};
+
+static const zwlr_data_control_offer_v1_listener OFFER_LISTENER = {
+    .offer = CWaylandClipboard::onOfferMime,
+};
+
+static const zwlr_data_control_source_v1_listener SOURCE_LISTENER = {
+    .send      = CWaylandClipboard::onSourceSend,
+    .cancelled = CWaylandClipboard::onSourceCancelled,
+};
+
+void CWaylandClipboard::onGlobal(void* data, wl_registry* registry, uint32_t name, const char* interface, uint32_t version) {
+    auto* self = static_cast<CWaylandClipboard*>(data);
+
+    if (!self->m_seat && qstrcmp(interface, wl_seat_interface.name) == 0)
+        self->m_seat = static_cast<wl_seat*>(wl_registry_bind(registry, name, &wl_seat_interface, 1));
+    else if (!self->m_manager && qstrcmp(interface, zwlr_data_control_manager_v1_interface.name) == 0)
+        self->m_manager =
+            static_cast<zwlr_data_control_manager_v1*>(wl_registry_bind(registry, name, &zwlr_data_control_manager_v1_interface, std::min<uint32_t>(version, 2)));
+}
+
+void CWaylandClipboard::onGlobalRemove(void*, wl_registry*, uint32_t) {
+    // A seat or manager going away ends in finished on the device
+}
+
+void CWaylandClipboard::onDataOffer(void* data, zwlr_data_control_device_v1*, zwlr_data_control_offer_v1* offer) {
+    auto* self = static_cast<CWaylandClipboard*>(data);
+
+    self->m_offers.insert(offer, {});
+    zwlr_data_control_offer_v1_add_listener(offer, &OFFER_LISTENER, self);
+}
+
+void CWaylandClipboard::onOfferMime(void* data, zwlr_data_control_offer_v1* offer, const char* mime) {
+    auto* self = static_cast<CWaylandClipboard*>(data);
+
+    if (const auto IT = self->m_offers.find(offer); IT != self->m_offers.end())
+        IT->append(QString::fromUtf8(mime));
+}
+
+void CWaylandClipboard::onDeviceSelection(void* data, zwlr_data_control_device_v1*, zwlr_data_control_offer_v1* offer) {
+    static_cast<CWaylandClipboard*>(data)->onSelection(offer);
+}
+
+void CWaylandClipboard::onPrimarySelection(void* data, zwlr_data_control_device_v1*, zwlr_data_control_offer_v1* offer) {
+    // Middle-click selection is not history
+    if (offer)
+        static_cast<CWaylandClipboard*>(data)->destroyOffer(offer);
+}
+
+void CWaylandClipboard::onDeviceFinished(void* data, zwlr_data_control_device_v1* device) {
+    auto* self = static_cast<CWaylandClipboard*>(data);
+
+    zwlr_data_control_device_v1_destroy(device);
+    self->m_device = nullptr;
+}
+
+void CWaylandClipboard::onSourceSend(void* data, zwlr_data_control_source_v1*, const char*, int32_t fd) {
+    static_cast<CWaylandClipboard*>(data)->startWrite(fd);
+}
+
+void CWaylandClipboard::onSourceCancelled(void* data, zwlr_data_control_source_v1* source) {
+    auto* self = static_cast<CWaylandClipboard*>(data);
+
+    zwlr_data_control_source_v1_destroy(source);
+    if (self->m_source == source) {
+        self->m_source = nullptr;
+        self->m_sourceData.clear();
+    }
+}
+
+// ============================================================================
+// CONNECTION
+// ============================================================================
+
+CWaylandClipboard::CWaylandClipboard(QObject* parent) : QObject(parent) {
+    m_display = wl_display_connect(nullptr);
+    if (!m_display)
+        return;
+
+    m_registry = wl_display_get_registry(m_display);
+    wl_registry_add_listener(m_registry, &REGISTRY_LISTENER, this);
+    wl_display_roundtrip(m_display);
+
+    if (!m_seat || !m_manager)
+        return;
+
+    // The device reports the current selection right away
+    m_device = zwlr_data_control_manager_v1_get_data_device(m_manager, m_seat);
+    zwlr_data_control_device_v1_add_listener(m_device, &DEVICE_LISTENER, this);
+    wl_display_flush(m_display);
+
+    m_notifier = new QSocketNotifier(wl_display_get_fd(m_display), QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &CWaylandClipboard::dispatch);
+}
+
+CWaylandClipboard::~CWaylandClipboard() {
+    stopRead();
+    for (const int fd : m_writes.keys())
+        stopWrite(fd);
+
+    if (!m_display)
+        return;
+
+    for (auto* offer : m_offers.keys())
+        zwlr_data_control_offer_v1_destroy(offer);
+    if (m_source)
+        zwlr_data_control_source_v1_destroy(m_source);
+    if (m_device)
+        zwlr_data_control_device_v1_destroy(m_device);
+    if (m_manager)
+        zwlr_data_control_manager_v1_destroy(m_manager);
+    if (m_seat)
+        wl_seat_destroy(m_seat);
+    if (m_registry)
+        wl_registry_destroy(m_registry);
+
+    wl_display_disconnect(m_display);
+}
+
+bool CWaylandClipboard::isAvailable() const {
+    return m_device != nullptr;
+}
+
+void CWaylandClipboard::dispatch() {
+    while (wl_display_prepare_read(m_display) != 0)
+        wl_display_dispatch_pending(m_display);
+    wl_display_flush(m_display);
+
+    // Non-blocking: a spurious wakeup reads nothing
+    if (wl_display_read_events(m_display) < 0) {
+        // Compositor gone: stay quiet rather than spin on a dead descriptor
+        m_notifier->setEnabled(false);
+        return;
+    }
+
+    wl_display_dispatch_pending(m_display);
+    wl_display_flush(m_display);
+}
+
+// ============================================================================
+// RECEIVING
+// ============================================================================
+
+void CWaylandClipboard::destroyOffer(zwlr_data_control_offer_v1* offer) {
+    m_offers.remove(offer);
+    zwlr_data_control_offer_v1_destroy(offer);
+}
+
+void CWaylandClipboard::onSelection(zwlr_data_control_offer_v1* offer) {
+    // Each new selection retires the previous offer
+    if (m_selection && m_selection != offer)
+        destroyOffer(m_selection);
+    m_selection = offer;
+
+    if (!offer)
+        return;
+
+    const QStringList MIMES = m_offers.value(offer);
+    if (MIMES.contains(OWN_MIME) || MIMES.contains(SECRET_MIME))
+        return;
+
+    for (const auto& mime : TEXT_MIMES) {
+        if (MIMES.contains(mime))
+            return startRead(offer, mime);
+    }
+
+    if (MIMES.contains("image/png"))
+        return startRead(offer, "image/png");
+
+    for (const auto& mime : MIMES) {
+        if (mime.startsWith("image/"))
+            return startRead(offer, mime);
+    }
+}
+
+void CWaylandClipboard::startRead(zwlr_data_control_offer_v1* offer, const QString& mime) {
+    // A newer selection makes an unfinished transfer irrelevant
+    stopRead();
+
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC | O_NONBLOCK) != 0)
+        return;
+
+    zwlr_data_control_offer_v1_receive(offer, mime.toUtf8().constData(), fds[1]);
+    wl_display_flush(m_display);
+    close(fds[1]);
+
+    m_readFd   = fds[0];
+    m_readMime = TEXT_MIMES.contains(mime) ? TEXT_MIME : mime;
+    m_readBuffer.clear();
+
+    m_readNotifier = new QSocketNotifier(m_readFd, QSocketNotifier::Read, this);
+    connect(m_readNotifier, &QSocketNotifier::activated, this, &CWaylandClipboard::onReadable);
+}
+
+void CWaylandClipboard::onReadable() {
+    char buffer[64 * 1024];
+
+    while (true) {
+        const ssize_t LENGTH = read(m_readFd, buffer, sizeof(buffer));
+
+        if (LENGTH > 0) {
+            m_readBuffer.append(buffer, LENGTH);
+            if (m_readBuffer.size() > MAX_BYTES)
+                return stopRead();
+            continue;
+        }
+
+        if (LENGTH < 0 && (errno == EAGAIN || errno == EINTR))
+            return;
+
+        // EOF (or a broken pipe): whatever arrived is the selection
+        const QString    MIME = m_readMime;
+        const QByteArray DATA = std::move(m_readBuffer);
+        stopRead();
+
+        if (!DATA.isEmpty())
+            emit selectionReceived(MIME, DATA);
+        return;
+    }
+}
+
+void CWaylandClipboard::stopRead() {
+    if (m_readNotifier) {
+        m_readNotifier->setEnabled(false);
+        m_readNotifier->deleteLater();
+        m_readNotifier = nullptr;
+    }
+
+    if (m_readFd >= 0)
+        close(m_readFd);
+
+    m_readFd = -1;
+    m_readBuffer.clear();
+}
+
+// ============================================================================
+// SENDING
+// ============================================================================
+
+// write() that fails with EPIPE on a closed reader instead of raising SIGPIPE. The fd is usually a
+// pipe, where send(MSG_NOSIGNAL) doesn't apply, and the process's disposition is the host's to set:
+// SIGPIPE is blocked on this thread for the call and a signal it raised is consumed.
+static ssize_t writeNoSignal(int fd, const char* data, size_t length) {
+    sigset_t pipeSet, pending, old;
+    sigemptyset(&pipeSet);
+    sigaddset(&pipeSet, SIGPIPE);
+
+    // One already pending was raised by something else and stays pending
+    sigpending(&pending);
+    const bool WASPENDING = sigismember(&pending, SIGPIPE);
+
+    pthread_sigmask(SIG_BLOCK, &pipeSet, &old);
+    const ssize_t WRITTEN = write(fd, data, length);
+    const int     ERR     = errno;
+
+    if (WRITTEN < 0 && ERR == EPIPE && !WASPENDING) {
+        const timespec NOWAIT = {};
+        while (sigtimedwait(&pipeSet, nullptr, &NOWAIT) < 0 && errno == EINTR) {
+            ;
+        }
+    }
+
+    pthread_sigmask(SIG_SETMASK, &old, nullptr);
+    errno = ERR;
+    return WRITTEN;
+}
+
+void CWaylandClipboard::startWrite(int fd) {
+    // The reader's pipe: written as it drains, so a reader that stalls never holds up the shell
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    // A copy of the selection as it is now; setSelection replacing it doesn't change what this reader gets
+    auto& pending    = m_writes[fd];
+    pending.data     = m_sourceData;
+    pending.notifier = new QSocketNotifier(fd, QSocketNotifier::Write, this);
+    connect(pending.notifier, &QSocketNotifier::activated, this, [this, fd] { onWritable(fd); });
+
+    // Most selections fit in the pipe at once
+    onWritable(fd);
+}
+
+void CWaylandClipboard::onWritable(int fd) {
+    const auto IT = m_writes.find(fd);
+    if (IT == m_writes.end())
+        return;
+
+    while (IT->offset < IT->data.size()) {
+        const ssize_t WRITTEN = writeNoSignal(fd, IT->data.constData() + IT->offset, IT->data.size() - IT->offset);
+
+        if (WRITTEN > 0) {
+            IT->offset += WRITTEN;
+            continue;
+        }
+
+        if (WRITTEN < 0 && (errno == EAGAIN || errno == EINTR))
+            return;
+
+        // EPIPE: the reader went away
+        break;
+    }
+
+    // Sent (or given up): closing the pipe is the reader's end of data
+    stopWrite(fd);
+}
+
+void CWaylandClipboard::stopWrite(int fd) {
+    const auto IT = m_writes.find(fd);
+    if (IT == m_writes.end())
+        return;
+
+    IT->notifier->setEnabled(false);
+    IT->notifier->deleteLater();
+    m_writes.erase(IT);
+
+    close(fd);
+}
+
+void CWaylandClipboard::setSelection(const QString& mime, const QByteArray& data) {
+    if (!m_device)
+        return;
+
+    if (m_source)
+        zwlr_data_control_source_v1_destroy(m_source);
+
+    m_source     = zwlr_data_control_manager_v1_create_data_source(m_manager);
+    m_sourceData = data;
+    zwlr_data_control_source_v1_add_listener(m_source, &SOURCE_LISTENER, this);
+
+    if (mime == TEXT_MIME) {
+        for (const auto& alias : TEXT_MIMES)
+            zwlr_data_control_source_v1_offer(m_source, alias.toUtf8().constData());
+    } else
+        zwlr_data_control_source_v1_offer(m_source, mime.toUtf8().constData());
+    zwlr_data_control_source_v1_offer(m_source, OWN_MIME);
+
+    zwlr_data_control_device_v1_set_selection(m_device, m_source);
+    wl_display_flush(m_display);
+}
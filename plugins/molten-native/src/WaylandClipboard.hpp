@@ -0,0 +1,100 @@
+#pragma once
+
+/*
+ * Wayland Clipboard
+ * Watches and sets the clipboard through wlr-data-control on a private
+ * Wayland connection, the protocol wl-paste and wl-copy use: no focus needed
+ * and no process spawned per change. Offered data is read from its pipe as
+ * the event loop reports it readable, and our own selection is written to a
+ * reader's pipe as it drains, so a slow client on either side never blocks
+ * the shell.
+ */
+
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QSocketNotifier>
+#include <QString>
+#include <QStringList>
+
+struct wl_display;
+struct wl_registry;
+struct wl_seat;
+struct zwlr_data_control_manager_v1;
+struct zwlr_data_control_device_v1;
+struct zwlr_data_control_offer_v1;
+struct zwlr_data_control_source_v1;
+
+class CWaylandClipboard : public QObject {
+    Q_OBJECT
+
+  public:
+    explicit CWaylandClipboard(QObject* parent = nullptr);
+    ~CWaylandClipboard() override;
+
+    // False without a compositor that speaks wlr-data-control
+    bool           isAvailable() const;
+
+    // Takes the selection; text is also offered under the usual text aliases
+    void           setSelection(const QString& mime, const QByteArray& data);
+
+    // Text is reported as this, whatever the source called it
+    static constexpr auto TEXT_MIME = "text/plain;charset=utf-8";
+
+    // Wayland listener callbacks, data is the CWaylandClipboard
+    static void                         onGlobal(void* data, wl_registry* registry, uint32_t name, const char* interface, uint32_t version);
+    static void                         onGlobalRemove(void* data, wl_registry* registry, uint32_t name);
+    static void                         onDataOffer(void* data, zwlr_data_control_device_v1* device, zwlr_data_control_offer_v1* offer);
+    static void                         onDeviceSelection(void* data, zwlr_data_control_device_v1* device, zwlr_data_control_offer_v1* offer);
+    static void                         onDeviceFinished(void* data, zwlr_data_control_device_v1* device);
+    static void                         onPrimarySelection(void* data, zwlr_data_control_device_v1* device, zwlr_data_control_offer_v1* offer);
+    static void                         onOfferMime(void* data, zwlr_data_control_offer_v1* offer, const char* mime);
+    static void                         onSourceSend(void* data, zwlr_data_control_source_v1* source, const char* mime, int32_t fd);
+    static void                         onSourceCancelled(void* data, zwlr_data_control_source_v1* source);
+
+  signals:
+    void selectionReceived(const QString& mime, const QByteArray& data);
+
+  private:
+    // Larger offers are skipped rather than held in memory twice
+    static constexpr qsizetype          MAX_BYTES = 64 << 20;
+
+    wl_display*                         m_display  = nullptr;
+    wl_registry*                        m_registry = nullptr;
+    wl_seat*                            m_seat     = nullptr;
+    zwlr_data_control_manager_v1*       m_manager  = nullptr;
+    zwlr_data_control_device_v1*        m_device   = nullptr;
+    QSocketNotifier*                    m_notifier = nullptr;
+
+    // Offers seen on the device and the mime types each advertised
+    QHash<zwlr_data_control_offer_v1*, QStringList> m_offers;
+    zwlr_data_control_offer_v1*         m_selection = nullptr;
+
+    // Transfer in progress
+    int                                 m_readFd = -1;
+    QSocketNotifier*                    m_readNotifier = nullptr;
+    QString                             m_readMime;
+    QByteArray                          m_readBuffer;
+
+    // Our own selection, served until another client replaces it
+    zwlr_data_control_source_v1*        m_source = nullptr;
+    QByteArray                          m_sourceData;
+
+    // Sends in progress, by reader pipe; each keeps the data it was asked for
+    struct SWrite {
+        QSocketNotifier* notifier = nullptr;
+        QByteArray       data;
+        qsizetype        offset = 0;
+    };
+    QHash<int, SWrite>                  m_writes;
+
+    void                                dispatch();
+    void                                onSelection(zwlr_data_control_offer_v1* offer);
+    void                                startRead(zwlr_data_control_offer_v1* offer, const QString& mime);
+    void                                onReadable();
+    void                                stopRead();
+    void                                startWrite(int fd);
+    void                                onWritable(int fd);
+    void                                stopWrite(int fd);
+    void                                destroyOffer(zwlr_data_control_offer_v1* offer);
+};
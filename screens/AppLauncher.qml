@@ -331,11 +331,7 @@ Item {
     }
 
     function getAppById(appId) {
-        var allApps = AppSearch.getAllApps()
-        for (var i = 0; i < allApps.length; i++) {
-            if (allApps[i].id === appId) return allApps[i]
-        }
-        return null
+        return AppSearch.getAppById(appId)
     }
 
     // ============ SEARCH HANDLING ============
@@ -417,12 +413,12 @@ Item {
     }
 
     function updateSearchResults() {
+        // fuzzyQuery hands out fresh objects, so they can be tagged in place
         var results = AppSearch.fuzzyQuery(searchQuery)
-        var items = []
         for (var i = 0; i < results.length; i++) {
-            items.push(Object.assign({}, results[i], { type: "app" }))
+            results[i].type = "app"
         }
-        displayedApps = items
+        displayedApps = results
         selectedIndex = -1
         keyboardMode = false
     }
@@ -751,13 +747,8 @@ Item {
                                                     var icons = []
                                                     var apps = modelData.apps
                                                     for (var i = 0; i < Math.min(4, apps.length); i++) {
-                                                        var allApps = AppSearch.getAllApps()
-                                                        for (var j = 0; j < allApps.length; j++) {
-                                                            if (allApps[j].id === apps[i]) {
-                                                                icons.push(allApps[j].icon)
-                                                                break
-                                                            }
-                                                        }
+                                                        var app = AppSearch.getAppById(apps[i])
+                                                        if (app) icons.push(app.icon)
                                                     }
                                                     // Pad with empty slots if less than 4 apps
                                                     while (icons.length < 4) icons.push("")
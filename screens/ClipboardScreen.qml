@@ -20,8 +20,12 @@ Item {
     property string searchQuery: ""
     property int selectedIndex: 0
 
+    // Native model filters itself through its query
+    readonly property var nativeHistory: Clipboard.nativeHistory
+
     // Filtered history
     property var filteredHistory: {
+        if (nativeHistory) return []
         if (searchQuery === "") return Clipboard.history
         var query = searchQuery.toLowerCase()
         return Clipboard.history.filter(function(item) {
@@ -29,6 +33,19 @@ Item {
         })
     }
 
+    readonly property int itemCount: nativeHistory ? nativeHistory.count : filteredHistory.length
+
+    function itemAt(i) {
+        return nativeHistory ? nativeHistory.get(i) : filteredHistory[i]
+    }
+
+    Binding {
+        target: root.nativeHistory
+        property: "query"
+        value: root.searchQuery
+        when: root.nativeHistory !== null
+    }
+
     // Adaptive colors
     AdaptiveColors {
         id: adaptiveColors
@@ -41,19 +58,19 @@ Item {
             root.closeRequested()
             event.accepted = true
         } else if (event.key === Qt.Key_Down) {
-            selectedIndex = Math.min(selectedIndex + 1, filteredHistory.length - 1)
+            selectedIndex = Math.min(selectedIndex + 1, itemCount - 1)
             event.accepted = true
         } else if (event.key === Qt.Key_Up) {
             selectedIndex = Math.max(selectedIndex - 1, 0)
             event.accepted = true
         } else if (event.key === Qt.Key_Return || event.key === Qt.Key_Enter) {
-            if (filteredHistory.length > 0 && selectedIndex >= 0) {
-                pasteItem(filteredHistory[selectedIndex])
+            if (itemCount > 0 && selectedIndex >= 0) {
+                pasteItem(itemAt(selectedIndex))
             }
             event.accepted = true
         } else if (event.key === Qt.Key_Delete) {
-            if (filteredHistory.length > 0 && selectedIndex >= 0) {
-                Clipboard.remove(filteredHistory[selectedIndex].id)
+            if (itemCount > 0 && selectedIndex >= 0) {
+                Clipboard.remove(itemAt(selectedIndex).id)
             }
             event.accepted = true
         }
@@ -191,7 +208,7 @@ Item {
             height: parent.height - 120
             clip: true
             spacing: 4
-            model: filteredHistory
+            model: root.nativeHistory ? root.nativeHistory : filteredHistory
             currentIndex: selectedIndex
 
             delegate: Rectangle {
@@ -205,25 +222,41 @@ Item {
                     return "transparent"
                 }
 
-                property var itemData: modelData
+                property var itemData: root.nativeHistory ? model : modelData
 
                 RowLayout {
                     anchors.fill: parent
                     anchors.margins: 10
                     spacing: 10
 
-                    // Icon
-                    Rectangle {
+                    // Icon, or a thumbnail for native image entries
+                    Item {
                         Layout.preferredWidth: 40
                         Layout.preferredHeight: 40
-                        radius: 6
-                        color: adaptiveColors.textColor
-                        opacity: 0.1
 
-                        Text {
-                            anchors.centerIn: parent
-                            text: itemData.isImage ? "🖼️" : "📄"
-                            font.pixelSize: 18
+                        Rectangle {
+                            anchors.fill: parent
+                            radius: 6
+                            color: adaptiveColors.textColor
+                            opacity: 0.1
+
+                            Text {
+                                anchors.centerIn: parent
+                                visible: thumbnail.status !== Image.Ready
+                                text: itemData.isImage ? "🖼️" : "📄"
+                                font.pixelSize: 18
+                            }
+                        }
+
+                        Image {
+                            id: thumbnail
+                            anchors.fill: parent
+                            source: itemData.thumbnail ? itemData.thumbnail : ""
+                            sourceSize.width: 40
+                            sourceSize.height: 40
+                            fillMode: Image.PreserveAspectCrop
+                            asynchronous: true
+                            cache: false
                         }
                     }
 
@@ -243,7 +276,7 @@ Item {
                         }
 
                         Text {
-                            text: itemData.isImage ? "Binary data" : (itemData.preview.length + " chars")
+                            text: itemData.isImage ? "Binary data" : (itemData.length + " chars")
                             color: adaptiveColors.subtleTextColor
                             font.pixelSize: 10
                         }
@@ -288,7 +321,7 @@ Item {
 
             // Empty state
             Item {
-                visible: filteredHistory.length === 0
+                visible: root.itemCount === 0
                 anchors.centerIn: parent
                 width: parent.width
                 height: 100
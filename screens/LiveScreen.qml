@@ -290,7 +290,7 @@ Item {
                     Item {
                         width: 28
                         height: 28
-                        visible: Notifications.list.length > 0
+                        visible: Notifications.count > 0
                         
                         Text {
                             anchors.centerIn: parent
@@ -316,6 +316,9 @@ Item {
                     contentHeight: notifColumn.height
                     boundsBehavior: Flickable.StopAtBounds
 
+                    // Native history is paged: pull the next page in near the end
+                    onAtYEndChanged: if (atYEnd && Notifications.nativeHistory) Notifications.nativeHistory.loadMore()
+
                     Column {
                         id: notifColumn
                         width: parent.width
@@ -325,7 +328,7 @@ Item {
                         Item {
                             width: parent.width
                             height: 150
-                            visible: Notifications.list.length === 0
+                            visible: Notifications.count === 0
 
                             Column {
                                 anchors.centerIn: parent
@@ -347,14 +350,14 @@ Item {
 
                         // Notifications - sorted by time descending
                         Repeater {
-                            model: Notifications.list.slice().sort((a, b) => b.time - a.time)
+                            model: Notifications.nativeHistory ? Notifications.nativeHistory : Notifications.list.slice().sort((a, b) => b.time - a.time)
 
                             Item {
                                 id: notifItem
                                 width: parent.width
                                 height: notifContent.implicitHeight + 20
                                 
-                                property var notification: modelData
+                                property var notification: Notifications.nativeHistory ? model : modelData
                                 
                                 RowLayout {
                                     id: notifContent
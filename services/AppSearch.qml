@@ -8,6 +8,10 @@ Singleton {
     id: root
 
     property var iconCache: ({})
+
+    // Native index from plugins/molten-native when installed, null otherwise;
+    // the JS index below is only built without it
+    property var nativeIndex: null
     
     function getCachedIcon(str) {
         if (!str) return "image-missing";
@@ -49,6 +53,11 @@ Singleton {
     function getIconFromDesktopEntry(className) {
         if (!className || className.length === 0) return null;
 
+        if (nativeIndex) {
+            const nativeIcon = nativeIndex.iconForClass(className);
+            return nativeIcon.length > 0 ? nativeIcon : null;
+        }
+
         const normalizedClassName = className.toLowerCase();
 
         for (let i = 0; i < list.length; i++) {
@@ -138,6 +147,8 @@ Singleton {
     property var searchIndex: []
     
     function buildIndex() {
+        if (nativeIndex) return;
+
         const newIndex = [];
         for (let i = 0; i < list.length; i++) {
             const app = list[i];
@@ -155,13 +166,16 @@ Singleton {
     }
     
     property var allAppsCache: null
+    property var appsByIdCache: null
 
     function invalidateCache() {
         allAppsCache = null;
+        appsByIdCache = null;
     }
 
     onListChanged: {
         allAppsCache = null;
+        appsByIdCache = null;
         buildIndex();
         if (list.length > 0) {
             appsReady();
@@ -169,6 +183,12 @@ Singleton {
     }
     
     Component.onCompleted: {
+        try {
+            nativeIndex = Qt.createQmlObject("import Molten.Native; AppIndex {}", root, "AppSearch.nativeIndex");
+        } catch (e) {
+            console.log("AppSearch: Molten.Native not installed, searching in QML");
+        }
+
         buildIndex();
         if (list.length > 0) {
             appsReady();
@@ -214,9 +234,33 @@ Singleton {
         allAppsCache = results;
         return results;
     }
+
+    function getAppById(appId) {
+        if (!appsByIdCache) {
+            const apps = getAllApps();
+            const byId = {};
+            for (let i = 0; i < apps.length; i++) byId[apps[i].id] = apps[i];
+            appsByIdCache = byId;
+        }
+        return appsByIdCache[appId] || null;
+    }
+
+    // Ranking happens in the native index; this only looks up the matches
+    function nativeQuery(search) {
+        const matches = nativeIndex.search(search, 0);
+        const results = [];
+
+        for (let i = 0; i < matches.length; i++) {
+            const app = getAppById(matches[i].id);
+            if (app) results.push(Object.assign({}, app, { score: matches[i].score }));
+        }
+
+        return results;
+    }
     
     function fuzzyQuery(search) {
         if (!search || search.length === 0) return [];
+        if (nativeIndex) return nativeQuery(search);
         
         const searchLower = search.toLowerCase();
         const results = [];
@@ -5,7 +5,10 @@ import Quickshell
 import Quickshell.Io
 
 /**
- * Bluetooth service - Handles Bluetooth status and control via bluetoothctl
+ * Bluetooth service - Handles Bluetooth status and control
+ *
+ * Uses Molten.Native's BluetoothState (BlueZ over D-Bus, updated on change)
+ * when installed; otherwise bluetoothctl, polled every 10 seconds.
  */
 Singleton {
     id: root
@@ -16,6 +19,10 @@ Singleton {
     property bool connected: false
     property int connectedDevices: 0
 
+    // Molten.Native BluetoothState; the state above follows it while set
+    property var nativeBluetooth: null
+    property bool nativeChecked: false
+
     // ═══════════════════════════════════════════════════════════════
     // BLUETOOTH CONTROL
     // ═══════════════════════════════════════════════════════════════
@@ -25,6 +32,10 @@ Singleton {
     }
 
     function setEnabled(value) {
+        if (nativeBluetooth) {
+            nativeBluetooth.setEnabled(value)
+            return
+        }
         toggleProc.command = ["bluetoothctl", "power", value ? "on" : "off"]
         toggleProc.running = true
     }
@@ -32,8 +43,12 @@ Singleton {
     function startDiscovery() {
         if (enabled) {
             discovering = true
-            scanProc.command = ["bluetoothctl", "scan", "on"]
-            scanProc.running = true
+            if (nativeBluetooth) {
+                nativeBluetooth.startDiscovery()
+            } else {
+                scanProc.command = ["bluetoothctl", "scan", "on"]
+                scanProc.running = true
+            }
             // Stop scanning after 15 seconds
             scanTimer.restart()
         }
@@ -41,17 +56,29 @@ Singleton {
 
     function stopDiscovery() {
         discovering = false
+        scanTimer.stop()
+        if (nativeBluetooth) {
+            nativeBluetooth.stopDiscovery()
+            return
+        }
         stopScanProc.command = ["bluetoothctl", "scan", "off"]
         stopScanProc.running = true
-        scanTimer.stop()
     }
 
     function connectDevice(address) {
+        if (nativeBluetooth) {
+            nativeBluetooth.connectDevice(address)
+            return
+        }
         connectProc.command = ["bluetoothctl", "connect", address]
         connectProc.running = true
     }
 
     function disconnectDevice(address) {
+        if (nativeBluetooth) {
+            nativeBluetooth.disconnectDevice(address)
+            return
+        }
         disconnectProc.command = ["bluetoothctl", "disconnect", address]
         disconnectProc.running = true
     }
@@ -61,6 +88,10 @@ Singleton {
     // ═══════════════════════════════════════════════════════════════
 
     function updateStatus() {
+        if (nativeBluetooth) {
+            syncNative()
+            return
+        }
         checkPowerProc.running = true
     }
 
@@ -95,7 +126,7 @@ Singleton {
     Process {
         id: checkPowerProc
         command: ["bash", "-c", "bluetoothctl show | grep 'Powered:' | awk '{print $2}'"]
-        running: true
+        running: root.nativeChecked && !root.nativeBluetooth
         stdout: SplitParser {
             onRead: (data) => {
                 var output = data.trim()
@@ -135,10 +166,35 @@ Singleton {
     // Periodic refresh
     Timer {
         interval: 10000
-        running: true
+        running: root.nativeChecked && !root.nativeBluetooth
         repeat: true
         onTriggered: root.updateStatus()
     }
 
-    Component.onCompleted: updateStatus()
+    function syncNative() {
+        enabled = nativeBluetooth.enabled
+        discovering = nativeBluetooth.discovering
+        connected = nativeBluetooth.connected
+        connectedDevices = nativeBluetooth.connectedDevices
+    }
+
+    Connections {
+        target: root.nativeBluetooth
+        function onStateChanged() { root.syncNative() }
+    }
+
+    Component.onCompleted: {
+        try {
+            const bluetooth = Qt.createQmlObject("import Molten.Native; BluetoothState {}", root, "Bluetooth.nativeBluetooth")
+            if (bluetooth.available) {
+                nativeBluetooth = bluetooth
+                syncNative()
+            } else {
+                bluetooth.destroy()
+            }
+        } catch (e) {
+            console.log("Bluetooth: Molten.Native not installed, using bluetoothctl")
+        }
+        nativeChecked = true
+    }
 }
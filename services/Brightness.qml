@@ -7,6 +7,9 @@ import Quickshell.Io
 /**
  * Brightness service - Handles screen brightness control
  * Similar behavior to Audio service for volume
+ *
+ * Uses Molten.Native's Backlight (sysfs, change notifications, coalesced
+ * writes) when installed; otherwise brightnessctl, polled every 5 seconds.
  */
 Singleton {
     id: root
@@ -19,6 +22,10 @@ Singleton {
     property string device: ""
     property int maxBrightness: 100
 
+    // Molten.Native Backlight; brightness follows it while set
+    property var nativeBacklight: null
+    property bool nativeChecked: false
+
     // ═══════════════════════════════════════════════════════════════
     // BRIGHTNESS CONTROL
     // ═══════════════════════════════════════════════════════════════
@@ -26,6 +33,11 @@ Singleton {
     function setBrightness(val) {
         var clamped = Math.max(0.05, Math.min(1, val))  // Min 5% to avoid black screen
         root.brightness = clamped
+        if (nativeBacklight) {
+            // Coalesced natively: a drag writes only as fast as the driver keeps up
+            nativeBacklight.setBrightness(clamped)
+            return
+        }
         setBrightnessProc.command = ["brightnessctl", "set", Math.round(clamped * 100) + "%"]
         setBrightnessProc.running = true
     }
@@ -50,7 +62,7 @@ Singleton {
     Process {
         id: getBrightnessProc
         command: ["bash", "-c", "brightnessctl -m | cut -d, -f4 | tr -d '%'"]
-        running: true
+        running: root.nativeChecked && !root.nativeBacklight
         stdout: SplitParser {
             onRead: (data) => {
                 var percent = parseInt(data.trim())
@@ -65,7 +77,7 @@ Singleton {
     Process {
         id: getMaxBrightnessProc
         command: ["brightnessctl", "max"]
-        running: true
+        running: root.nativeChecked && !root.nativeBacklight
         stdout: SplitParser {
             onRead: (data) => {
                 var max = parseInt(data.trim())
@@ -79,13 +91,39 @@ Singleton {
     // Refresh brightness periodically (in case changed externally)
     Timer {
         interval: 5000
-        running: true
+        running: root.nativeChecked && !root.nativeBacklight
         repeat: true
         onTriggered: getBrightnessProc.running = true
     }
     
     // Function to force refresh (called when brightness overlay is shown)
     function refresh() {
+        if (nativeBacklight) {
+            nativeBacklight.refresh()
+            return
+        }
         getBrightnessProc.running = true
     }
+
+    Connections {
+        target: root.nativeBacklight
+        function onBrightnessChanged() { root.brightness = root.nativeBacklight.brightness }
+    }
+
+    Component.onCompleted: {
+        try {
+            const backlight = Qt.createQmlObject("import Molten.Native; Backlight {}", root, "Brightness.nativeBacklight")
+            if (backlight.available) {
+                nativeBacklight = backlight
+                device = backlight.device
+                maxBrightness = backlight.maxBrightness
+                brightness = backlight.brightness
+            } else {
+                backlight.destroy()
+            }
+        } catch (e) {
+            console.log("Brightness: Molten.Native not installed, using brightnessctl")
+        }
+        nativeChecked = true
+    }
 }
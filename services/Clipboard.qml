@@ -5,7 +5,8 @@ import Quickshell
 import Quickshell.Io
 
 /**
- * Clipboard service - Manages clipboard history using cliphist
+ * Clipboard service - Manages clipboard history
+ * Uses Molten.Native's ClipboardHistory model when installed, cliphist otherwise
  */
 Singleton {
     id: root
@@ -18,20 +19,33 @@ Singleton {
     // Currently selected item for paste
     property var selectedItem: null
 
+    // Molten.Native ClipboardHistory model; history stays empty while it is set
+    property var nativeHistory: null
+    property bool nativeChecked: false
+
     // ═══════════════════════════════════════════════════════════════
     // CLIPBOARD OPERATIONS
     // ═══════════════════════════════════════════════════════════════
 
     function refresh() {
+        if (nativeHistory) return
         listProc.running = true
     }
 
     function paste(id) {
+        if (nativeHistory) {
+            nativeHistory.paste(id)
+            return
+        }
         pasteProc.command = ["bash", "-c", "cliphist decode " + id + " | wl-copy"]
         pasteProc.running = true
     }
 
     function remove(id) {
+        if (nativeHistory) {
+            nativeHistory.remove(id)
+            return
+        }
         removeProc.command = ["bash", "-c", "cliphist delete-query " + id]
         removeProc.running = true
         // Refresh after deletion
@@ -39,6 +53,10 @@ Singleton {
     }
 
     function clear() {
+        if (nativeHistory) {
+            nativeHistory.clear()
+            return
+        }
         clearProc.running = true
         // Refresh after clearing
         clearRefreshTimer.start()
@@ -74,6 +92,7 @@ Singleton {
                             id: id,
                             preview: preview,
                             isImage: isImage,
+                            length: preview.length,
                             timestamp: Date.now() - i  // For sorting
                         })
                     }
@@ -118,13 +137,29 @@ Singleton {
     }
 
     // Initial load only - no periodic refresh to avoid scroll reset
-    Component.onCompleted: refresh()
+    Component.onCompleted: {
+        try {
+            nativeHistory = Qt.createQmlObject("import Molten.Native; ClipboardHistory {}", root, "Clipboard.nativeHistory")
+        } catch (e) {
+            console.log("Clipboard: Molten.Native not installed, using cliphist")
+        }
+        nativeChecked = true
+
+        if (nativeHistory) {
+            if (!nativeHistory.monitoring) {
+                error = "Clipboard monitoring needs a compositor with wlr-data-control"
+            }
+            ready = true
+            return
+        }
+        refresh()
+    }
 
-    // Watch for clipboard changes using wl-paste --watch
+    // Watch for clipboard changes using wl-paste --watch (the native model watches itself)
     Process {
         id: clipboardWatcher
         command: ["wl-paste", "--watch", "echo", "changed"]
-        running: true
+        running: root.nativeChecked && root.nativeHistory === null
         stdout: SplitParser {
             splitMarker: "\n"
             onRead: (data) => {
@@ -5,7 +5,10 @@ import Quickshell
 import Quickshell.Io
 
 /**
- * Network service - Handles WiFi status and control via nmcli
+ * Network service - Handles WiFi status and control
+ *
+ * Uses Molten.Native's NetworkState (NetworkManager over D-Bus, updated on
+ * change) when installed; otherwise nmcli, re-run on nmcli monitor output.
  */
 Singleton {
     id: root
@@ -20,6 +23,11 @@ Singleton {
     // Ethernet state
     property bool ethernetConnected: false
 
+    // Molten.Native NetworkState; the state above follows it while set
+    property var nativeNetwork: null
+    property bool nativeChecked: false
+    readonly property bool polling: nativeChecked && !nativeNetwork
+
     // ═══════════════════════════════════════════════════════════════
     // WIFI CONTROL
     // ═══════════════════════════════════════════════════════════════
@@ -29,12 +37,20 @@ Singleton {
     }
 
     function enableWifi(enabled) {
+        if (nativeNetwork) {
+            nativeNetwork.setWifiEnabled(enabled)
+            return
+        }
         var cmd = enabled ? "on" : "off"
         enableWifiProc.command = ["nmcli", "radio", "wifi", cmd]
         enableWifiProc.running = true
     }
 
     function rescanWifi() {
+        if (nativeNetwork) {
+            nativeNetwork.rescan()
+            return
+        }
         rescanProc.running = true
     }
 
@@ -43,6 +59,10 @@ Singleton {
     // ═══════════════════════════════════════════════════════════════
 
     function update() {
+        if (nativeNetwork) {
+            syncNative()
+            return
+        }
         wifiStatusProc.running = true
         connectionStatusProc.running = true
         networkNameProc.running = true
@@ -68,7 +88,7 @@ Singleton {
     Process {
         id: wifiStatusProc
         command: ["nmcli", "radio", "wifi"]
-        running: true
+        running: root.polling
         environment: ({ LANG: "C", LC_ALL: "C" })
         stdout: SplitParser {
             onRead: (data) => {
@@ -84,7 +104,7 @@ Singleton {
     Process {
         id: connectionStatusProc
         command: ["sh", "-c", "nmcli -t -f TYPE,STATE d status && nmcli -t -f CONNECTIVITY g"]
-        running: true
+        running: root.polling
         property string buffer: ""
         stdout: SplitParser {
             onRead: (data) => {
@@ -131,7 +151,7 @@ Singleton {
     Process {
         id: networkNameProc
         command: ["sh", "-c", "nmcli -t -f NAME c show --active | head -1"]
-        running: true
+        running: root.polling
         stdout: SplitParser {
             onRead: (data) => {
                 root.networkName = data.trim()
@@ -143,7 +163,7 @@ Singleton {
     Process {
         id: networkStrengthProc
         command: ["sh", "-c", "nmcli -f IN-USE,SIGNAL,SSID device wifi | awk '/^\\*/{if (NR!=1) {print $2}}'"]
-        running: true
+        running: root.polling
         stdout: SplitParser {
             onRead: (data) => {
                 root.networkStrength = parseInt(data.trim()) || 0
@@ -155,7 +175,7 @@ Singleton {
     Process {
         id: monitorProc
         command: ["nmcli", "monitor"]
-        running: true
+        running: root.polling
         stdout: SplitParser {
             onRead: root.update()
         }
@@ -164,10 +184,37 @@ Singleton {
     // Periodic refresh
     Timer {
         interval: 30000
-        running: true
+        running: root.polling
         repeat: true
         onTriggered: root.update()
     }
 
-    Component.onCompleted: update()
+    function syncNative() {
+        wifiEnabled = nativeNetwork.wifiEnabled
+        wifiConnected = nativeNetwork.wifiConnected
+        wifiStatus = nativeNetwork.wifiStatus
+        networkName = nativeNetwork.networkName
+        networkStrength = nativeNetwork.networkStrength
+        ethernetConnected = nativeNetwork.ethernetConnected
+    }
+
+    Connections {
+        target: root.nativeNetwork
+        function onStateChanged() { root.syncNative() }
+    }
+
+    Component.onCompleted: {
+        try {
+            const network = Qt.createQmlObject("import Molten.Native; NetworkState {}", root, "Network.nativeNetwork")
+            if (network.available) {
+                nativeNetwork = network
+                syncNative()
+            } else {
+                network.destroy()
+            }
+        } catch (e) {
+            console.log("Network: Molten.Native not installed, using nmcli")
+        }
+        nativeChecked = true
+    }
 }
@@ -9,6 +9,10 @@ import Quickshell.Services.Notifications
 /**
  * Notification service - based on Ambxst implementation
  * Handles notification server, persistence, grouping, and popup management
+ *
+ * With Molten.Native installed, history lives in its NotificationHistory
+ * journal and list only holds this session's popups; otherwise everything is
+ * kept in list and saved to notifications.json.
  */
 Singleton {
     id: root
@@ -50,13 +54,13 @@ Singleton {
                 summary = notification.summary ?? ""
                 urgency = notification.urgency ?? NotificationUrgency.Normal
 
-                // Cache images from URLs
-                if (appIcon && !appIcon.startsWith("data:")) {
+                // Cache images from URLs (the native journal caches them as files)
+                if (!root.nativeHistory && appIcon && !appIcon.startsWith("data:")) {
                     root.cacheImageAsBase64(appIcon, function(cachedData) {
                         cachedAppIcon = cachedData
                     })
                 }
-                if (image && !image.startsWith("data:")) {
+                if (!root.nativeHistory && image && !image.startsWith("data:")) {
                     root.cacheImageAsBase64(image, function(cachedData) {
                         cachedImage = cachedData
                     })
@@ -140,6 +144,13 @@ Singleton {
     // All notifications for notification center
     property var notifications: list
 
+    // Molten.Native NotificationHistory model, paged, newest first
+    property var nativeHistory: null
+    property bool nativeChecked: false
+
+    // Stored notifications, for badges
+    readonly property int count: nativeHistory ? nativeHistory.count : list.length
+
     Component {
         id: notifComponent
         Notif {}
@@ -156,7 +167,7 @@ Singleton {
     
     FileView {
         id: notifFileView
-        path: Quickshell.dataPath("notifications.json")
+        path: root.nativeChecked && !root.nativeHistory ? Quickshell.dataPath("notifications.json") : ""
         onLoaded: loadNotifications()
     }
 
@@ -200,6 +211,7 @@ Singleton {
     }
 
     function saveNotifications() {
+        if (nativeHistory) return
         const limitedList = limitNotificationsPerSummary(root.list)
         notifFileView.setText(stringifyList(limitedList))
     }
@@ -330,10 +342,29 @@ Singleton {
                 "time": Date.now()
             })
 
-            Qt.callLater(() => {
-                root.list = [...root.list, newNotifObject]
-                saveNotifications()
-            })
+            if (root.nativeHistory) {
+                root.nativeHistory.add({
+                    "id": newNotifObject.id,
+                    "appName": newNotifObject.appName,
+                    "appIcon": newNotifObject.appIcon,
+                    "summary": newNotifObject.summary,
+                    "body": newNotifObject.body,
+                    "image": newNotifObject.image,
+                    "time": newNotifObject.time,
+                    "urgency": newNotifObject.urgency,
+                    "actions": newNotifObject.actions
+                })
+            }
+
+            // Native history keeps only popups as objects
+            if (!root.nativeHistory || !root.popupInhibited) {
+                Qt.callLater(() => {
+                    root.list = [...root.list, newNotifObject]
+                    saveNotifications()
+                })
+            } else {
+                newNotifObject.destroy(1000)
+            }
 
             // Popup handling - show in bar if not inhibited
             if (!root.popupInhibited) {
@@ -353,6 +384,7 @@ Singleton {
     // ═══════════════════════════════════════════════════════════════
     
     function discardNotification(id) {
+        if (root.nativeHistory) root.nativeHistory.remove(id)
         const index = root.list.findIndex(notif => notif.id === id)
         const notifServerIndex = notifServer.trackedNotifications.values.findIndex(notif => notif.id + root.idOffset === id)
         if (index !== -1) {
@@ -371,6 +403,7 @@ Singleton {
 
         var idsMap = {}
         ids.forEach(id => { idsMap[id] = true })
+        if (root.nativeHistory) ids.forEach(id => root.nativeHistory.remove(id))
 
         const newList = root.list.filter(notif => !idsMap[notif.id])
         const removedCount = root.list.length - newList.length
@@ -391,6 +424,7 @@ Singleton {
     }
 
     function discardAllNotifications() {
+        if (root.nativeHistory) root.nativeHistory.clear()
         root.list = []
         triggerListChange()
         saveNotifications()
@@ -409,7 +443,7 @@ Singleton {
         onTriggered: {
             const index = root.list.findIndex(notif => notif.id === notificationId)
             if (index !== -1 && root.list[index] != null)
-                root.list[index].popup = false
+                root.releasePopup(root.list[index])
             root.timeout(notificationId)
         }
     }
@@ -425,7 +459,7 @@ Singleton {
             root.timeout(notif.id)
         })
         root.popupList.forEach(notif => {
-            notif.popup = false
+            root.releasePopup(notif)
         })
     }
 
@@ -479,15 +513,29 @@ Singleton {
 
     function hideAllPopups() {
         root.popupList.forEach(notif => {
-            notif.popup = false
             if (notif.timer) {
                 notif.timer.stop()
                 notif.timer.destroy()
                 notif.timer = null
             }
+            root.releasePopup(notif)
         })
     }
 
+    // Ends a popup; with native history the object is no longer needed once hidden
+    function releasePopup(notif) {
+        notif.popup = false
+        if (!root.nativeHistory) return
+
+        const index = root.list.indexOf(notif)
+        if (index !== -1) {
+            root.list.splice(index, 1)
+            triggerListChange()
+        }
+        // Late enough for the popup's exit animation to finish with it
+        notif.destroy(1000)
+    }
+
     function triggerListChange() {
         root.list = root.list.slice(0)
     }
@@ -577,7 +625,18 @@ Singleton {
     }
 
     Component.onCompleted: {
-        notifFileView.reload()
+        try {
+            nativeHistory = Qt.createQmlObject("import Molten.Native; NotificationHistory {}", root, "Notifications.nativeHistory")
+        } catch (e) {
+            console.log("Notifications: Molten.Native not installed, saving to notifications.json")
+        }
+        nativeChecked = true
+
+        if (nativeHistory) {
+            root.idOffset = nativeHistory.nextId
+        } else {
+            notifFileView.reload()
+        }
         root.initDone()
     }
 }